@@ -0,0 +1,67 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the non-template adaptive sampling functions
+
+double sample_funcs::cubic_segment(const std::vector<double> &x, const std::vector<double> &f, size_t j, double xval, int shift)
+{
+	// Lagrange form of the cubic through x[k..k+3], k = j - 1 + shift moved inwards at the ends, lower degree when there are fewer than 4 samples
+	// no checks are made on the inputs
+
+	int n = static_cast<int>(x.size()), m = std::min(n, 4);
+	int k = std::max(0, std::min(static_cast<int>(j) - 1 + shift, n - m));
+
+	double value = 0.0;
+
+	for (int a = k; a < k + m; a++) {
+		double w = f[a];
+		for (int b = k; b < k + m; b++) if (b != a) w *= (xval - x[b]) / (x[a] - x[b]);
+		value += w;
+	}
+
+	return value;
+}
+
+double sample_funcs::interpolate(const std::vector<double> &x, const std::vector<double> &f, double xval)
+{
+	// local cubic interpolation of the samples (x, f) at xval, x must be sorted in increasing order
+	// values outside [x[0], x[n-1]] are assigned the nearest end value
+
+	try {
+		if (!x.empty() && x.size() == f.size()) {
+			if (xval <= x.front()) return f.front();
+			if (xval >= x.back()) return f.back();
+
+			size_t j = std::upper_bound(x.begin(), x.end(), xval) - x.begin(); // x[j-1] <= xval < x[j]
+
+			return cubic_segment(x, f, j - 1, xval);
+		}
+		else {
+			std::string reason = "Error: double sample_funcs::interpolate(const std::vector<double> &x, const std::vector<double> &f, double xval)\n";
+			reason += "x and f are empty or of different sizes\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument &e) {
+		std::cerr << e.what();
+		return 0.0;
+	}
+}
+
+int sample_funcs::transmission_curve(const step_structure &structure, double E_lo, double E_hi, double tol, std::vector<double> &E, std::vector<double> &T, int n_start)
+{
+	// adaptively sampled transmission probability for the potential step on [E_lo, E_hi]
+	// the curve has a square root cusp at E = V, which is where most of the points end up
+	// returns the number of evaluations of T
+
+	return adaptive_sample([&structure](double energy) { double t, r; structure.probabilities(energy, t, r); return t; }, E_lo, E_hi, tol, E, T, n_start);
+}
+
+int sample_funcs::transmission_curve(const barr_structure &structure, double E_lo, double E_hi, double tol, std::vector<double> &E, std::vector<double> &T, int n_start)
+{
+	// adaptively sampled transmission probability for the potential barrier on [E_lo, E_hi], with E_hi < V
+	// returns the number of evaluations of T
+
+	return adaptive_sample([&structure](double energy) { double t, r; structure.probabilities(energy, t, r); return t; }, E_lo, E_hi, tol, E, T, n_start);
+}
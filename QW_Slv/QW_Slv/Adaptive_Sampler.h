@@ -0,0 +1,120 @@
+#ifndef ADAPTIVE_SAMPLER_H
+#define ADAPTIVE_SAMPLER_H
+
+// Adaptive sampling of a function of one variable, e.g. T(E) curves
+// The samples are joined by local cubics, each through the two samples either side of an interval, see cubic_segment
+// Intervals are bisected until the interpolant of the samples is within tol of the function at the midpoint of every interval
+// Points are concentrated where the curve bends, e.g. at the cusp E = V for the step, and few points are spent where it is flat
+
+namespace sample_funcs{
+
+	// value at xval of the cubic through the samples x[j-1], x[j], x[j+1], x[j+2] of the sorted samples (x, f), for xval in [x[j], x[j+1]]
+	// the four samples are moved inwards at the ends of the range and fewer are used when x has fewer than four, x.size() > j + 1
+	// the error on a smooth stretch falls as h^{4} and is largest near the middle of the interval, which is where adaptive_sample tests it
+	// shift = -1 or +1 takes the cubic through x[j-2..j+1] or x[j..j+3] instead, which adaptive_sample uses to look for kinks
+	double cubic_segment(const std::vector<double> &x, const std::vector<double> &f, size_t j, double xval, int shift = 0);
+
+	template <class Func> int adaptive_sample(Func func, double x_lo, double x_hi, double tol, std::vector<double> &x, std::vector<double> &f, int n_start = 16, double dx_min = 0.0, int max_evals = 1000000)
+	{
+		// sample func on [x_lo, x_hi], the sorted sample positions are returned in x and the values func(x) in f
+		// the samples start as a uniform grid of n_start intervals, n_start should be large enough that no feature is narrower than (x_hi - x_lo) / n_start
+		// func is evaluated once at the midpoint of every interval and each pass compares it with cubic_segment of the current samples there,
+		// an interval whose midpoint misses by more than tol is bisected and its midpoint becomes a sample, the other midpoints are held back
+		// and tested again in the next pass, since bisecting an interval changes the cubics of its neighbours
+		// the cubics from the stencils shifted one sample left and right must also pass, a kink in the half of the interval away from the
+		// midpoint bends them apart even when the central cubic happens to go through the midpoint value, and on a smooth stretch they only
+		// add about 14 % more samples, the error of a shifted cubic being about 1.7 times that of the central one
+		// on return the interpolant of the returned samples is within tol of func at the midpoint of every interval, which is where the
+		// error of a cubic on a smooth stretch peaks, the error elsewhere is measured by testing::adaptive_sampling but is not guaranteed
+		// intervals narrower than dx_min are not tested or bisected, dx_min <= 0 means use 1e-9 (x_hi - x_lo)
+		// no pass is started that would take the number of calls to func above max_evals
+		// the return value is the number of calls made to func, the returned samples plus the midpoints held back
+
+		try {
+			bool c1 = x_hi > x_lo ? true : false;
+			bool c2 = tol > 0.0 ? true : false;
+			bool c3 = n_start > 1 ? true : false;
+
+			if (c1 && c2 && c3) {
+				if (dx_min <= 0.0) dx_min = 1.0e-9 * (x_hi - x_lo);
+
+				std::vector<double> x_new, f_new, f_mid(n_start), f_mid_new;
+				std::vector<char> has_mid(n_start, 0), has_mid_new, split;
+
+				x.resize(n_start + 1); f.resize(n_start + 1);
+				for (int i = 0; i <= n_start; i++) {
+					x[i] = (i < n_start ? x_lo + ( (x_hi - x_lo) * i ) / n_start : x_hi);
+					f[i] = func(x[i]);
+				}
+
+				int n_evals = n_start + 1;
+
+				while (true) {
+					int n_int = static_cast<int>(x.size()) - 1, n_new = 0, n_split = 0;
+
+					for (int i = 0; i < n_int; i++) if (!has_mid[i] && x[i + 1] - x[i] > dx_min) n_new++;
+
+					if (n_evals + n_new > max_evals) break;
+
+					for (int i = 0; i < n_int; i++) {
+						if (!has_mid[i] && x[i + 1] - x[i] > dx_min) {
+							f_mid[i] = func(0.5 * (x[i] + x[i + 1]));
+							has_mid[i] = 1;
+						}
+					}
+					n_evals += n_new;
+
+					// every midpoint is tested against the cubics of the samples as they stand at the start of the pass
+					split.assign(n_int, 0);
+					for (int i = 0; i < n_int; i++) {
+						if (!has_mid[i]) continue;
+						double xm = 0.5 * (x[i] + x[i + 1]), err = 0.0;
+						for (int shift = -1; shift <= 1; shift++) err = std::max(err, fabs(f_mid[i] - cubic_segment(x, f, i, xm, shift)));
+						if (err > tol) { split[i] = 1; n_split++; }
+					}
+
+					if (n_split == 0) break;
+
+					x_new.clear(); f_new.clear(); f_mid_new.clear(); has_mid_new.clear();
+					for (int i = 0; i < n_int; i++) {
+						x_new.push_back(x[i]); f_new.push_back(f[i]);
+						if (split[i]) {
+							x_new.push_back(0.5 * (x[i] + x[i + 1])); f_new.push_back(f_mid[i]);
+							f_mid_new.push_back(0.0); has_mid_new.push_back(0);
+							f_mid_new.push_back(0.0); has_mid_new.push_back(0);
+						}
+						else {
+							f_mid_new.push_back(f_mid[i]); has_mid_new.push_back(has_mid[i]);
+						}
+					}
+					x_new.push_back(x[n_int]); f_new.push_back(f[n_int]);
+
+					x.swap(x_new); f.swap(f_new); f_mid.swap(f_mid_new); has_mid.swap(has_mid_new);
+				}
+
+				return n_evals;
+			}
+			else {
+				std::string reason = "Error: int sample_funcs::adaptive_sample(Func func, double x_lo, double x_hi, double tol, std::vector<double> &x, std::vector<double> &f, int n_start, double dx_min, int max_evals)\n";
+				if (!c1) reason += "x_hi is not greater than x_lo\n";
+				if (!c2) reason += "tol is not positive\n";
+				if (!c3) reason += "n_start must be at least 2\n";
+				throw std::invalid_argument(reason);
+			}
+		}
+		catch (std::invalid_argument &e) {
+			useful_funcs::exit_failure_output(e.what());
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// value of the sampled curve at xval from cubic_segment, values outside [x[0], x[n-1]] are assigned the nearest end value
+	double interpolate(const std::vector<double> &x, const std::vector<double> &f, double xval);
+
+	// T(E) curves for a fixed structure, energies in units of eV
+	int transmission_curve(const step_structure &structure, double E_lo, double E_hi, double tol, std::vector<double> &E, std::vector<double> &T, int n_start = 16);
+
+	int transmission_curve(const barr_structure &structure, double E_lo, double E_hi, double tol, std::vector<double> &E, std::vector<double> &T, int n_start = 16);
+}
+
+#endif
@@ -16,6 +16,14 @@
 #include <cmath>
 #include <complex> 
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <functional>
+#include <array>
 
 // Constants
 static const double EPS=(1.0e-16);
@@ -46,14 +54,35 @@ static const std::complex<double> one(1.0, 0.0);
 
 #include "Templates.h"
 #include "Useful.h"
+#include "Simd_Math.h"
+#include "Wave_Kernels.h"
+#include "Parallel.h"
+#include "Root_Finder.h"
+#include "Sine_Transform.h"
+#include "Chebyshev_Approximation.h"
+#include "Special_Functions.h"
+#include "Tridiagonal.h"
+#include "Dense_Eigen.h"
 
 #include "Potential_Step.h"
 #include "Potential_Barrier.h"
+#include "Multi_Layer.h"
+#include "Biased_Barrier.h"
+#include "Adaptive_Sampler.h"
+#include "Density_Map.h"
+#include "Problem_Batch.h"
 #include "Infinite_Well.h"
+#include "Harmonic_Well.h"
 #include "Finite_Well.h"
+#include "Well_Evolution.h"
+#include "Separable_Box.h"
+#include "Cylindrical_Wire.h"
+#include "Spherical_Dot.h"
+#include "Finite_Difference_Well.h"
+#include "Numerov_Shooting.h"
+#include "Chebyshev_Well.h"
+#include "Triangular_Well.h"
 
 #include "Test_Routines.h"
-//#include "Chebyshev_Approximation.h"
-//#include "Special_Functions.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the biased barrier class
+
+biased_barr::biased_barr()
+{
+	// Default constructor
+	params_defined = false;
+	m_L = m_b = m_R = V_b = W = 0.0;
+	k_scale_L = k_scale_b = k_scale_R = x0_scale = 0.0;
+}
+
+biased_barr::biased_barr(double mass_left, double mass_barrier, double mass_right, double barr_height, double barr_width)
+{
+	// Constructor
+
+	set_params(mass_left, mass_barrier, mass_right, barr_height, barr_width);
+}
+
+void biased_barr::set_params(double mass_left, double mass_barrier, double mass_right, double barr_height, double barr_width)
+{
+	// assign the structure, everything that does not depend on the energy or the field is computed here
+
+	try {
+		bool c1 = mass_left > 0.0 && mass_barrier > 0.0 && mass_right > 0.0 ? true : false;
+		bool c2 = barr_width > 0.0 ? true : false;
+
+		if (c1 && c2) {
+			m_L = mass_left;
+			m_b = mass_barrier;
+			m_R = mass_right;
+			V_b = barr_height;
+			W = barr_width;
+
+			k_scale_L = ( sqrt(2.0 * m_L * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J;
+			k_scale_b = ( sqrt(2.0 * m_b * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J;
+			k_scale_R = ( sqrt(2.0 * m_R * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J;
+
+			// (hbar^{2} / 2 m_b F)^{1/3} with F = 1 eV / nm converted to J / m, then to nm
+			x0_scale = 1.0e9 * cbrt(H_BAR_J * H_BAR_J / (2.0 * m_b * template_funcs::convert_ev_J(1.0) * 1.0e9));
+
+			params_defined = true;
+		}
+		else {
+			std::string reason = "Error: void biased_barr::set_params(double mass_left, double mass_barrier, double mass_right, double barr_height, double barr_width)\n";
+			if (!c1) reason += "mass is not positive\n";
+			if (!c2) reason += "barrier width is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void biased_barr::check_inputs(double particle_energy, double field, std::string caller) const
+{
+	// the particle must propagate in the left lead, it then propagates in the right lead as well since -F W < 0 < E
+
+	try {
+		if (!params_defined || !(particle_energy > 0.0) || !(field >= 0.0)) {
+			std::string reason = "Error: " + caller + "\n";
+			if (!params_defined) reason += "No parameters defined for biased_barr class\n";
+			if (!(particle_energy > 0.0)) reason += "particle energy must be positive\n";
+			if (!(field >= 0.0)) reason += "field must not be negative\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void biased_barr::transfer(double particle_energy, double field, std::complex<double> P[4], double &delta) const
+{
+	// With Phi(x) = [[Ai(z), Bi(z)], [-Ai'(z) / x_0, -Bi'(z) / x_0]] the transfer matrix is Phi(W) Phi(0)^{-1}, using W[Ai, Bi] = 1 / pi,
+	// P_11 = pi (Ai_W Bi'_0 - Bi_W Ai'_0), P_12 = pi x_0 (Ai_W Bi_0 - Bi_W Ai_0),
+	// P_21 = -(pi / x_0) (Ai'_W Bi'_0 - Bi'_W Ai'_0), P_22 = -pi (Ai'_W Bi_0 - Bi'_W Ai_0)
+	// with scaled functions the first product of each pair carries exp(delta), delta = zeta(z_0) - zeta(z_W), and the second exp(-delta),
+	// so P exp(-delta) has the first products as they are and the second multiplied by exp(-2 delta) <= 1
+	// F = 0: P = [[cosh(q W), sinh(q W) / q], [q sinh(q W), cosh(q W)]], scaled by exp(-Re(q) W) in the same way
+
+	if (field > 0.0) {
+		double x0 = x0_scale / cbrt(field), E0 = field * x0;
+		double z0 = (V_b - particle_energy) / E0, zW = z0 - W / x0;
+
+		if (zW > 0.0) {
+			// zeta(z_0) - zeta(z_W) without the cancellation of two large values
+			double r0 = sqrt(z0), rW = sqrt(zW);
+			delta = (2.0 / 3.0) * (W / x0) * (z0 * z0 + z0 * zW + zW * zW) / (z0 * r0 + zW * rW);
+		}
+		else {
+			delta = ( z0 > 0.0 ? (2.0 / 3.0) * z0 * sqrt(z0) : 0.0 );
+		}
+
+		double ai0, bi0, aip0, bip0, aiW, biW, aipW, bipW;
+
+		special::airy_scaled(z0, &ai0, &bi0, &aip0, &bip0);
+		special::airy_scaled(zW, &aiW, &biW, &aipW, &bipW);
+
+		double e2 = exp(-2.0 * delta);
+
+		P[0] = PI * (aiW * bip0 - e2 * biW * aip0);
+		P[1] = PI * x0 * (aiW * bi0 - e2 * biW * ai0);
+		P[2] = -(PI / x0) * (aipW * bip0 - e2 * bipW * aip0);
+		P[3] = -PI * (aipW * bi0 - e2 * bipW * ai0);
+	}
+	else {
+		std::complex<double> q = k_scale_b * sqrt(std::complex<double>(V_b - particle_energy, 0.0)), qW = q * W;
+
+		delta = qW.real();
+
+		// exp(i Im(q) W) is the part of exp(q W) not taken out with exp(delta)
+		std::complex<double> phase = exp(std::complex<double>(0.0, qW.imag())), e2 = exp(-2.0 * qW);
+
+		P[0] = P[3] = 0.5 * phase * (1.0 + e2);
+		P[1] = ( std::abs(qW) > 1.0e-8 ? 0.5 * phase * (1.0 - e2) / q : std::complex<double>(W, 0.0) );
+		P[2] = 0.5 * phase * q * (1.0 - e2);
+	}
+}
+
+void biased_barr::amplitudes(double particle_energy, double field, std::complex<double> &r, std::complex<double> &t) const
+{
+	// psi = exp(i k_L x) + r exp(-i k_L x) for x < 0 and t exp(i k_R (x - W)) for x > W, with a = i k_L m_b / m_L, b = i k_R m_b / m_R
+	// (t, b t) = P (1 + r, a (1 - r)) gives, with X = b P_11 - P_21, Y = a (b P_12 - P_22) and det P = 1,
+	// r = -(X + Y) / (X - Y), t = 2 a / (X - Y), and t = 2 a exp(-delta) / (X - Y) when X and Y are formed from P exp(-delta)
+
+	check_inputs(particle_energy, field, "void biased_barr::amplitudes(double particle_energy, double field, std::complex<double> &r, std::complex<double> &t) const");
+
+	std::complex<double> P[4];
+	double delta;
+
+	transfer(particle_energy, field, P, delta);
+
+	std::complex<double> a(0.0, k_scale_L * sqrt(particle_energy) * m_b / m_L);
+	std::complex<double> b(0.0, k_scale_R * sqrt(particle_energy + field * W) * m_b / m_R);
+
+	std::complex<double> X = b * P[0] - P[2], Y = a * (b * P[1] - P[3]);
+
+	r = -(X + Y) / (X - Y);
+	t = 2.0 * a * exp(-delta) / (X - Y);
+}
+
+void biased_barr::probabilities(double particle_energy, double field, double &T, double &R) const
+{
+	// T is the ratio of the transmitted to the incident probability current, (k_R / m_R) |t|^{2} / (k_L / m_L)
+
+	std::complex<double> r, t;
+
+	amplitudes(particle_energy, field, r, t);
+
+	double flux = ( sqrt((particle_energy + field * W) / particle_energy) * (k_scale_R / k_scale_L) ) * (m_L / m_R);
+
+	T = flux * std::norm(t);
+	R = std::norm(r);
+}
+
+double biased_barr::transmission(double particle_energy, double field) const
+{
+	// transmission probability only
+
+	double T, R;
+
+	probabilities(particle_energy, field, T, R);
+
+	return T;
+}
+
+void biased_barr::transmission_map(const double *particle_energy, int n_energies, const double *field, int n_fields, double *T, int n_threads) const
+{
+	// each thread takes whole rows of fixed field, the inputs are checked once before the threads start
+
+	try {
+		if (particle_energy != nullptr && field != nullptr && T != nullptr && n_energies > 0 && n_fields > 0) {
+			for (int e = 0; e < n_energies; e++) check_inputs(particle_energy[e], 0.0, "void biased_barr::transmission_map(const double *particle_energy, int n_energies, const double *field, int n_fields, double *T, int n_threads) const");
+			for (int f = 0; f < n_fields; f++) check_inputs(1.0, field[f], "void biased_barr::transmission_map(const double *particle_energy, int n_energies, const double *field, int n_fields, double *T, int n_threads) const");
+
+			parallel_funcs::parallel_for(n_fields, [&](int f) {
+				for (int e = 0; e < n_energies; e++) T[static_cast<size_t>(f) * n_energies + e] = transmission(particle_energy[e], field[f]);
+			}, n_threads);
+		}
+		else {
+			std::string reason = "Error: void biased_barr::transmission_map(const double *particle_energy, int n_energies, const double *field, int n_fields, double *T, int n_threads) const\n";
+			reason += "No particle energies or fields supplied\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+std::vector<layer> biased_barr::staircase(double field, int n_slices) const
+{
+	// mid point heights give an error O(1 / n_slices^{2}) in T
+
+	std::vector<layer> layers(n_slices > 0 ? n_slices : 0);
+
+	double dx = n_slices > 0 ? W / n_slices : 0.0;
+
+	for (int j = 0; j < n_slices; j++) {
+		layers[j].width = dx;
+		layers[j].height = V_b - field * (j + 0.5) * dx;
+		layers[j].mass = m_b;
+	}
+
+	return layers;
+}
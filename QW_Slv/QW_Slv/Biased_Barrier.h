@@ -0,0 +1,59 @@
+#ifndef BIASED_BARRIER_H
+#define BIASED_BARRIER_H
+
+// Transmission through a rectangular barrier tilted by an applied field, the trapezoidal and, once E > V_b - F W, triangular
+// barrier of Fowler-Nordheim tunnelling through an oxide
+// V = 0 in the left lead x < 0, V = V_b - F x in the barrier 0 < x < W and V = -F W in the right lead x > W,
+// each region has its own effective mass and psi and (1/m) dpsi/dx are continuous at x = 0 and x = W
+// In the barrier psi is exactly alpha Ai(z) + beta Bi(z), z = (V_b - E - F x) / E_0, x_0 = (hbar^{2} / 2 m_b F)^{1/3}, E_0 = F x_0,
+// so one energy costs four Airy function evaluations where the staircase of multi_layer needs many thin layers to converge
+// The Airy functions are taken exponentially scaled from special::airy_scaled and the growth exp(zeta(z_0) - zeta(z_W)) across the barrier
+// is carried as a separate factor, so T is found without overflow however thick or high the barrier and T below 1e-308 underflows to zero
+// F = 0 is the flat barrier, solved with exp(+/- q x), q = sqrt(2 m_b (V_b - E)) / hbar
+// Energies in units of eV measured from the left lead, lengths in units of nm, masses in units of kg,
+// field is the slope of the potential energy in eV / nm, 1 eV / nm is a field of 10 MV / cm acting on an electron
+
+class biased_barr {
+public:
+	biased_barr();
+	biased_barr(double mass_left, double mass_barrier, double mass_right, double barr_height, double barr_width);
+
+	void set_params(double mass_left, double mass_barrier, double mass_right, double barr_height, double barr_width);
+
+	// reflected and transmitted amplitudes for unit incident amplitude, t is that of exp(i k_R (x - W))
+	void amplitudes(double particle_energy, double field, std::complex<double> &r, std::complex<double> &t) const;
+
+	void probabilities(double particle_energy, double field, double &T, double &R) const;
+
+	double transmission(double particle_energy, double field) const;
+
+	// T[f * n_energies + e] = T(particle_energy[e], field[f]), fields are shared out over n_threads threads, n_threads < 1 uses every core
+	void transmission_map(const double *particle_energy, int n_energies, const double *field, int n_fields, double *T, int n_threads = 0) const;
+
+	// the barrier at the given field as n_slices layers of constant height V_b - F x_j, x_j the slice mid points, for multi_layer
+	// together with leads (mass_left, 0) and (mass_right, -F W)
+	std::vector<layer> staircase(double field, int n_slices) const;
+
+	// getters
+	inline bool defined() const { return params_defined; }
+	inline double get_V() const { return V_b; }
+	inline double get_W() const { return W; }
+	inline double get_mass_left() const { return m_L; }
+	inline double get_mass_right() const { return m_R; }
+
+private:
+	void check_inputs(double particle_energy, double field, std::string caller) const;
+
+	// the barrier transfer matrix for (psi, psi') from x = 0 to x = W divided by exp(delta), delta >= 0 its growth
+	void transfer(double particle_energy, double field, std::complex<double> P[4], double &delta) const;
+
+private:
+	bool params_defined; // boolean to decide if parameters have been assigned to the class
+	double m_L, m_b, m_R; // effective masses in the left lead, barrier and right lead in units of kg
+	double V_b; // barrier height at x = 0 in units of eV
+	double W; // barrier width in units of nm
+	double k_scale_L, k_scale_b, k_scale_R; // wavenumber in units of nm^{-1} is k_scale sqrt(E - V) with E, V in eV
+	double x0_scale; // x_0 = x0_scale / F^{1/3} in units of nm for F in eV / nm
+};
+
+#endif
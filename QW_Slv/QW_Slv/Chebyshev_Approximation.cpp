@@ -19,8 +19,8 @@ void cheb_appr::chebft(double a, double b, double c[], int n, double (*func)(dou
 
 		if(c1 && c2 && c3){
 
-			int k,j;
-			double fac,bpa,bma,*f;
+			int k;
+			double bpa,bma,*f;
 
 			//f=vector(0,n-1);
 			f = new (double [n]); 
@@ -30,13 +30,7 @@ void cheb_appr::chebft(double a, double b, double c[], int n, double (*func)(dou
 				double y=cos(PI*(k+0.5)/n);
 				f[k]=(*func)(y*bma+bpa);
 			}
-			fac=2.0/n;
-			for (j=0;j<n;j++) {
-				double sum=0.0;
-				for (k=0;k<n;k++)
-					sum += f[k]*cos(PI*j*(k+0.5)/n);
-				c[j]=fac*sum;
-			}
+			chebft(a, b, c, n, f); 
 			//free_vector(f,0,n-1);
 			delete[] f; 
 		}
@@ -59,6 +53,43 @@ void cheb_appr::chebft(double a, double b, double c[], int n, double (*func)(dou
 	}
 }
 
+void cheb_appr::chebft(double a, double b, double c[], int n, const double f[])
+{
+	// Chebyshev fit from function values f[0..n-1] at the nodes x_k = 0.5*(b+a) + 0.5*(b-a)*cos(PI*(k+0.5)/n)
+	// Used when the function is not a free function, for example samples of a wavefunction or of a potential held by a class
+
+	try{
+
+		bool c1 = ( a < b ? true : false); 
+		bool c2 = ( fabs(b - a) > EPS ? true : false);
+		bool c3 = ( n > 29 ? true : false);
+
+		if(c1 && c2 && c3){
+
+			int k,j;
+			double fac;
+
+			fac=2.0/n;
+			for (j=0;j<n;j++) {
+				double sum=0.0;
+				for (k=0;k<n;k++)
+					sum += f[k]*cos(PI*j*(k+0.5)/n);
+				c[j]=fac*sum;
+			}
+		}
+		else{
+			std::string reason = "Error: void cheb_appr::chebft(double a, double b, double c[], int n, const double f[])\n"; 
+			if(!c1 || !c2) reason += "Domain endpoints are not correctly defined\na = " + template_funcs::toString(a, 3) + ", b = "+ template_funcs::toString(b, 3) + "\n"; 
+			if(!c3) reason += "Number of expansion coefficients n = " + template_funcs::toString(n) + " is not sufficient\n"; 
+			throw std::invalid_argument(reason); 
+		}	
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
 double cheb_appr::chebev(double a, double b, double c[], int m, double x)
 {
 	// Evaluation of Chebyshev approximation to func(x) on [a, b]
@@ -71,7 +102,7 @@ double cheb_appr::chebev(double a, double b, double c[], int m, double x)
 		bool c1 = ( a < b ? true : false); 
 		bool c2 = ( fabs(b - a) > EPS ? true : false);
 		bool c3 = ( m > 1 ? true : false);
-		bool c4 = ((x-a)*(x-b) < 0.0 ? true : false); 
+		bool c4 = ((x-a)*(x-b) <= 0.0 ? true : false); // the end points are in range, beschb evaluates at x = -1 for integer orders
 
 		if(c1 && c2 && c3 & c4){
 
@@ -104,6 +135,42 @@ double cheb_appr::chebev(double a, double b, double c[], int m, double x)
 	}
 }
 
+int cheb_appr::chebev(double a, double b, const double c[], int m, const double *x, int n_x, double *f, int *status) noexcept
+{
+	// Evaluation of the Chebyshev approximation at each of the points x[0..n_x-1], results are written to f[0..n_x-1]
+	// Unlike the scalar version nothing is thrown, status[i] receives the eval_status flags for x[i] and f[i] is set to NaN when x[i] is flagged
+	// The interval and the coefficients are checked once, x[i] may lie anywhere in the closed interval [a, b]
+	// returns the number of flagged points, or -1 if the arrays are missing
+
+	if (c == nullptr || x == nullptr || f == nullptr || status == nullptr || n_x < 0) return -1; 
+
+	int fixed = ( (a < b && fabs(b - a) > EPS && m > 1) ? EVAL_OK : EVAL_NO_PARAMS ); 
+	int n_bad = 0; 
+	double nan = std::numeric_limits<double>::quiet_NaN(); 
+	double scale = 2.0 / (b - a), shift = a + b; 
+
+	for (int i = 0; i < n_x; i++) {
+		status[i] = fixed | ( (x[i] >= a && x[i] <= b) ? EVAL_OK : EVAL_OUT_OF_RANGE ); 
+
+		if (status[i] == EVAL_OK) {
+			double d = 0.0, dd = 0.0, sv; 
+			double y = scale * (x[i] - 0.5 * shift), y2 = 2.0 * y; 
+			for (int j = m - 1; j >= 1; j--) {
+				sv = d; 
+				d = y2 * d - dd + c[j]; 
+				dd = sv; 
+			}
+			f[i] = y * d - dd + 0.5 * c[0]; 
+		}
+		else {
+			f[i] = nan; 
+			n_bad++; 
+		}
+	}
+
+	return n_bad; 
+}
+
 void cheb_appr::chder(double a, double b, double c[], double cder[], int n)
 {
 	// Chebyshev polynomial approximation to the derivative of a function func(x) on [a, b]
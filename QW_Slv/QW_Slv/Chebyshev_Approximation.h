@@ -9,8 +9,14 @@ namespace cheb_appr{
 	
 	void chebft(double a, double b, double c[], int n, double (*func)(double)); 
 
+	// the same fit from samples f[k] = func(x_k) already taken at the nodes x_k = 0.5 (b + a) + 0.5 (b - a) cos(pi (k + 1/2) / n)
+	void chebft(double a, double b, double c[], int n, const double f[]); 
+
 	double chebev(double a, double b, double c[], int m, double x); 
 
+	// non-throwing evaluation at n_x points, out of range points are flagged in status rather than ending the program
+	int chebev(double a, double b, const double c[], int m, const double *x, int n_x, double *f, int *status) noexcept; 
+
 	void chder(double a, double b, double c[], double cder[], int n); 
 
 	void chint(double a, double b, double c[], double cint[], int n); 
@@ -0,0 +1,409 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the Chebyshev collocation well class
+
+cheb_well::cheb_well()
+{
+	// Default constructor
+}
+
+void cheb_well::set_domains(const std::vector<double> &bounds, const std::vector<int> &n_coeffs, const std::vector<double> &masses)
+{
+	// the collocation points of domain d are the zeros of T_{n_d-2}, the Gauss nodes those of T_{n_d}, both exclude the domain ends
+
+	try{
+
+		int D = static_cast<int>(bounds.size()) - 1;
+
+		bool c1 = D > 0 && static_cast<int>(n_coeffs.size()) == D && static_cast<int>(masses.size()) == D ? true : false;
+		bool c2 = c1, c3 = c1, c4 = c1;
+
+		for (int d = 0; d < D && c1; d++) {
+			if (!(bounds[d + 1] > bounds[d])) c2 = false;
+			if (n_coeffs[d] < 30) c3 = false;
+			if (!(masses[d] > 0.0)) c4 = false;
+		}
+
+		if(c1 && c2 && c3 && c4){
+			x_bound = bounds;
+			n_coeff = n_coeffs;
+			mass = masses;
+
+			offset.resize(D + 1);
+			offset[0] = 0;
+			for (int d = 0; d < D; d++) offset[d + 1] = offset[d] + n_coeff[d];
+
+			x_colloc.clear();
+			x_nodes.clear();
+
+			for (int d = 0; d < D; d++) {
+				double bma = 0.5 * (x_bound[d + 1] - x_bound[d]), bpa = 0.5 * (x_bound[d + 1] + x_bound[d]);
+				int n = n_coeff[d];
+
+				for (int k = 0; k < n - 2; k++) x_colloc.push_back(bpa + bma * cos(PI * (k + 0.5) / (n - 2)));
+				for (int k = 0; k < n; k++) x_nodes.push_back(bpa + bma * cos(PI * (k + 0.5) / n));
+			}
+
+			V_colloc.assign(x_colloc.size(), 0.0);
+			V_nodes.assign(x_nodes.size(), 0.0);
+			V_tail.assign(D, 0.0);
+
+			energies.clear();
+			coeffs.clear();
+		}
+		else{
+			std::string reason = "Error: void cheb_well::set_domains(const std::vector<double> &bounds, const std::vector<int> &n_coeffs, const std::vector<double> &masses)\n";
+			if(!c1) reason += "There must be one more bound than there are domains, and one value of n_coeffs and masses per domain\n";
+			if(c1 && !c2) reason += "bounds must be strictly increasing\n";
+			if(c1 && !c3) reason += "Each domain needs 30 or more Chebyshev coefficients\n";
+			if(c1 && !c4) reason += "masses are not positive everywhere\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void cheb_well::set_potential_tails()
+{
+	// fit V on each domain with chebft and compare the last two coefficients with the largest one
+
+	for (int d = 0; d < get_n_domains(); d++) {
+		int n = n_coeff[d];
+		std::vector<double> c(n);
+
+		cheb_appr::chebft(x_bound[d], x_bound[d + 1], c.data(), n, V_nodes.data() + offset[d]);
+
+		double c_max = 0.0;
+		for (int j = 0; j < n; j++) c_max = std::max(c_max, fabs(c[j]));
+
+		V_tail[d] = c_max > 0.0 ? (fabs(c[n - 2]) + fabs(c[n - 1])) / c_max : 0.0;
+	}
+}
+
+void cheb_well::build_hamiltonian(std::vector<double> &dependent, std::vector<double> &h) const
+{
+	// Column j of each operator is found by applying it to the unit coefficient vector e_j:
+	// chebev of e_j gives T_j at the collocation points and at the domain ends, chebev of chder(e_j) and chder(chder(e_j)) give T_j' and T_j''
+	// The 2 D conditions K c = 0 are solved for the dependent coefficients, c_dep = -K_dep^{-1} K_free z, and the collocation rows
+	// A c = E B c, A = -(hbar^{2} / 2 m_d) T'' + V T and B = T at the collocation points, become (A N) z = E (B N) z with c = N z,
+	// B N is square and well conditioned, so h = (B N)^{-1} (A N)
+
+	int D = get_n_domains(), P = get_n_unknowns(), n_total = offset[D];
+
+	std::vector<double> K(static_cast<size_t>(2 * D) * n_total, 0.0); // K[r * n_total + offset[d] + j]
+	std::vector<double> A(static_cast<size_t>(P) * n_total, 0.0), B(static_cast<size_t>(P) * n_total, 0.0); // collocation rows
+
+	for (int d = 0; d < D; d++) {
+		int n = n_coeff[d], row0 = offset[d] - 2 * d;
+		double a = x_bound[d], b = x_bound[d + 1];
+		double t_d = H_BAR_J * H_BAR_J / (2.0 * mass[d] * 1.0e-18 * template_funcs::convert_ev_J(1.0)); // hbar^{2} / 2 m in eV nm^{2}
+		// psi' / m at interface i is scaled by m_i (x_{i+1} - x_i) / 2, which makes it comparable to psi on domain i, for both sides
+		double scale_left = d > 0 ? 0.5 * (x_bound[d] - x_bound[d - 1]) * mass[d - 1] : 0.0, scale_right = 0.5 * (b - a) * mass[d];
+		double ends[2] = { a, b }, f_ends[2];
+		int status[2];
+
+		std::vector<double> e(n, 0.0), d1(n), d2(n), f(n - 2);
+		std::vector<int> st(n - 2);
+
+		for (int j = 0; j < n; j++) {
+			e[j] = 1.0;
+
+			cheb_appr::chder(a, b, e.data(), d1.data(), n);
+			cheb_appr::chder(a, b, d1.data(), d2.data(), n);
+
+			// T_j and T_j'' at the collocation points
+			cheb_appr::chebev(a, b, e.data(), n, x_colloc.data() + row0, n - 2, f.data(), st.data());
+			for (int k = 0; k < n - 2; k++) {
+				A[static_cast<size_t>(row0 + k) * n_total + offset[d] + j] = V_colloc[row0 + k] * f[k];
+				B[static_cast<size_t>(row0 + k) * n_total + offset[d] + j] = f[k];
+			}
+
+			cheb_appr::chebev(a, b, d2.data(), n, x_colloc.data() + row0, n - 2, f.data(), st.data());
+			for (int k = 0; k < n - 2; k++) A[static_cast<size_t>(row0 + k) * n_total + offset[d] + j] -= t_d * f[k];
+
+			// psi at the ends, row 2 d + 1 is continuity at the right end of domain d, or psi = 0 at x_D for the last domain, row 0 is psi = 0 at x_0
+			cheb_appr::chebev(a, b, e.data(), n, ends, 2, f_ends, status);
+			if (d == 0) K[j] = f_ends[0];
+			else K[static_cast<size_t>(2 * d - 1) * n_total + offset[d] + j] = -f_ends[0];
+			K[static_cast<size_t>(2 * d + 1) * n_total + offset[d] + j] = f_ends[1];
+
+			// psi' / m continuous at the interfaces, row 2 d + 2 at the right end of domain d
+			cheb_appr::chebev(a, b, d1.data(), n, ends, 2, f_ends, status);
+			if (d > 0) K[static_cast<size_t>(2 * d) * n_total + offset[d] + j] = -scale_left * f_ends[0] / mass[d];
+			if (d < D - 1) K[static_cast<size_t>(2 * d + 2) * n_total + offset[d] + j] = scale_right * f_ends[1] / mass[d];
+
+			e[j] = 0.0;
+		}
+	}
+
+	// dependent coefficients, column 2 d + s of K_dep is coefficient n_d - 2 + s of domain d
+	std::vector<double> K_dep(static_cast<size_t>(4 * D) * D);
+	std::vector<int> perm(2 * D);
+
+	for (int r = 0; r < 2 * D; r++) {
+		for (int d = 0; d < D; d++) {
+			for (int s = 0; s < 2; s++) {
+				K_dep[static_cast<size_t>(r) * 2 * D + 2 * d + s] = K[static_cast<size_t>(r) * n_total + offset[d] + n_coeff[d] - 2 + s];
+			}
+		}
+	}
+
+	if (!dense_eigen::lu_decompose(K_dep.data(), 2 * D, perm.data())) {
+		std::string reason = "Error: void cheb_well::build_hamiltonian(std::vector<double> &dependent, std::vector<double> &h) const\n";
+		reason += "The boundary and interface conditions do not fix the highest coefficients of each domain\n";
+		throw std::invalid_argument(reason);
+	}
+
+	dependent.assign(static_cast<size_t>(2 * D) * P, 0.0);
+
+	std::vector<double> col(2 * D);
+
+	for (int d = 0; d < D; d++) {
+		for (int j = 0; j < n_coeff[d] - 2; j++) {
+			int f = offset[d] - 2 * d + j;
+
+			for (int r = 0; r < 2 * D; r++) col[r] = -K[static_cast<size_t>(r) * n_total + offset[d] + j];
+
+			dense_eigen::lu_solve(K_dep.data(), 2 * D, perm.data(), col.data());
+
+			for (int r = 0; r < 2 * D; r++) dependent[static_cast<size_t>(r) * P + f] = col[r];
+		}
+	}
+
+	// A N and B N, the collocation rows of domain d only involve the coefficients of domain d
+	std::vector<double> AN(static_cast<size_t>(P) * P, 0.0), BN(static_cast<size_t>(P) * P, 0.0);
+
+	for (int d = 0; d < D; d++) {
+		int n = n_coeff[d], row0 = offset[d] - 2 * d;
+
+		for (int k = 0; k < n - 2; k++) {
+			size_t row = static_cast<size_t>(row0 + k);
+			const double *a_row = A.data() + row * n_total + offset[d], *b_row = B.data() + row * n_total + offset[d];
+
+			for (int j = 0; j < n - 2; j++) {
+				AN[row * P + row0 + j] += a_row[j];
+				BN[row * P + row0 + j] += b_row[j];
+			}
+
+			for (int s = 0; s < 2; s++) {
+				const double *dep = dependent.data() + static_cast<size_t>(2 * d + s) * P;
+				double a_s = a_row[n - 2 + s], b_s = b_row[n - 2 + s];
+
+				for (int f = 0; f < P; f++) {
+					AN[row * P + f] += a_s * dep[f];
+					BN[row * P + f] += b_s * dep[f];
+				}
+			}
+		}
+	}
+
+	std::vector<int> perm_b(P);
+
+	if (!dense_eigen::lu_decompose(BN.data(), P, perm_b.data())) {
+		std::string reason = "Error: void cheb_well::build_hamiltonian(std::vector<double> &dependent, std::vector<double> &h) const\n";
+		reason += "The collocation matrix is singular\n";
+		throw std::invalid_argument(reason);
+	}
+
+	h.assign(static_cast<size_t>(P) * P, 0.0);
+
+	std::vector<double> rhs(P);
+
+	for (int f = 0; f < P; f++) {
+		for (int i = 0; i < P; i++) rhs[i] = AN[static_cast<size_t>(i) * P + f];
+
+		dense_eigen::lu_solve(BN.data(), P, perm_b.data(), rhs.data());
+
+		for (int i = 0; i < P; i++) h[static_cast<size_t>(i) * P + f] = rhs[i];
+	}
+}
+
+double cheb_well::domain_integral_psi2(int d, const double *c) const
+{
+	// psi^{2} has twice the degree of psi, it is sampled at the 2 n_d Gauss nodes, fitted with chebft and integrated with chint
+
+	int n = n_coeff[d], n2 = 2 * n;
+	double a = x_bound[d], b = x_bound[d + 1];
+	double bma = 0.5 * (b - a), bpa = 0.5 * (b + a);
+
+	std::vector<double> x(n2), f(n2), c2(n2), cint(n2);
+	std::vector<int> st(n2);
+
+	for (int k = 0; k < n2; k++) x[k] = bpa + bma * cos(PI * (k + 0.5) / n2);
+
+	cheb_appr::chebev(a, b, c, n, x.data(), n2, f.data(), st.data());
+
+	for (int k = 0; k < n2; k++) f[k] *= f[k];
+
+	cheb_appr::chebft(a, b, c2.data(), n2, f.data());
+
+	cheb_appr::chint(a, b, c2.data(), cint.data(), n2);
+
+	return cheb_appr::chebev(a, b, cint.data(), n2, b);
+}
+
+void cheb_well::solve(int n_states)
+{
+	// the lowest n_states real eigenvalues of h, the eigenvectors are expanded to all coefficients and scaled so that the integral of psi^{2} is one,
+	// h also has complex and spurious eigenvalues far above the resolved levels, which are never among the lowest
+
+	try{
+
+		int D = get_n_domains(), P = get_n_unknowns();
+
+		bool c1 = D > 0 ? true : false;
+		bool c2 = n_states > 0 && n_states <= P ? true : false;
+
+		if(c1 && c2){
+			int n_total = offset[D];
+
+			std::vector<double> dependent, h;
+
+			build_hamiltonian(dependent, h);
+
+			std::vector<double> wr(P), wi(P);
+
+			if (!dense_eigen::eigenvalues(h.data(), P, wr.data(), wi.data())) {
+				std::string reason = "Error: void cheb_well::solve(int n_states)\n";
+				reason += "QR iteration did not converge\n";
+				throw std::invalid_argument(reason);
+			}
+
+			std::vector<double> levels;
+			for (int i = 0; i < P; i++) if (wi[i] == 0.0) levels.push_back(wr[i]);
+
+			if (static_cast<int>(levels.size()) < n_states) {
+				std::string reason = "Error: void cheb_well::solve(int n_states)\n";
+				reason += "Only " + template_funcs::toString(static_cast<int>(levels.size())) + " real levels were found, use more coefficients\n";
+				throw std::invalid_argument(reason);
+			}
+
+			std::sort(levels.begin(), levels.end());
+
+			energies.assign(levels.begin(), levels.begin() + n_states);
+			coeffs.assign(static_cast<size_t>(n_states) * n_total, 0.0);
+
+			std::vector<double> z(P);
+
+			for (int n = 0; n < n_states; n++) {
+				double *c = coeffs.data() + static_cast<size_t>(n) * n_total;
+
+				if (!dense_eigen::eigenvector(h.data(), P, energies[n], z.data())) {
+					std::string reason = "Error: void cheb_well::solve(int n_states)\n";
+					reason += "No eigenvector found for level " + template_funcs::toString(n) + "\n";
+					throw std::invalid_argument(reason);
+				}
+
+				for (int d = 0; d < D; d++) {
+					int m = n_coeff[d];
+					for (int j = 0; j < m - 2; j++) c[offset[d] + j] = z[offset[d] - 2 * d + j];
+					for (int s = 0; s < 2; s++) {
+						const double *dep = dependent.data() + static_cast<size_t>(2 * d + s) * P;
+						double sum = 0.0;
+						for (int f = 0; f < P; f++) sum += dep[f] * z[f];
+						c[offset[d] + m - 2 + s] = sum;
+					}
+				}
+
+				// normalise, and make the first value larger than 1e-3 of the maximum on the collocation points, read from the left, positive
+				double norm = 0.0;
+				for (int d = 0; d < D; d++) norm += domain_integral_psi2(d, c + offset[d]);
+
+				std::vector<double> psi_c(P);
+				std::vector<int> st(P);
+				double v_max = 0.0;
+
+				for (int d = 0; d < D; d++) {
+					int row0 = offset[d] - 2 * d;
+					cheb_appr::chebev(x_bound[d], x_bound[d + 1], c + offset[d], n_coeff[d], x_colloc.data() + row0, n_coeff[d] - 2, psi_c.data() + row0, st.data());
+				}
+				for (int i = 0; i < P; i++) v_max = std::max(v_max, fabs(psi_c[i]));
+
+				double sign = 1.0;
+				for (int d = 0, found = 0; d < D && !found; d++) {
+					// the collocation points of a domain run from right to left
+					for (int k = offset[d] - 2 * d + n_coeff[d] - 3; k >= offset[d] - 2 * d && !found; k--) {
+						if (fabs(psi_c[k]) > 1.0e-3 * v_max) {
+							sign = psi_c[k] < 0.0 ? -1.0 : 1.0;
+							found = 1;
+						}
+					}
+				}
+
+				norm = sign / sqrt(norm);
+				for (int i = 0; i < n_total; i++) c[i] *= norm;
+			}
+		}
+		else{
+			std::string reason = "Error: void cheb_well::solve(int n_states)\n";
+			if(!c1) reason += "No profile has been set\n";
+			if(!c2) reason += "Number of states must be in the range 1..P, P the number of unknowns\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double cheb_well::energy_eigenvalue(int n) const
+{
+	// return the energy of the n^{th} computed state in units of eV
+
+	try{
+
+		if(n > -1 && n < get_n_states()){
+			return energies[n];
+		}
+		else{
+			std::string reason = "Error: double cheb_well::energy_eigenvalue(int n) const\n";
+			reason += "Value of n must be in the range of computed states\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+double cheb_well::energy_eigenfunction(int n, double x) const
+{
+	// sum the Chebyshev series of the domain holding x, at an interface either side gives the same value
+
+	try{
+
+		int D = get_n_domains();
+
+		if(n > -1 && n < get_n_states() && D > 0 && x >= x_bound[0] && x <= x_bound[D]){
+			int d = 0;
+			while (d < D - 1 && x > x_bound[d + 1]) d++;
+
+			double f;
+			int st;
+
+			cheb_appr::chebev(x_bound[d], x_bound[d + 1], coeffs.data() + static_cast<size_t>(n) * offset[D] + offset[d], n_coeff[d], &x, 1, &f, &st);
+
+			return f;
+		}
+		else{
+			std::string reason = "Error: double cheb_well::energy_eigenfunction(int n, double x) const\n";
+			reason += "Values of n and x must be in range of computed states and of the domains\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
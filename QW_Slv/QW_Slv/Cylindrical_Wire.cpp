@@ -0,0 +1,321 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the cylindrical wire class
+
+namespace {
+
+	const double K_ASYMPTOTIC = 600.0; // above this argument bessel_K underflows and K_0 / K_1 is taken from its asymptotic series
+
+	double bessel_K_ratio_01(double w)
+	{
+		// K_0(w) / K_1(w) for w > 0
+		// for large w both functions carry the factor sqrt(pi / 2 w) exp(-w), which cancels from the ratio of the Hankel series
+		// K_nu(w) ~ sqrt(pi / 2 w) exp(-w) sum_k prod_{j=1}^{k} (4 nu^{2} - (2 j - 1)^{2}) / (k! (8 w)^{k}), whose terms fall off as k / 2 w
+
+		if (w <= K_ASYMPTOTIC) return ( special::bessel_K(0, w) / special::bessel_K(1, w) );
+
+		double t0 = 1.0, t1 = 1.0, s0 = 1.0, s1 = 1.0;
+
+		for (int k = 1; k <= 8; k++) {
+			double odd = template_funcs::DSQR(2.0 * k - 1.0);
+			t0 *= -odd / (8.0 * k * w);
+			t1 *= (4.0 - odd) / (8.0 * k * w);
+			s0 += t0;
+			s1 += t1;
+		}
+
+		return ( s0 / s1 );
+	}
+
+	double bessel_K_log_derivative(int m, double w)
+	{
+		// q(w) = -w K_m'(w) / K_m(w) = m + w K_{m-1}(w) / K_m(w), with K_{-1} = K_1
+		// K_{j-1} / K_{j} follows from K_{j+1} = K_{j-1} + (2 j / w) K_{j}, which is stable upwards and only forms ratios,
+		// so nothing overflows for small w or underflows for large w, w = 0 is the limit q = m
+
+		if (w <= 0.0) return static_cast<double>(m);
+
+		double rho = bessel_K_ratio_01(w); // K_0 / K_1
+
+		if (m == 0) return ( w / rho );
+
+		for (int j = 1; j < m; j++) rho = 1.0 / (2.0 * j / w + rho);
+
+		return ( m + w * rho );
+	}
+}
+
+cyl_wire::cyl_wire()
+{
+	// Default Constructor
+
+	M_ratio = 1.0;
+	a = M_well = M_barr = well_depth = u_max = 0.0;
+}
+
+cyl_wire::cyl_wire(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// Constructor
+
+	// radius of the wire is expressed in nm
+	// masses of the particle in the wire and in the barrier are expressed in kg, e.g. 0.067 * M_ELECTRON_KG
+	// barrier_height is the depth of the wire potential expressed in eV
+
+	set_wire_params(radius, mass_well, mass_barrier, barrier_height);
+}
+
+void cyl_wire::set_wire_params(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// method for assigning values to the wire parameters, every bound state of every channel is solved
+	// channels are independent so a wire with many channels is shared out between threads
+
+	try{
+
+		assign_wire_params(radius, mass_well, mass_barrier, barrier_height);
+
+		extend_zeros(u_max);
+
+		int n_channels = static_cast<int>(floor(u_max)) + 1;
+
+		channel_u.assign(n_channels, std::vector<double>());
+
+		auto solve_channel = [this](int m) { channel_levels(m, u_max, std::numeric_limits<int>::max(), u_max, channel_u[m]); };
+
+		if (n_channels >= PARALLEL_MIN_CHANNELS) {
+			parallel_funcs::parallel_for(n_channels, solve_channel);
+		}
+		else {
+			for (int m = 0; m < n_channels; m++) solve_channel(m);
+		}
+
+		while (!channel_u.empty() && channel_u.back().empty()) channel_u.pop_back(); // the first level rises with m, so empty channels are all at the end
+	}
+	catch(std::invalid_argument &e){
+		std::string reason = "Error: void cyl_wire::set_wire_params(double radius, double mass_well, double mass_barrier, double barrier_height)\n";
+		useful_funcs::exit_failure_output(reason + e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void cyl_wire::assign_wire_params(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// check and store the wire parameters, the reasons for rejecting them are thrown to the caller
+
+	bool c1 = radius > 0.0 ? true : false;
+	bool c2 = mass_well > 0.0 ? true : false;
+	bool c2a = mass_barrier > 0.0 ? true : false;
+	bool c3 = barrier_height > 0.0 ? true : false;
+
+	if(c1 && c2 && c2a && c3){
+
+		a = radius;
+		M_well = mass_well;
+		M_barr = mass_barrier;
+		M_ratio = (M_barr / M_well);
+		well_depth = barrier_height;
+		u_max = scale_u_max(a);
+	}
+	else{
+		std::string reason;
+		if(!c1) reason += "radius is not positive\n";
+		if(!c2) reason += "mass in wire is not positive\n";
+		if(!c2a) reason += "mass in barrier is not positive\n";
+		if(!c3) reason += "barrier height is not positive\n";
+		throw std::invalid_argument(reason);
+	}
+}
+
+double cyl_wire::scale_u_max(double radius) const
+{
+	// k a for a particle in a wire of the given radius in nm with energy equal to the barrier height
+
+	return ( sqrt(2.0 * M_well * template_funcs::convert_ev_J(well_depth)) * radius * 1.0e-9 / H_BAR_J );
+}
+
+double cyl_wire::energy_eigenvalue(int m, int n) const
+{
+	// return the energy of the n^{th} level of channel m in units of eV
+
+	try{
+
+		if(n > -1 && n < get_n_states(m)){
+			return ( well_depth * template_funcs::DSQR(channel_u[m][n] / u_max) );
+		}
+		else{
+			std::string reason = "Error: double cyl_wire::energy_eigenvalue(int m, int n) const\n";
+			reason += "Values of m and n must be in range of allowed values\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+double cyl_wire::matching_function(int m, double u, double u_top) const noexcept
+{
+	// F(u) = r u J_m'(u) + q(w) J_m(u) with u J_m'(u) = u J_{m-1}(u) - m J_m(u), J_{-1} = -J_1
+	// u slightly past u_top through rounding is taken as the barrier top, w = 0
+
+	double w2 = M_ratio * (u_top - u) * (u_top + u);
+	double w = w2 > 0.0 ? sqrt(w2) : 0.0;
+
+	double Jm, Jm1;
+
+	if (m == 0) {
+		special::bessel_J_pair(1, u, Jm, Jm1);
+		Jm1 = -Jm1;
+	}
+	else {
+		special::bessel_J_pair(m, u, Jm1, Jm);
+	}
+
+	return ( M_ratio * (u * Jm1 - m * Jm) + bessel_K_log_derivative(m, w) * Jm );
+}
+
+void cyl_wire::channel_levels(int m, double u_top, int max_levels, double u_ceiling, std::vector<double> &u) const
+{
+	// level s, counting from s = 0, of channel m has u in (j_{m,s}, j_{m,s+1}) with j_{m,0} = 0, the bracket is closed at u_top when
+	// j_{m,s+1} >= u_top and the level is bound only if F changes sign on the shortened bracket
+	// F(u) has the sign of J_m'(j_{m,s}) at the zeros of J_m, which alternates, so the closed brackets need no check
+	// for m > 0, F(0) = 0 and the first bracket starts at u = m instead, where J_m and J_m' are positive and F > 0
+	// F is continuous, so the value at the end of one bracket is reused at the start of the next
+
+	u.clear();
+
+	if (m > 0 && m >= u_top) return;
+
+	const std::vector<double> &zeros = bessel_zeros[m];
+
+	double lo = static_cast<double>(m), f_lo = matching_function(m, lo, u_top);
+
+	for (size_t s = 0; static_cast<int>(u.size()) < max_levels && lo < u_ceiling; s++) {
+		bool top = !(zeros[s] < u_top);
+		double hi = top ? u_top : zeros[s], f_hi = matching_function(m, hi, u_top);
+
+		if (top && !(f_hi > 0.0 ? f_lo < 0.0 : f_lo > 0.0)) break; // no sign change below the barrier top, the level is not bound
+
+		int iter;
+		double root = root_funcs::brent([this, m, u_top](double x) { return matching_function(m, x, u_top); }, lo, hi, f_lo, f_hi, 1.0e-15 * hi, iter);
+
+		u.push_back(root);
+
+		if (top) break;
+
+		lo = hi;
+		f_lo = f_hi;
+	}
+}
+
+void cyl_wire::extend_zeros(double u_top)
+{
+	// the channels m = 0..floor(u_top) need the zeros of J_m up to the first one at or above u_top to close their last bracket
+
+	int m_top = static_cast<int>(floor(u_top));
+
+	if (static_cast<int>(bessel_zeros.size()) <= m_top) bessel_zeros.resize(m_top + 1);
+
+	for (int m = 0; m <= m_top; m++) {
+		while (bessel_zeros[m].empty() || bessel_zeros[m].back() < u_top) extend_channel_zeros(m, static_cast<int>(bessel_zeros[m].size()) + 1);
+	}
+}
+
+void cyl_wire::extend_channel_zeros(int m, int n_zeros)
+{
+	// zeros of J_0 satisfy (s - 1) pi < j_{0,s} < s pi, being close to (s - 1 / 4) pi
+	// zeros of J_m interlace with those of J_{m-1}, j_{m-1,s} < j_{m,s} < j_{m-1,s+1}, so the s^{th} zero of J_m needs s + 1 zeros of J_{m-1}
+	// each zero is refined by Brent's method on its bracket
+
+	if (static_cast<int>(bessel_zeros.size()) <= m) bessel_zeros.resize(m + 1);
+
+	if (m > 0) extend_channel_zeros(m - 1, n_zeros + 1);
+
+	std::vector<double> &zeros = bessel_zeros[m];
+
+	auto J = [m](double x) { return special::bessel_J(m, x); };
+
+	for (int s = static_cast<int>(zeros.size()); s < n_zeros; s++) {
+		double lo = m == 0 ? s * PI : bessel_zeros[m - 1][s];
+		double hi = m == 0 ? (s + 1) * PI : bessel_zeros[m - 1][s + 1];
+
+		int iter;
+		zeros.push_back( root_funcs::brent(J, lo, hi, J(lo), J(hi), 1.0e-15 * hi, iter) );
+	}
+}
+
+void cyl_wire::radius_sweep(const double *radius, int n_radii, int n_levels, double *energies, int *channel)
+{
+	// the lowest levels of a family of wires that differ only in radius
+	// E_{m,s} rises with both m and s, so channels are solved in order of m, each for at most n_levels levels, and once n_levels
+	// candidates are known the n_levels^{th} lowest u caps the brackets of the remaining channels, the sweep over m ends with the
+	// first channel that has nothing below the cap
+	// the zero table is extended once for the largest radius, after which the radii are independent and are shared out between threads
+
+	try{
+
+		bool c1 = u_max > 0.0 ? true : false;
+		bool c2 = n_levels > 0 ? true : false;
+		bool c3 = radius != nullptr && energies != nullptr ? true : false;
+		bool c4 = true;
+
+		for (int i = 0; c3 && i < n_radii; i++) if (!(radius[i] > 0.0)) c4 = false;
+
+		if (c1 && c2 && c3 && c4) {
+			double r_big = 0.0;
+			for (int i = 0; i < n_radii; i++) r_big = std::max(r_big, radius[i]);
+
+			extend_zeros(scale_u_max(r_big));
+
+			auto solve_radius = [&](int i) {
+				double u_top = scale_u_max(radius[i]), u_ceiling = u_top;
+				std::vector<std::pair<double, int>> levels;
+				std::vector<double> u;
+
+				for (int m = 0; m <= static_cast<int>(floor(u_top)); m++) {
+					channel_levels(m, u_top, n_levels, u_ceiling, u);
+
+					if (u.empty()) break;
+
+					for (size_t s = 0; s < u.size(); s++) levels.push_back(std::make_pair(u[s], m));
+
+					if (static_cast<int>(levels.size()) >= n_levels) {
+						std::sort(levels.begin(), levels.end());
+						levels.resize(n_levels);
+						u_ceiling = levels.back().first;
+					}
+				}
+
+				std::sort(levels.begin(), levels.end());
+
+				for (int j = 0; j < n_levels; j++) {
+					bool bound = j < static_cast<int>(levels.size());
+					energies[i * n_levels + j] = bound ? well_depth * template_funcs::DSQR(levels[j].first / u_top) : std::numeric_limits<double>::quiet_NaN();
+					if (channel != nullptr) channel[i * n_levels + j] = bound ? levels[j].second : -1;
+				}
+			};
+
+			if (n_radii >= PARALLEL_MIN_RADII) {
+				parallel_funcs::parallel_for(n_radii, solve_radius);
+			}
+			else {
+				for (int i = 0; i < n_radii; i++) solve_radius(i);
+			}
+		}
+		else {
+			std::string reason = "Error: void cyl_wire::radius_sweep(const double *radius, int n_radii, int n_levels, double *energies, int *channel)\n";
+			if (!c1) reason += "wire parameters have not been set\n";
+			if (!c2) reason += "n_levels is not positive\n";
+			if (!c3) reason += "radius or energies is NULL\n";
+			if (!c4) reason += "radius is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
@@ -0,0 +1,74 @@
+#ifndef CYLINDRICAL_WIRE_H
+#define CYLINDRICAL_WIRE_H
+
+// Bound states of a cylindrical quantum wire of radius a surrounded by a barrier of height V
+// The states are psi(r, phi) = R(r) exp(i m phi) / sqrt(2 pi), the radial part is J_m(k r) inside the wire and K_m(kappa r) outside
+// and the boundary conditions are continuity of psi and psi' / m at r = a
+// With u = k a, w = kappa a and r = m_barr / m_well the matching condition is r u J_m'(u) / J_m(u) = w K_m'(w) / K_m(w),
+// where w^{2} = r (u_max^{2} - u^{2}) and u_max = k a for a particle at the top of the barrier
+// Multiplying through by J_m(u) removes the poles, F(u) = r u J_m'(u) + q(w) J_m(u) with q(w) = -w K_m'(w) / K_m(w) > 0,
+// the ratio form of the matching condition decreases strictly between consecutive zeros j_{m,s-1} < u < j_{m,s} of J_m,
+// so channel m has exactly one level on every such interval below u_max and each root is bracketed without a search
+// The first level of channel m lies above the first zero of J_m', which is above m, so only channels m <= u_max can have bound states
+// Energies are E = V (u / u_max)^{2}, states with m > 0 are doubly degenerate with exp(-i m phi), only m >= 0 are stored
+// The zeros of J_m do not depend on the wire and are kept between solves, so a scan over radius only pays for the root refinements
+// J_m and K_m are the integer order special::bessel_J and special::bessel_K, whose rational approximations limit the energies
+// to a relative accuracy of about 1e-8
+
+// The natural scale for energy is eV, scale energies accordingly
+// The natural scale for length is nm, you can scale lengths accordingly
+
+class cyl_wire{
+public:
+	cyl_wire();
+
+	cyl_wire(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	void set_wire_params(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	double energy_eigenvalue(int m, int n) const; // energy of the n^{th} level of channel m in eV, n counted from 0
+
+	// the n_levels lowest levels for each radius[i] with the masses and barrier of the current wire, in increasing order
+	// energies[i * n_levels + j] in eV, channel[i * n_levels + j] the value of m if channel is not NULL, NaN and -1 past the last bound level
+	// radii are shared out between threads, each radius only solves the channels and levels that can reach the n_levels lowest
+	void radius_sweep(const double *radius, int n_radii, int n_levels, double *energies, int *channel = nullptr);
+
+	// getters
+	inline int get_n_channels() const { return static_cast<int>(channel_u.size()); } // channels m = 0..get_n_channels()-1 have bound states
+	inline int get_n_states(int m) const { return ( m > -1 && m < get_n_channels() ? static_cast<int>(channel_u[m].size()) : 0 ); }
+	inline double get_u_max() const { return u_max; }
+
+	static const int PARALLEL_MIN_CHANNELS = 32; // wires with fewer possible channels than this are solved on the calling thread
+
+	static const int PARALLEL_MIN_RADII = 16; // sweeps over fewer radii than this are solved on the calling thread
+
+private:
+	void assign_wire_params(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	double scale_u_max(double radius) const;
+
+	// F(u) of channel m for a wire with the given u_max, smooth in u and free of poles, does not throw
+	double matching_function(int m, double u, double u_top) const noexcept;
+
+	// levels of channel m in increasing order, at most max_levels and none whose bracket starts above u_ceiling
+	// reads the zero table only, so channels and radii can be solved from any number of threads once extend_zeros has run
+	void channel_levels(int m, double u_top, int max_levels, double u_ceiling, std::vector<double> &u) const;
+
+	// make the zero table hold every zero of J_m up to and including the first above u_top for m = 0..floor(u_top)
+	void extend_zeros(double u_top);
+
+	void extend_channel_zeros(int m, int n_zeros); // make bessel_zeros[m] hold at least n_zeros zeros
+
+private:
+	double a; // radius of the wire expressed in nm
+	double M_well; // mass of the particle in the wire expressed in kg
+	double M_barr; // mass of the particle in the barrier expressed in kg
+	double M_ratio; // ratio of mass in barrier to mass in wire
+	double well_depth; // height of energy barrier expressed in eV
+	double u_max; // k a for a particle with energy equal to the barrier height
+
+	std::vector<std::vector<double>> channel_u; // channel_u[m][n] = k a of the n^{th} level of channel m
+	std::vector<std::vector<double>> bessel_zeros; // bessel_zeros[m][s] = j_{m,s+1}, the positive zeros of J_m in increasing order
+};
+
+#endif
@@ -0,0 +1,353 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the dense eigenvalue routines
+
+namespace {
+
+	const double RADIX = 2.0; // balancing factors are powers of the floating point radix so no rounding is introduced
+
+	void balance(double *a, int n)
+	{
+		// balanc: a similarity transformation by a diagonal matrix makes the norms of corresponding rows and columns comparable,
+		// which reduces the round off in the eigenvalues of a badly scaled matrix
+
+		double sqrdx = RADIX * RADIX;
+		bool done = false;
+
+		while (!done) {
+			done = true;
+			for (int i = 0; i < n; i++) {
+				double r = 0.0, c = 0.0;
+				for (int j = 0; j < n; j++) {
+					if (j != i) {
+						c += fabs(a[j * n + i]);
+						r += fabs(a[i * n + j]);
+					}
+				}
+				if (c != 0.0 && r != 0.0) {
+					double g = r / RADIX, f = 1.0, s = c + r;
+					while (c < g) {
+						f *= RADIX;
+						c *= sqrdx;
+					}
+					g = r * RADIX;
+					while (c > g) {
+						f /= RADIX;
+						c /= sqrdx;
+					}
+					if ((c + r) / f < 0.95 * s) {
+						done = false;
+						g = 1.0 / f;
+						for (int j = 0; j < n; j++) a[i * n + j] *= g;
+						for (int j = 0; j < n; j++) a[j * n + i] *= f;
+					}
+				}
+			}
+		}
+	}
+
+	void hessenberg(double *a, int n)
+	{
+		// elmhes: Gaussian elimination with pivoting column by column, each elimination followed by its inverse on the columns,
+		// on output the elements below the first subdiagonal are left over multipliers and are to be thought of as zero
+
+		for (int m = 1; m < n - 1; m++) {
+			double x = 0.0;
+			int i = m;
+			for (int j = m; j < n; j++) {
+				if (fabs(a[j * n + m - 1]) > fabs(x)) {
+					x = a[j * n + m - 1];
+					i = j;
+				}
+			}
+			if (i != m) {
+				for (int j = m - 1; j < n; j++) std::swap(a[i * n + j], a[m * n + j]);
+				for (int j = 0; j < n; j++) std::swap(a[j * n + i], a[j * n + m]);
+			}
+			if (x != 0.0) {
+				for (i = m + 1; i < n; i++) {
+					double y = a[i * n + m - 1];
+					if (y != 0.0) {
+						y /= x;
+						a[i * n + m - 1] = y;
+						for (int j = m; j < n; j++) a[i * n + j] -= y * a[m * n + j];
+						for (int j = 0; j < n; j++) a[j * n + m] += y * a[j * n + i];
+					}
+				}
+			}
+		}
+	}
+
+	bool hqr(double *a, int n, double *wr, double *wi)
+	{
+		// hqr: eigenvalues of the upper Hessenberg matrix a by the double shift QR algorithm with exceptional shifts after 10 and 20 sweeps,
+		// written with one based indices as in the original, A(i, j) is a[(i - 1) n + j - 1], a is destroyed
+
+		auto A = [a, n](int i, int j) -> double& { return a[(i - 1) * n + (j - 1)]; };
+
+		int nn, m, l, k, j, its, i, mmin;
+		double z = 0.0, y, x, w, v, u, t, s, r = 0.0, q = 0.0, p = 0.0, anorm = 0.0;
+
+		for (i = 1; i <= n; i++)
+			for (j = std::max(i - 1, 1); j <= n; j++)
+				anorm += fabs(A(i, j));
+
+		nn = n;
+		t = 0.0;
+		while (nn >= 1) {
+			its = 0;
+			do {
+				for (l = nn; l >= 2; l--) {
+					s = fabs(A(l - 1, l - 1)) + fabs(A(l, l));
+					if (s == 0.0) s = anorm;
+					if (fabs(A(l, l - 1)) + s == s) {
+						A(l, l - 1) = 0.0;
+						break;
+					}
+				}
+				x = A(nn, nn);
+				if (l == nn) {
+					wr[nn - 1] = x + t;
+					wi[nn - 1] = 0.0;
+					nn--;
+				}
+				else {
+					y = A(nn - 1, nn - 1);
+					w = A(nn, nn - 1) * A(nn - 1, nn);
+					if (l == nn - 1) {
+						p = 0.5 * (y - x);
+						q = p * p + w;
+						z = sqrt(fabs(q));
+						x += t;
+						if (q >= 0.0) {
+							z = p + (p >= 0.0 ? fabs(z) : -fabs(z));
+							wr[nn - 2] = wr[nn - 1] = x + z;
+							if (z != 0.0) wr[nn - 1] = x - w / z;
+							wi[nn - 2] = wi[nn - 1] = 0.0;
+						}
+						else {
+							wr[nn - 2] = wr[nn - 1] = x + p;
+							wi[nn - 2] = -z;
+							wi[nn - 1] = z;
+						}
+						nn -= 2;
+					}
+					else {
+						if (its == dense_eigen::MAX_QR_ITERATIONS) return false;
+						if (its == 10 || its == 20) {
+							t += x;
+							for (i = 1; i <= nn; i++) A(i, i) -= x;
+							s = fabs(A(nn, nn - 1)) + fabs(A(nn - 1, nn - 2));
+							y = x = 0.75 * s;
+							w = -0.4375 * s * s;
+						}
+						++its;
+						for (m = nn - 2; m >= l; m--) {
+							z = A(m, m);
+							r = x - z;
+							s = y - z;
+							p = (r * s - w) / A(m + 1, m) + A(m, m + 1);
+							q = A(m + 1, m + 1) - z - r - s;
+							r = A(m + 2, m + 1);
+							s = fabs(p) + fabs(q) + fabs(r);
+							p /= s;
+							q /= s;
+							r /= s;
+							if (m == l) break;
+							u = fabs(A(m, m - 1)) * (fabs(q) + fabs(r));
+							v = fabs(p) * (fabs(A(m - 1, m - 1)) + fabs(z) + fabs(A(m + 1, m + 1)));
+							if (u + v == v) break;
+						}
+						for (i = m + 2; i <= nn; i++) {
+							A(i, i - 2) = 0.0;
+							if (i != m + 2) A(i, i - 3) = 0.0;
+						}
+						for (k = m; k <= nn - 1; k++) {
+							if (k != m) {
+								p = A(k, k - 1);
+								q = A(k + 1, k - 1);
+								r = 0.0;
+								if (k != nn - 1) r = A(k + 2, k - 1);
+								if ((x = fabs(p) + fabs(q) + fabs(r)) != 0.0) {
+									p /= x;
+									q /= x;
+									r /= x;
+								}
+							}
+							s = sqrt(p * p + q * q + r * r);
+							if (p < 0.0) s = -s;
+							if (s != 0.0) {
+								if (k == m) {
+									if (l != m) A(k, k - 1) = -A(k, k - 1);
+								}
+								else {
+									A(k, k - 1) = -s * x;
+								}
+								p += s;
+								x = p / s;
+								y = q / s;
+								z = r / s;
+								q /= p;
+								r /= p;
+								for (j = k; j <= nn; j++) {
+									p = A(k, j) + q * A(k + 1, j);
+									if (k != nn - 1) {
+										p += r * A(k + 2, j);
+										A(k + 2, j) -= p * z;
+									}
+									A(k + 1, j) -= p * y;
+									A(k, j) -= p * x;
+								}
+								mmin = nn < k + 3 ? nn : k + 3;
+								for (i = l; i <= mmin; i++) {
+									p = x * A(i, k) + y * A(i, k + 1);
+									if (k != nn - 1) {
+										p += z * A(i, k + 2);
+										A(i, k + 2) -= p * r;
+									}
+									A(i, k + 1) -= p * q;
+									A(i, k) -= p;
+								}
+							}
+						}
+					}
+				}
+			} while (l < nn - 1);
+		}
+
+		return true;
+	}
+}
+
+bool dense_eigen::lu_decompose(double *a, int n, int *perm)
+{
+	// Doolittle elimination with the largest available pivot in each column, the unit lower factor is stored below the diagonal
+
+	for (int i = 0; i < n; i++) perm[i] = i;
+
+	for (int k = 0; k < n; k++) {
+		int p = k;
+		for (int i = k + 1; i < n; i++) if (fabs(a[i * n + k]) > fabs(a[p * n + k])) p = i;
+
+		if (a[p * n + k] == 0.0) return false;
+
+		if (p != k) {
+			for (int j = 0; j < n; j++) std::swap(a[p * n + j], a[k * n + j]);
+			std::swap(perm[p], perm[k]);
+		}
+
+		double inv = 1.0 / a[k * n + k];
+		for (int i = k + 1; i < n; i++) {
+			double l = (a[i * n + k] *= inv);
+			if (l != 0.0) for (int j = k + 1; j < n; j++) a[i * n + j] -= l * a[k * n + j];
+		}
+	}
+
+	return true;
+}
+
+void dense_eigen::lu_solve(const double *lu, int n, const int *perm, double *b)
+{
+	// forward substitution with the unit lower factor on the permuted right hand side, then back substitution with the upper factor
+
+	std::vector<double> x(n);
+
+	for (int i = 0; i < n; i++) {
+		double sum = b[perm[i]];
+		for (int j = 0; j < i; j++) sum -= lu[i * n + j] * x[j];
+		x[i] = sum;
+	}
+
+	for (int i = n - 1; i >= 0; i--) {
+		double sum = x[i];
+		for (int j = i + 1; j < n; j++) sum -= lu[i * n + j] * x[j];
+		x[i] = sum / lu[i * n + i];
+	}
+
+	std::copy(x.begin(), x.end(), b);
+}
+
+bool dense_eigen::eigenvalues(const double *a, int n, double *wr, double *wi)
+{
+	// balance, reduce to Hessenberg form and apply the QR algorithm to a copy of a
+
+	try{
+
+		if(a != nullptr && wr != nullptr && wi != nullptr && n > 0){
+			std::vector<double> h(a, a + static_cast<size_t>(n) * n);
+
+			balance(h.data(), n);
+
+			hessenberg(h.data(), n);
+
+			return hqr(h.data(), n, wr, wi);
+		}
+		else{
+			std::string reason = "Error: bool dense_eigen::eigenvalues(const double *a, int n, double *wr, double *wi)\n";
+			reason += "Arrays are not defined or n is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return false;
+	}
+}
+
+bool dense_eigen::eigenvector(const double *a, int n, double lambda, double *v)
+{
+	// inverse iteration, (A - lambda I) v_{k+1} = v_k, lambda is accurate to round off so two or three solves give the vector to working precision,
+	// the shift is moved off lambda by a few ulps of the norm of A, and further should the factors still be exactly singular
+	// if they are singular at every shift up to 1e-6 of the norm there is no usable factorisation, v is left alone and false is returned
+
+	try{
+
+		std::vector<double> lu;
+		std::vector<int> perm(n);
+
+		double anorm = 0.0;
+		for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) anorm = std::max(anorm, fabs(a[i]));
+
+		double scale = std::max(anorm, fabs(lambda)), offset = 1.0e-14 * scale;
+		bool factored = false;
+
+		while (!factored && offset < 1.0e-6 * scale) {
+			lu.assign(a, a + static_cast<size_t>(n) * n);
+			for (int i = 0; i < n; i++) lu[i * n + i] -= lambda + offset;
+			offset *= 1.0e3;
+			factored = dense_eigen::lu_decompose(lu.data(), n, perm.data());
+		}
+
+		if (factored) {
+			for (int i = 0; i < n; i++) v[i] = 1.0 / sqrt(static_cast<double>(n)) * (1.0 + 0.1 * sin(1.0 + i));
+
+			for (int it = 0; it < 3; it++) {
+				dense_eigen::lu_solve(lu.data(), n, perm.data(), v);
+
+				double norm = 0.0;
+				for (int i = 0; i < n; i++) norm += v[i] * v[i];
+				norm = 1.0 / sqrt(norm);
+				for (int i = 0; i < n; i++) v[i] *= norm;
+			}
+
+			int i_max = 0;
+			for (int i = 1; i < n; i++) if (fabs(v[i]) > fabs(v[i_max])) i_max = i;
+			if (v[i_max] < 0.0) for (int i = 0; i < n; i++) v[i] = -v[i];
+
+			return true;
+		}
+		else{
+			std::string reason = "Error: bool dense_eigen::eigenvector(const double *a, int n, double lambda, double *v)\n";
+			reason += "A - lambda I is singular for every shift tried\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return false;
+	}
+}
@@ -0,0 +1,32 @@
+#ifndef DENSE_EIGEN_H
+#define DENSE_EIGEN_H
+
+// Eigenvalues and eigenvectors of a small dense real non-symmetric matrix, as produced by spectral collocation
+// Matrices are stored by rows, a[i * n + j] is element (i, j)
+// Eigenvalues: the matrix is balanced, reduced to upper Hessenberg form by stabilised elementary similarity transformations
+// and the Hessenberg matrix is reduced to quasi-triangular form by the shifted QR algorithm, based on balanc, elmhes and hqr
+// from Numerical Recipes in C, the cost is O(n^{3}) so this is meant for a few hundred unknowns
+// Eigenvectors: inverse iteration with the pivoted LU factors of A - lambda I, for real eigenvalues only
+// Linear systems: LU decomposition with partial pivoting, based on ludcmp and lubksb
+
+namespace dense_eigen{
+
+	static const int MAX_QR_ITERATIONS = 30; // QR sweeps allowed for any one eigenvalue before hqr gives up
+
+	// LU decomposition of a[0..n*n-1] with partial pivoting in place, row i of the factors came from row perm[i] of a
+	// returns false if a is singular to working precision
+	bool lu_decompose(double *a, int n, int *perm);
+
+	// solve A x = b in place with the factors from lu_decompose, b[0..n-1] is replaced by x
+	void lu_solve(const double *lu, int n, const int *perm, double *b);
+
+	// the n eigenvalues of a, real parts in wr[0..n-1] and imaginary parts in wi[0..n-1], complex pairs are adjacent
+	// a is not changed, returns false if the QR iteration did not converge
+	bool eigenvalues(const double *a, int n, double *wr, double *wi);
+
+	// unit eigenvector v[0..n-1] of a for the real eigenvalue lambda, the sign is chosen so that the largest component is positive
+	// returns false, leaving v unchanged, if no shift near lambda gives non-singular factors
+	bool eigenvector(const double *a, int n, double lambda, double *v);
+}
+
+#endif
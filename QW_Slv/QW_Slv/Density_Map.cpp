@@ -0,0 +1,147 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the density map functions for the potential step and barrier
+
+namespace {
+	// checks shared by the density_map overloads, E_lo and E_hi are the lowest and highest energies of the grid
+	// E_max is the upper limit of the allowed energies, returns the reason for failure or an empty string
+
+	std::string check_map(bool defined, double E_lo, double E_hi, double E_max, int n_E, double dx, int n_x)
+	{
+		std::string reason; 
+		if (!defined) reason += "No parameters defined for structure\n"; 
+		if (n_E < 1 || n_x < 1) reason += "Map must have at least one energy and one position\n"; 
+		if (!(dx > 0.0)) reason += "dx is not positive\n"; 
+		if (!(E_lo > 0.0)) reason += "Map contains energies that are not positive\n"; 
+		if (!(E_hi < E_max)) reason += "Map contains energies above the barrier height\n"; 
+		return reason; 
+	}
+
+	template <class Structure> double timed_map(const Structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads)
+	{
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+		density.resize(static_cast<size_t>(n_E) * n_x); 
+
+		map_funcs::density_rows(structure, E_start, dE, n_E, x_start, dx, n_x, &density[0], n_threads); 
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+		return ( (static_cast<double>(n_E) * n_x) / std::chrono::duration<double>(t1 - t0).count() ); 
+	}
+
+	template <class Structure> double timed_map(const Structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, std::string &reason, int n_threads)
+	{
+		std::ofstream write; 
+
+		write.open(filename.c_str(), std::ios_base::out | std::ios_base::trunc); 
+
+		if (!write.is_open()) {
+			reason = "Could not open file: " + filename + "\n"; 
+			return 0.0; 
+		}
+
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+		map_funcs::density_stream(structure, E_start, dE, n_E, x_start, dx, n_x, write, n_threads); 
+
+		write.close(); 
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+		return ( (static_cast<double>(n_E) * n_x) / std::chrono::duration<double>(t1 - t0).count() ); 
+	}
+}
+
+double map_funcs::density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads)
+{
+	// |psi(x, E)|^{2} for the potential step held in memory, energies in units of eV, positions in units of nm
+
+	try {
+		double E_end = E_start + (n_E - 1) * dE; 
+		std::string reason = check_map(structure.defined(), std::min(E_start, E_end), std::max(E_start, E_end), std::numeric_limits<double>::infinity(), n_E, dx, n_x); 
+
+		if (reason == empty_str) {
+			return timed_map(structure, E_start, dE, n_E, x_start, dx, n_x, density, n_threads); 
+		}
+		else {
+			reason = "Error: double map_funcs::density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads)\n" + reason; 
+			throw std::invalid_argument(reason); 
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double map_funcs::density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads)
+{
+	// |psi(x, E)|^{2} for the potential barrier held in memory, every energy must lie below the barrier height
+
+	try {
+		double E_end = E_start + (n_E - 1) * dE; 
+		std::string reason = check_map(structure.defined(), std::min(E_start, E_end), std::max(E_start, E_end), structure.get_V_eV(), n_E, dx, n_x); 
+
+		if (reason == empty_str) {
+			return timed_map(structure, E_start, dE, n_E, x_start, dx, n_x, density, n_threads); 
+		}
+		else {
+			reason = "Error: double map_funcs::density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads)\n" + reason; 
+			throw std::invalid_argument(reason); 
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double map_funcs::density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads)
+{
+	// |psi(x, E)|^{2} for the potential step streamed to filename
+	// a file that cannot be opened is reported and 0 is returned, as in compute_wavefunction
+
+	try {
+		double E_end = E_start + (n_E - 1) * dE; 
+		std::string reason = check_map(structure.defined(), std::min(E_start, E_end), std::max(E_start, E_end), std::numeric_limits<double>::infinity(), n_E, dx, n_x); 
+		if (filename == empty_str) reason += "Invalid filename\n"; 
+
+		if (reason == empty_str) {
+			double rate = timed_map(structure, E_start, dE, n_E, x_start, dx, n_x, filename, reason, n_threads); 
+			if (reason == empty_str) return rate; 
+		}
+
+		reason = "Error: double map_funcs::density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads)\n" + reason; 
+		throw std::invalid_argument(reason); 
+	}
+	catch (std::invalid_argument& e) {
+		std::cerr << e.what(); 
+		return 0.0; 
+	}
+}
+
+double map_funcs::density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads)
+{
+	// |psi(x, E)|^{2} for the potential barrier streamed to filename, every energy must lie below the barrier height
+
+	try {
+		double E_end = E_start + (n_E - 1) * dE; 
+		std::string reason = check_map(structure.defined(), std::min(E_start, E_end), std::max(E_start, E_end), structure.get_V_eV(), n_E, dx, n_x); 
+		if (filename == empty_str) reason += "Invalid filename\n"; 
+
+		if (reason == empty_str) {
+			double rate = timed_map(structure, E_start, dE, n_E, x_start, dx, n_x, filename, reason, n_threads); 
+			if (reason == empty_str) return rate; 
+		}
+
+		reason = "Error: double map_funcs::density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads)\n" + reason; 
+		throw std::invalid_argument(reason); 
+	}
+	catch (std::invalid_argument& e) {
+		std::cerr << e.what(); 
+		return 0.0; 
+	}
+}
@@ -0,0 +1,85 @@
+#ifndef DENSITY_MAP_H
+#define DENSITY_MAP_H
+
+// Probability density maps |psi(x, E)|^{2} on the uniform grid E_{i} = E_start + i dE, x_{j} = x_start + j dx
+// The (E, x) plane is cut into tiles of TILE_E energies by TILE_X positions and the tiles are shared out between threads
+// Each tile evaluates TILE_E rows of TILE_X positions through wavefunction_grid, so the scratch arrays stay in L1 cache and 
+// every solution is built once per energy rather than once per output file
+// Maps are stored row by row, density[i * n_x + j] = |psi(x_{j}, E_{i})|^{2}
+
+namespace map_funcs{
+
+	static const int TILE_E = 8; // energies per tile
+	static const int TILE_X = 512; // positions per tile
+
+	template <class Structure> void density_rows(const Structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, double *density, int n_threads = 0)
+	{
+		// compute n_E rows of the map into density[0..n_E * n_x - 1], no checks are made on the inputs
+		// Structure is step_structure or barr_structure, or any class whose solve(E) returns an object with wavefunction_grid
+
+		typedef decltype(structure.solve(E_start)) soln_type;
+
+		std::vector<soln_type> solns(n_E);
+
+		parallel_funcs::parallel_for(n_E, [&](int i) { solns[i] = structure.solve(E_start + i * dE); }, n_threads);
+
+		int n_tiles_E = (n_E + TILE_E - 1) / TILE_E, n_tiles_x = (n_x + TILE_X - 1) / TILE_X;
+
+		parallel_funcs::parallel_for(n_tiles_E * n_tiles_x, [&](int t) {
+			double re[TILE_X], im[TILE_X];
+
+			int i0 = (t / n_tiles_x) * TILE_E, j0 = (t % n_tiles_x) * TILE_X;
+			int i1 = std::min(i0 + TILE_E, n_E), nj = std::min(TILE_X, n_x - j0);
+
+			for (int i = i0; i < i1; i++) {
+				double *row = density + static_cast<size_t>(i) * n_x + j0;
+
+				solns[i].wavefunction_grid(x_start + j0 * dx, dx, nj, re, im);
+
+				for (int j = 0; j < nj; j++) row[j] = re[j] * re[j] + im[j] * im[j];
+			}
+		}, n_threads);
+	}
+
+	template <class Structure> void density_stream(const Structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::ofstream &write, int n_threads = 0)
+	{
+		// compute the map in bands of rows and write each band to the open stream while the next band is computed
+		// each line of the output is E_{i} , |psi(x_{0}, E_{i})|^{2} , ... , |psi(x_{n_x-1}, E_{i})|^{2}
+
+		int n_band = TILE_E * (n_threads > 0 ? n_threads : parallel_funcs::num_threads());
+		n_band = std::min(n_band, n_E);
+
+		std::vector<double> band[2] = { std::vector<double>(static_cast<size_t>(n_band) * n_x), std::vector<double>(static_cast<size_t>(n_band) * n_x) };
+		std::thread writer;
+
+		for (int b = 0, i0 = 0; i0 < n_E; b = 1 - b, i0 += n_band) {
+			int rows = std::min(n_band, n_E - i0);
+
+			density_rows(structure, E_start + i0 * dE, dE, rows, x_start, dx, n_x, &band[b][0], n_threads);
+
+			if (writer.joinable()) writer.join(); // the previous band has been written, so its buffer can be reused after this one
+
+			writer = std::thread([&write, &band, b, i0, rows, E_start, dE, n_x]() {
+				for (int i = 0; i < rows; i++) {
+					write << std::setprecision(10) << E_start + (i0 + i) * dE;
+					for (int j = 0; j < n_x; j++) write << " , " << band[b][static_cast<size_t>(i) * n_x + j];
+					write << "\n";
+				}
+			});
+		}
+
+		if (writer.joinable()) writer.join();
+	}
+
+	// maps held in memory, density is resized to n_E * n_x, the return value is the throughput in points per second
+	double density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads = 0);
+
+	double density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::vector<double> &density, int n_threads = 0);
+
+	// maps streamed to a text file, one line per energy, the return value is the throughput in points per second including the file output
+	double density_map(const step_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads = 0);
+
+	double density_map(const barr_structure &structure, double E_start, double dE, int n_E, double x_start, double dx, int n_x, std::string filename, int n_threads = 0);
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the finite difference well class
+
+fd_well::fd_well()
+{
+	// Default constructor
+	x_start = dx = lower_bound = 0.0;
+}
+
+fd_well::fd_well(double x_left, double x_right, const std::vector<double> &potential, const std::vector<double> &mass)
+{
+	// Constructor
+
+	set_profile(x_left, x_right, potential, mass);
+}
+
+void fd_well::set_profile(double x_left, double x_right, const std::vector<double> &potential, const std::vector<double> &mass)
+{
+	// sample the couplings t_{i-1/2} of H from the mass profile, any previously computed states are discarded
+
+	try{
+
+		bool c1 = x_right > x_left ? true : false;
+		bool c2 = potential.size() > 1 && potential.size() == mass.size() ? true : false;
+		bool c3 = c2 && *std::min_element(mass.begin(), mass.end()) > 0.0 ? true : false;
+
+		if(c1 && c2 && c3){
+			int N = static_cast<int>(potential.size());
+
+			x_start = x_left;
+			dx = (x_right - x_left) / (N + 1.0);
+
+			// hbar^{2} / (2 dx^{2}) in eV kg, divided by m_{i+1/2} to give t_{i+1/2}
+			double t_const = H_BAR_J * H_BAR_J / (2.0 * template_funcs::DSQR(dx * 1.0e-9) * template_funcs::convert_ev_J(1.0));
+
+			std::vector<double> t(N + 1);
+			t[0] = t_const / mass[0];
+			t[N] = t_const / mass[N - 1];
+			for (int i = 1; i < N; i++) t[i] = 2.0 * t_const / (mass[i - 1] + mass[i]);
+
+			V_grid = potential;
+			t_half.swap(t);
+
+			// the kinetic energy is at least that of the Dirichlet Laplacian with the smallest t, 4 t sin^{2}(pi / 2 (N + 1)),
+			// half of it is kept as a margin for round off
+			double t_min = *std::min_element(t_half.begin(), t_half.end());
+			lower_bound = *std::min_element(potential.begin(), potential.end()) + 2.0 * t_min * template_funcs::DSQR(sin(PI_2 / (N + 1.0)));
+
+			energies.clear();
+			psi.clear();
+		}
+		else{
+			std::string reason = "Error: void fd_well::set_profile(double x_left, double x_right, const std::vector<double> &potential, const std::vector<double> &mass)\n";
+			if(!c1) reason += "x_right must be greater than x_left\n";
+			if(!c2) reason += "potential and mass must have the same size, at least two points\n";
+			if(c2 && !c3) reason += "mass is not positive everywhere\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void fd_well::solve(int n_states)
+{
+	// eigenvalues by Sturm sequence bisection, eigenvectors by inverse iteration, both from tridiag_funcs
+	// the unit eigenvectors are scaled by 1 / sqrt(dx) so that the sum of psi^{2} dx is one
+
+	try{
+
+		int N = get_n_points();
+
+		bool c1 = N > 0 ? true : false;
+		bool c2 = n_states > 0 && n_states <= N ? true : false;
+
+		if(c1 && c2){
+			energies.resize(n_states);
+			psi.resize(static_cast<size_t>(n_states) * N);
+
+			tridiag_funcs::lowest_eigenvalues(V_grid.data(), t_half.data(), N, n_states, lower_bound, energies.data());
+
+			tridiag_funcs::inverse_iteration(V_grid.data(), t_half.data(), N, n_states, energies.data(), psi.data());
+
+			double scale = 1.0 / sqrt(dx);
+
+			for (int n = 0; n < n_states; n++) {
+				double *v = psi.data() + static_cast<size_t>(n) * N, v_max = 0.0;
+
+				for (int i = 0; i < N; i++) v_max = std::max(v_max, fabs(v[i]));
+
+				int i = 0;
+				while (i < N && fabs(v[i]) <= 1.0e-3 * v_max) i++;
+
+				double s = (i < N && v[i] < 0.0) ? -scale : scale;
+				for (i = 0; i < N; i++) v[i] *= s;
+			}
+		}
+		else{
+			std::string reason = "Error: void fd_well::solve(int n_states)\n";
+			if(!c1) reason += "No profile has been set\n";
+			if(!c2) reason += "Number of states must be in the range 1..N\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double fd_well::energy_eigenvalue(int n) const
+{
+	// return the energy of the n^{th} computed state in units of eV
+
+	try{
+
+		if(n > -1 && n < get_n_states()){
+			return energies[n];
+		}
+		else{
+			std::string reason = "Error: double fd_well::energy_eigenvalue(int n) const\n";
+			reason += "Value of n must be in the range of computed states\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+double fd_well::energy_eigenfunction(int n, int i) const
+{
+	// return the n^{th} wavefunction at grid point x_i
+
+	try{
+
+		if(n > -1 && n < get_n_states() && i > -1 && i < get_n_points()){
+			return psi[static_cast<size_t>(n) * get_n_points() + i];
+		}
+		else{
+			std::string reason = "Error: double fd_well::energy_eigenfunction(int n, int i) const\n";
+			reason += "Values of n and i must be in range of computed states and grid points\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+const double* fd_well::energy_eigenfunction(int n) const
+{
+	// return the n^{th} wavefunction at every grid point
+
+	return ( n > -1 && n < get_n_states() ? psi.data() + static_cast<size_t>(n) * get_n_points() : nullptr );
+}
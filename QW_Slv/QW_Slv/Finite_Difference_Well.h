@@ -0,0 +1,69 @@
+#ifndef FINITE_DIFFERENCE_WELL_H
+#define FINITE_DIFFERENCE_WELL_H
+
+// Bound states of an arbitrary one dimensional potential V(x) with position dependent effective mass m(x) by finite differences
+// The BenDaniel-Duke Hamiltonian H = -(hbar^{2} / 2) d/dx (1 / m(x)) d/dx + V(x) is discretised on the uniform grid
+// x_i = x_left + (i + 1) dx, i = 0..N-1, dx = (x_right - x_left) / (N + 1), with psi = 0 at x_left and x_right, which gives
+// (H psi)_i = -t_{i-1/2} psi_{i-1} + (V_i + t_{i-1/2} + t_{i+1/2}) psi_i - t_{i+1/2} psi_{i+1}, t_{i+1/2} = hbar^{2} / (2 m_{i+1/2} dx^{2}),
+// where m_{i+1/2} = (m_i + m_{i+1}) / 2 keeps the flux psi' / m continuous across a mass step that falls between x_i and x_{i+1}
+// H is symmetric tridiagonal and only the lowest k of its N eigenpairs are wanted, tridiag_funcs finds them in O(N k),
+// V and t are passed as they are, the diagonal V_i + t_{i-1/2} + t_{i+1/2} is never formed, so energies far below t are not lost to cancellation
+// The error in an energy is O(dx^{2}) for a smooth profile and for steps that fall midway between grid points, a step on a grid point
+// adds an O(dx) term
+
+// The natural scale for energy is eV, scale energies accordingly
+// The natural scale for length is nm, you can scale lengths accordingly
+
+class fd_well{
+public:
+	fd_well();
+
+	// potential[i] in eV and mass[i] in kg are the values at x_i, lengths are in nm
+	fd_well(double x_left, double x_right, const std::vector<double> &potential, const std::vector<double> &mass);
+
+	void set_profile(double x_left, double x_right, const std::vector<double> &potential, const std::vector<double> &mass);
+
+	// sample the profile functions V(x) in eV and m(x) in kg at the n_points interior grid points
+	template <class Potential, class Mass> void set_profile(double x_left, double x_right, int n_points, Potential V, Mass m)
+	{
+		std::vector<double> potential(n_points > 0 ? n_points : 0), mass(n_points > 0 ? n_points : 0);
+
+		double h = n_points > 0 ? (x_right - x_left) / (n_points + 1.0) : 0.0;
+
+		for (int i = 0; i < n_points; i++) {
+			double x = x_left + (i + 1) * h;
+			potential[i] = V(x);
+			mass[i] = m(x);
+		}
+
+		set_profile(x_left, x_right, potential, mass);
+	}
+
+	// compute the lowest n_states eigenpairs of the current profile, earlier results are replaced
+	void solve(int n_states);
+
+	double energy_eigenvalue(int n) const; // energy of the n^{th} state in eV, n counted from 0
+
+	double energy_eigenfunction(int n, int i) const; // normalised n^{th} wavefunction at x_i, the sum of psi^{2} dx over the grid is one
+
+	const double* energy_eigenfunction(int n) const; // the n^{th} wavefunction at every grid point, nullptr if n is out of range
+
+	// getters
+	inline int get_n_points() const { return static_cast<int>(V_grid.size()); }
+	inline int get_n_states() const { return static_cast<int>(energies.size()); }
+	inline double get_dx() const { return dx; }
+	inline double position(int i) const { return ( x_start + (i + 1) * dx ); }
+
+private:
+	double x_start; // left end of the domain expressed in nm, psi = 0 there
+	double dx; // grid spacing expressed in nm
+	double lower_bound; // no eigenvalue of H lies below min(V) plus the lowest level of the Dirichlet Laplacian with the largest mass
+
+	std::vector<double> V_grid; // V_grid[i] = V(x_i) in eV
+	std::vector<double> t_half; // t_half[i] = t_{i-1/2} in eV, i = 0..N, t_half[0] and t_half[N] couple to the walls
+
+	std::vector<double> energies; // energies of the computed states in eV
+	std::vector<double> psi; // psi[n * N + i] = n^{th} wavefunction at x_i, the first component larger than 1e-3 of the maximum is positive
+};
+
+#endif
@@ -11,16 +11,25 @@ fin_well::fin_well()
 
 	n_states = 0; 
 
+	root_calls = 0; 
+
+	nonparabolic = false; 
+	inv_gap_well = inv_gap_barr = theta_energy_const = 0.0; 
+
 	M_ratio = 1.0; 
-	A = L = Lhalf = M_well = M_barr = x_c = E_range = 0.0; 
+	theta_max_prev = 0.0; 
+	L = Lhalf = M_well = M_barr = x_c = well_depth = theta_max = 0.0; 
 }
 
 fin_well::fin_well(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)
 {
 	// Constructor
 
+	nonparabolic = false; 
+	inv_gap_well = inv_gap_barr = 0.0; 
+
 	// length is the length of the well expressed in nm
-	// mass is the mass of the particle in the well expressed as a multiple of the electron mass, which is in kg
+	// masses of the particle in the well and in the barrier are expressed in kg, e.g. 0.067 * M_ELECTRON_KG
 	// barrier_height is the depth of the quantum well expressed in eV
 	// centre_position of the well determines where the centre of the well is located and is expressed in nm
 
@@ -29,49 +38,102 @@ fin_well::fin_well(double length, double mass_well, double mass_barrier, double
 
 void fin_well::set_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)
 {
-	// method for assigning values to the well parameters
+	// method for assigning values to the well parameters, every bound state is solved from scratch
 
 	// length is the length of the well expressed in nm
-	// mass is the mass of the particle in the well expressed as a multiple of the electron mass, which is in kg
+	// masses of the particle in the well and in the barrier are expressed in kg, e.g. 0.067 * M_ELECTRON_KG
 	// barrier_height is the depth of the quantum well expressed in eV
 	// centre_position of the well determines where the centre of the well is located and is expressed in nm
 
 	try{
 	
-		bool c1 = length > 0.0 ? true : false;
-		bool c2 = mass_well > 0.0 ? true : false;
-		bool c2a = mass_barrier > 0.0 ? true : false;
-		bool c3 = barrier_height > 0.0 ? true : false;
-
-		if(c1 && c2 && c3){
-
-			L = length; 
-			Lhalf = 0.5*L; 
-			A = sqrt(2.0/L); // normalistion constant for energy eigenfunctions, it can be any complex number whose absolute value is sqrt(2.0/L)
-			M_well = mass_well; 
-			M_barr = mass_barrier;
-			M_ratio = (M_barr / M_well); 
-			x_c = centre_position; 
-			well_depth = barrier_height; 
-			E_range = 2.0 * M_well * well_depth * template_funcs::DSQR(Lhalf/H_BAR_eV); // range over which energies are sought
+		assign_well_params(length, mass_well, mass_barrier, barrier_height, centre_position); 
+
+		u_prev.clear(); 
+		theta_max_prev = 0.0; 
+
+		solve_energy_eigenequation(); 
+	}
+	catch(std::invalid_argument &e){
+		std::string reason = "Error: void fin_well::set_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)\n"; 
+		useful_funcs::exit_failure_output(reason + e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+int fin_well::continue_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)
+{
+	// assign the next parameters of a sweep and solve for the bound states starting from the levels already known
+	// the arguments are those of set_well_params, a well that has not been solved before is solved from scratch
+
+	try{
+	
+		int n_old = n_states; 
+		double theta_max_curr = theta_max; 
+
+		assign_well_params(length, mass_well, mass_barrier, barrier_height, centre_position); 
+
+		if (n_old == 0) {
+			solve_energy_eigenequation(); 
 		}
-		else{
-			std::string reason = "Error: void fin_well::set_well_params(double length, double mass, double barrier_height, double centre_position)\n"; 
-			if(!c1) reason += "length is not positive\n"; 
-			if(!c2) reason += "mass in well is not positive\n"; 
-			if(!c2a) reason += "mass in barrier is not positive\n"; 
-			if(!c3) reason += "barrier height is not positive\n"; 
-			throw std::invalid_argument(reason); 
+		else {
+			continue_energy_eigenequation(theta_max_curr); 
 		}
 
+		return ( n_states - n_old ); 
 	}
 	catch(std::invalid_argument &e){
-		useful_funcs::exit_failure_output(e.what()); 
+		std::string reason = "Error: int fin_well::continue_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)\n"; 
+		useful_funcs::exit_failure_output(reason + e.what()); 
 		exit(EXIT_FAILURE); 
 	}
 }
 
-double fin_well::energy_eigenvalue(int n)
+void fin_well::set_nonparabolicity(double gap_well, double gap_barrier)
+{
+	// gap_well and gap_barrier are the band gaps of the well and barrier materials expressed in eV
+	// both must be positive to turn on the Kane masses, otherwise the masses are constant
+	// the gaps take effect when the well is next solved by set_well_params or continue_well_params
+
+	nonparabolic = (gap_well > 0.0 && gap_barrier > 0.0); 
+	inv_gap_well = nonparabolic ? 1.0 / gap_well : 0.0; 
+	inv_gap_barr = nonparabolic ? 1.0 / gap_barrier : 0.0; 
+}
+
+void fin_well::assign_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position)
+{
+	// check and store the well parameters, the reasons for rejecting them are thrown to the caller
+
+	bool c1 = length > 0.0 ? true : false;
+	bool c2 = mass_well > 0.0 ? true : false;
+	bool c2a = mass_barrier > 0.0 ? true : false;
+	bool c3 = barrier_height > 0.0 ? true : false;
+	bool c4 = barrier_height * inv_gap_barr < 1.0 ? true : false; // m_barr(E) > 0 for 0 <= E <= V
+
+	if(c1 && c2 && c2a && c3 && c4){
+
+		L = length; 
+		Lhalf = 0.5*L; 
+		M_well = mass_well; 
+		M_barr = mass_barrier;
+		M_ratio = (M_barr / M_well); 
+		x_c = centre_position; 
+		well_depth = barrier_height; 
+		theta_max = K(well_depth) * Lhalf; // k L / 2 of a particle at the top of the well, bound states have k L / 2 < theta_max
+		theta_energy_const = template_funcs::DSQR(H_BAR_J / (Lhalf * 1.0e-9)) / (2.0 * M_well * template_funcs::convert_ev_J(1.0)); // same eV to J factor as K
+	}
+	else{
+		std::string reason; 
+		if(!c1) reason += "length is not positive\n"; 
+		if(!c2) reason += "mass in well is not positive\n"; 
+		if(!c2a) reason += "mass in barrier is not positive\n"; 
+		if(!c3) reason += "barrier height is not positive\n"; 
+		if(!c4) reason += "barrier height is not below the band gap of the barrier\n"; 
+		throw std::invalid_argument(reason); 
+	}
+}
+
+double fin_well::energy_eigenvalue(int n) const
 {
 	// return the n^{th} energy eigenvalue in units of eV
 
@@ -81,7 +143,7 @@ double fin_well::energy_eigenvalue(int n)
 			return energy_levels[n];
 		}
 		else{
-			std::string reason = "Error: double fin_well::energy_eigenvalue(int n)\n"; 
+			std::string reason = "Error: double fin_well::energy_eigenvalue(int n) const\n"; 
 			reason += "Value of n must be in range of allowed values\n"; 
 			throw std::invalid_argument(reason); 
 		}
@@ -93,62 +155,265 @@ double fin_well::energy_eigenvalue(int n)
 	}
 }
 
-double fin_well::K(double beta)
+double fin_well::K(double beta) const noexcept
 {
-	// wavenumber in the well
+	// wavenumber in the well in units of nm^{-1}, beta in units of eV
+	// beta < 0 gives NaN, no check is made here
+	// the mass is m_well (1 + beta / Eg_well), which is m_well when the masses are constant
 
-	try{
-		
-		return ( sqrt(2.0*M_well*beta)/H_BAR_eV ); 
+	return ( sqrt(2.0 * M_well * (1.0 + beta * inv_gap_well) * template_funcs::convert_ev_J(beta)) * 1.0e-9 / H_BAR_J ); 
+}
 
+double fin_well::Alpha(double beta) const noexcept
+{
+	// decay constant in the barrier in units of nm^{-1}, beta in units of eV
+	// beta > well_depth is not a bound state and gives NaN
+	// the mass is m_barr (1 + (beta - V) / Eg_barr), which is m_barr when the masses are constant
+
+	return ( sqrt(2.0 * M_barr * (1.0 + (beta - well_depth) * inv_gap_barr) * template_funcs::convert_ev_J(well_depth - beta)) * 1.0e-9 / H_BAR_J ); 
+}
+
+double fin_well::energy_eigenequation(double theta, bool state) const noexcept
+{
+	// return the value of the energy eigenequation for the even (state = true) or odd (state = false) states
+	// the eigenequations are written in terms of theta = k L / 2, for which alpha L / 2 = sqrt( M_ratio (theta_max^{2} - theta^{2}) )
+
+	if (nonparabolic) return nonparabolic_eigenequation(theta, state); 
+
+	return ( state ? even_eigenequation(theta) : odd_eigenequation(theta) ); 
+}
+
+double fin_well::theta_energy(double theta) const noexcept
+{
+	// energy in eV of a particle in the well with k L / 2 = theta
+	// E (1 + E / Eg_well) = c theta^{2} is solved as E = 2 c theta^{2} / (1 + sqrt(1 + 4 c theta^{2} / Eg_well)), 
+	// which has no cancellation and is c theta^{2} for constant masses
+	// E is held at V up to theta_max so that rounding cannot make alpha(E) NaN at the top of the well, theta > theta_max gives NaN
+
+	if (theta > theta_max) return std::numeric_limits<double>::quiet_NaN(); 
+
+	double ct2 = theta_energy_const * theta * theta; 
+
+	return ( std::min(2.0 * ct2 / (1.0 + sqrt(1.0 + 4.0 * ct2 * inv_gap_well)), well_depth) ); 
+}
+
+double fin_well::nonparabolic_eigenequation(double theta, bool state) const noexcept
+{
+	// even states satisfy alpha / m_barr(E) = (k / m_well(E)) tan(k L / 2), odd states alpha / m_barr(E) = -(k / m_well(E)) cot(k L / 2)
+	// written as a cos(theta) - r theta sin(theta) and a sin(theta) + r theta cos(theta) with a = alpha L / 2, r = m_barr(E) / m_well(E)
+
+	double E = theta_energy(theta); 
+	double a = Alpha(E) * Lhalf; 
+	double r = M_ratio * (1.0 + (E - well_depth) * inv_gap_barr) / (1.0 + E * inv_gap_well); 
+
+	return ( state ? a * cos(theta) - r * theta * sin(theta) : a * sin(theta) + r * theta * cos(theta) ); 
+}
+
+double fin_well::even_eigenequation(double theta) const noexcept
+{
+	// even states satisfy alpha / M_barr = (k / M_well) tan(k L / 2)
+	// multiplying through by cos(theta) removes the poles of tan, so the function is smooth and changes sign once between n pi and n pi + pi / 2
+
+	double a = sqrt( M_ratio * (theta_max - theta) * (theta_max + theta) ); 
+
+	return ( a * cos(theta) - M_ratio * theta * sin(theta) ); 
+}
+
+double fin_well::odd_eigenequation(double theta) const noexcept
+{
+	// odd states satisfy alpha / M_barr = -(k / M_well) cot(k L / 2)
+	// multiplying through by sin(theta) removes the poles of cot, so the function is smooth and changes sign once between n pi + pi / 2 and (n + 1) pi
+
+	double a = sqrt( M_ratio * (theta_max - theta) * (theta_max + theta) ); 
+
+	return ( a * sin(theta) + M_ratio * theta * cos(theta) ); 
+}
+
+void fin_well::eigenequation_derivative(double theta, bool state, double &f, double &df) const noexcept
+{
+	// value and theta derivative of the even (state = true) or odd (state = false) eigenequation, used by the Newton steps of a continuation
+	// with a = sqrt( M_ratio (theta_max^{2} - theta^{2}) ), da / dtheta = -M_ratio theta / a
+	// in the non-parabolic mode a = alpha(E) L / 2 and r = m_barr(E) / m_well(E) are differentiated through E(theta)
+
+	double a, da, r = M_ratio, dr = 0.0, c = cos(theta), s = sin(theta); 
+
+	if (nonparabolic) {
+		double E = theta_energy(theta); 
+		double dE = 2.0 * theta_energy_const * theta / (1.0 + 2.0 * E * inv_gap_well); 
+		double mb = 1.0 + (E - well_depth) * inv_gap_barr, mw = 1.0 + E * inv_gap_well; 
+
+		a = Alpha(E) * Lhalf; // a^{2} is proportional to mb (V - E)
+		da = 0.5 * a * (inv_gap_barr / mb - 1.0 / (well_depth - E)) * dE; 
+		r = M_ratio * mb / mw; 
+		dr = r * (inv_gap_barr / mb - inv_gap_well / mw) * dE; 
 	}
-	catch(std::invalid_argument &e){
-		std::cerr<<e.what();
-		return 0.0; 
+	else {
+		a = sqrt( M_ratio * (theta_max - theta) * (theta_max + theta) ); 
+		da = -M_ratio * theta / a; 
+	}
+
+	if (state) {
+		f = a * c - r * theta * s; 
+		df = da * c - a * s - dr * theta * s - r * (s + theta * c); 
+	}
+	else {
+		f = a * s + r * theta * c; 
+		df = da * s + a * c + dr * theta * c + r * (c - theta * s); 
 	}
 }
 
-double fin_well::Alpha(double beta)
+void fin_well::solve_energy_eigenequation()
 {
-	// Decay constant in barrier
+	// compute every bound state energy of the well
+	// the n^{th} state, counting from n = 0, has theta = k L / 2 in [n pi / 2, (n + 1) pi / 2] and is even for even n, odd for odd n
+	// the eigenequation changes sign exactly once on [n pi / 2, min( (n + 1) pi / 2, theta_max )], so each root is bracketed without a search
+	// and refined with Brent's method, there are ceil(2 theta_max / pi) bound states
+	// states are independent so a large number of states is shared out between threads
+	// the eigenfunction constants of each state are stored alongside its energy
 
-	try{
-		return ( sqrt( 2.0*M_barr*(well_depth - beta) )/H_BAR_eV ); 
+	n_states = static_cast<int>( ceil(theta_max / PI_2) ); 
+
+	energy_levels.assign(n_states, 0.0); 
+	state_k.assign(n_states, 0.0); 
+	state_alpha.assign(n_states, 0.0); 
+	state_norm.assign(n_states, 0.0); 
+	state_wall.assign(n_states, 0.0); 
+	u_curr.assign(n_states, 0.0); 
+
+	std::vector<int> calls(n_states, 0); 
+
+	auto solve_state = [this, &calls](int n) {
+		bool even = (n % 2 == 0); 
+		double lo = n * PI_2, hi = std::min( (n + 1) * PI_2, theta_max ); 
+
+		double theta = root_funcs::brent([this, even](double t) { return energy_eigenequation(t, even); }, lo, hi, energy_eigenequation(lo, even), energy_eigenequation(hi, even), 1.0e-15 * hi, calls[n]); 
+
+		calls[n] += 2; // the end point values
+
+		store_state(n, theta); 
+	}; 
+
+	if (n_states >= PARALLEL_MIN_STATES) {
+		parallel_funcs::parallel_for(n_states, solve_state); 
 	}
-	catch(std::invalid_argument &e){
-		std::cerr<<e.what();
-		return 0.0; 
+	else {
+		for (int n = 0; n < n_states; n++) solve_state(n); 
 	}
+
+	root_calls = 0; 
+	for (int n = 0; n < n_states; n++) root_calls += calls[n]; 
 }
 
-double fin_well::energy_eigenequation(double beta, bool state)
+void fin_well::continue_energy_eigenequation(double theta_max_curr)
 {
-	// return the value of the energy eigenequation
+	// compute every bound state energy of the well using the levels of the last two points of a sweep as starting guesses
+	// theta_max_curr is theta_max of the point just left, u_curr holds its levels and u_prev, theta_max_prev those of the point before
+	// u = theta / theta_max lies in (0, 1) and varies slowly along a sweep, the first order predictor extrapolates it linearly in theta_max
+	// u = u_curr + (u_curr - u_prev) (theta_max - theta_max_curr) / (theta_max_curr - theta_max_prev), 
+	// falling back to u = u_curr for a level with no history or when theta_max has not changed
+	// the prediction is refined by Newton's method safeguarded by the bracket [n pi / 2, (n + 1) pi / 2] of the cold solve, 
+	// so level n keeps index n along the sweep, the eigenequation has the sign of (-1)^{floor(n / 2)} at n pi / 2
+	// the bracket also guards the top level, where the eigenequation has an infinite derivative at theta_max and a Newton step can overshoot
+	// levels that have just appeared have no previous value and are solved by Brent's method as in solve_energy_eigenequation
 
-	try{
-	
-		if(state){
-			return even_eigenequation(beta); 
+	int n_known = static_cast<int>(u_curr.size()), n_hist = static_cast<int>(u_prev.size()); 
+	bool slope = (n_hist > 0 && theta_max_curr != theta_max_prev); 
+	double ratio = slope ? (theta_max - theta_max_curr) / (theta_max_curr - theta_max_prev) : 0.0; 
+
+	n_states = static_cast<int>( ceil(theta_max / PI_2) ); 
+
+	std::vector<double> guess(n_states, 0.0); 
+	for (int n = 0; n < std::min(n_states, n_known); n++) {
+		double u = u_curr[n]; 
+		if (slope && n < n_hist) u += (u_curr[n] - u_prev[n]) * ratio; 
+		guess[n] = u * theta_max; 
+	}
+
+	u_prev = u_curr; 
+	theta_max_prev = theta_max_curr; 
+
+	energy_levels.assign(n_states, 0.0); 
+	state_k.assign(n_states, 0.0); 
+	state_alpha.assign(n_states, 0.0); 
+	state_norm.assign(n_states, 0.0); 
+	state_wall.assign(n_states, 0.0); 
+	u_curr.assign(n_states, 0.0); 
+
+	std::vector<int> calls(n_states, 0); 
+
+	auto solve_state = [this, &calls, &guess, n_known](int n) {
+		bool even = (n % 2 == 0); 
+		double lo = n * PI_2, hi = std::min( (n + 1) * PI_2, theta_max ), theta; 
+
+		if (n < n_known) {
+			bool positive_at_lo = ((n / 2) % 2 == 0); 
+
+			theta = root_funcs::newton_bracketed([this, even](double t, double &f, double &df) { eigenequation_derivative(t, even, f, df); }, lo, hi, positive_at_lo, guess[n], 1.0e-15 * hi, calls[n]); 
 		}
-		else{
-			return odd_eigenequation(beta); 
+		else {
+			theta = root_funcs::brent([this, even](double t) { return energy_eigenequation(t, even); }, lo, hi, energy_eigenequation(lo, even), energy_eigenequation(hi, even), 1.0e-15 * hi, calls[n]); 
+
+			calls[n] += 2; // the end point values
 		}
 
+		store_state(n, theta); 
+	}; 
+
+	if (n_states >= PARALLEL_MIN_STATES) {
+		parallel_funcs::parallel_for(n_states, solve_state); 
 	}
-	catch(std::invalid_argument &e){
-		std::cerr<<e.what();
-		return 0.0; 
+	else {
+		for (int n = 0; n < n_states; n++) solve_state(n); 
 	}
+
+	root_calls = 0; 
+	for (int n = 0; n < n_states; n++) root_calls += calls[n]; 
 }
 
-double fin_well::even_eigenequation(double beta)
+void fin_well::store_state(int n, double theta)
 {
-	// method that returns the value of the eigenequation for the even states
+	// store the energy and the eigenfunction constants of level n, whose eigenequation root is theta = k L / 2
+	// N follows from integrating |psi|^{2} analytically over the well and both barriers
+
+	bool even = (n % 2 == 0); 
+
+	energy_levels[n] = nonparabolic ? theta_energy(theta) : well_depth * template_funcs::DSQR(theta / theta_max); // E = V (theta / theta_max)^{2} for constant masses
+
+	double k = theta / Lhalf, alpha = Alpha(energy_levels[n]), wall = even ? cos(theta) : sin(theta); 
+	double norm = 1.0 / sqrt( Lhalf + (even ? 1.0 : -1.0) * sin(k * L) / (2.0 * k) + (wall * wall) / alpha ); 
+
+	state_k[n] = k; 
+	state_alpha[n] = alpha; 
+	state_norm[n] = norm; 
+	state_wall[n] = norm * wall; 
+	u_curr[n] = theta / theta_max; 
+}
+
+double fin_well::energy_eigenfunction(int n, double position) const
+{
+	// return the value of the normalised n^{th} eigenfunction at position, position in units of nm
+	// inside the well psi = N cos(k x) (even) or N sin(k x) (odd) with x measured from the centre of the well
+	// outside psi decays as exp( -alpha (|x| - L / 2) ) from its value at the wall
 
 	try{
-		double kval = K(beta); 
 
-		return ( Alpha(beta) - M_ratio*kval*tan(kval*Lhalf) ); 
+		if(n > -1 && n < n_states){
+			double x = position - x_c; 
+
+			if (fabs(x) <= Lhalf) {
+				return ( state_norm[n] * (n % 2 == 0 ? cos(state_k[n] * x) : sin(state_k[n] * x)) ); 
+			}
+			else {
+				double side = (n % 2 == 0 || x > 0.0) ? 1.0 : -1.0; // odd states change sign across the well
+				return ( side * state_wall[n] * exp( -state_alpha[n] * (fabs(x) - Lhalf) ) ); 
+			}
+		}
+		else{
+			std::string reason = "Error: double fin_well::energy_eigenfunction(int n, double position) const\n"; 
+			reason += "Value of n must be in range of allowed values\n"; 
+			throw std::invalid_argument(reason); 
+		}
+
 	}
 	catch(std::invalid_argument &e){
 		std::cerr<<e.what();
@@ -156,18 +421,106 @@ double fin_well::even_eigenequation(double beta)
 	}
 }
 
-double fin_well::odd_eigenequation(double beta)
+namespace {
+
+	// positions sorted into the well and the two barriers
+	// inside positions are measured from the centre of the well, outside positions by their distance from the nearest wall
+	// so that exp( -alpha d ) <= 1 and the barrier pieces cannot overflow however deep the state
+	// when the positions of a region are consecutive in the input, as they are for any sorted grid, results are written in place without a scatter
+	struct well_region {
+		std::vector<int> index; 
+		std::vector<double> x; 
+		bool consecutive; 
+	}; 
+
+	void fill_region(const double *position, double origin, double sign, well_region &r)
+	{
+		r.x.resize(r.index.size()); 
+
+		for (size_t i = 0; i < r.index.size(); i++) r.x[i] = sign * (position[r.index[i]] - origin); 
+
+		r.consecutive = r.index.empty() || (r.index.back() - r.index.front() + 1 == static_cast<int>(r.index.size())); 
+	}
+
+	// evaluate one region with a kernel kernel(x, n, out), writing to psi[index[i]]
+	template <class Kernel> void region_eval(Kernel kernel, const well_region &r, double *psi, std::vector<double> &work)
+	{
+		int n = static_cast<int>(r.index.size()); 
+
+		if (n == 0) return; 
+
+		if (r.consecutive) {
+			kernel(r.x.data(), n, psi + r.index.front()); 
+		}
+		else {
+			work.resize(n); 
+
+			kernel(r.x.data(), n, work.data()); 
+
+			for (int i = 0; i < n; i++) psi[r.index[i]] = work[i]; 
+		}
+	}
+}
+
+void fin_well::energy_eigenfunction(int n, const double *position, int n_positions, double *psi) const
 {
-	// method that returns the value of the eigenequation for the odd states
-	// Note cot(x) = tan( (pi/2) - x )
+	// evaluate the normalised n^{th} eigenfunction at the positions position[0..n_positions-1], position in units of nm
+	// the well and barrier pieces are each evaluated with the kernels of wave_kernels using the constants cached for state n
+
+	energy_eigenfunction_table(position, n_positions, n, 1, psi); 
+}
+
+void fin_well::energy_eigenfunction_table(const double *position, int n_positions, int n_first, int n_count, double *psi) const
+{
+	// evaluate states n_first..n_first+n_count-1 at the positions position[0..n_positions-1], position in units of nm
+	// psi[j * n_positions + i] is the state n_first + j at position[i]
+	// the positions are split into regions once, after which each state costs one kernel call per region
+	// the kernels of wave_kernels use AVX2 when it is enabled
+	// large tables are shared out between threads by state
 
 	try{
-		double kval = K(beta); 
+	
+		bool c1 = n_first > -1 && n_count > 0 && n_first + n_count <= n_states ? true : false; 
+		bool c2 = n_positions > 0 && position != nullptr && psi != nullptr ? true : false; 
+
+		if(c1 && c2){
+			well_region left, inside, right; 
+
+			wave_kernels::partition(position, n_positions, x_c - Lhalf, x_c + Lhalf, left.index, inside.index, right.index); 
+
+			fill_region(position, x_c - Lhalf, -1.0, left); 
+			fill_region(position, x_c, 1.0, inside); 
+			fill_region(position, x_c + Lhalf, 1.0, right); 
+
+			// psi = N cos(k x) or N sin(k x) inside, psi = psi_wall exp( -alpha d ) outside, with psi_wall negated on the left for odd states
+			auto eval = [&](int j) {
+				int n = n_first + j; 
+				bool even = (n % 2 == 0); 
+				double k = state_k[n], alpha = state_alpha[n], norm = state_norm[n], wall = state_wall[n]; 
+				double *row = psi + static_cast<size_t>(j) * n_positions; 
+				std::vector<double> work; 
+
+				region_eval([&](const double *x, int m, double *out) { wave_kernels::standing(k, even ? norm : 0.0, even ? 0.0 : norm, x, m, out); }, inside, row, work); 
+				region_eval([&](const double *x, int m, double *out) { wave_kernels::decaying(alpha, even ? wall : -wall, x, m, out); }, left, row, work); 
+				region_eval([&](const double *x, int m, double *out) { wave_kernels::decaying(alpha, wall, x, m, out); }, right, row, work); 
+			}; 
+
+			if (static_cast<double>(n_count) * n_positions >= PARALLEL_MIN_POINTS) {
+				parallel_funcs::parallel_for(n_count, eval); 
+			}
+			else {
+				for (int j = 0; j < n_count; j++) eval(j); 
+			}
+		}
+		else{
+			std::string reason = "Error: void fin_well::energy_eigenfunction_table(const double *position, int n_positions, int n_first, int n_count, double *psi) const\n"; 
+			if(!c1) reason += "Requested states must be in range of allowed values\n"; 
+			if(!c2) reason += "No positions to evaluate\n"; 
+			throw std::invalid_argument(reason); 
+		}
 
-		return ( Alpha(beta) + M_ratio*kval*tan(PI_2 - kval*Lhalf) ); 
 	}
 	catch(std::invalid_argument &e){
 		std::cerr<<e.what();
-		return 0.0; 
 	}
 }
\ No newline at end of file
@@ -7,6 +7,20 @@
 // The natural scale for energy is eV, scale energies accordingly
 // The natural scale for length is nm, you can scale lengths accordingly
 
+// Once set_well_params has run nothing else modifies the object, the evaluation methods are all const,
+// so one fin_well can be read from any number of threads at the same time
+
+// Non-parabolic mode: with set_nonparabolicity the effective masses follow the Kane form
+// m_well(E) = m_well (1 + E / Eg_well), m_barr(E) = m_barr (1 + (E - V) / Eg_barr), E measured from the bottom of the well
+// and the boundary conditions are continuity of psi and psi' / m(E)
+// k L / 2 = theta still fixes E through E (1 + E / Eg_well) = hbar^{2} k^{2} / 2 m_well, so E(theta) is explicit and increasing
+// and the eigenequations keep the form a cos(theta) - r theta sin(theta), a sin(theta) + r theta cos(theta), now with a = alpha L / 2 and 
+// r = m_barr(E) / m_well(E) both functions of theta, as a and r are positive the sign change on every [n pi / 2, (n + 1) pi / 2] remains 
+// and the same exact brackets are used, no scan for roots is needed
+// Cost model: a parabolic eigenequation call is one sqrt and a sin, cos pair, a non-parabolic call adds two sqrt and two divisions 
+// for E(theta), alpha(E) and r(E), the bracket count and the number of Brent or Newton steps per level are unchanged, 
+// so a non-parabolic solve costs the parabolic one times the ratio of call costs, measured at about 1.7 by testing::finite_well_nonparabolic
+
 class fin_well{
 public:
 	fin_well(); 
@@ -15,37 +29,92 @@ public:
 
 	void set_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position = 0.0); 
 
-	double energy_eigenvalue(int n); // return the energy associated with the n^{th} energy level
+	// move to the next point of a sweep in width, depth or mass, the levels of the current and previous points seed the root search
+	// the n^{th} level keeps index n along the sweep, levels appear at the top of the well when it deepens or widens
+	// the return value is the change in the number of bound states, positive when new levels have appeared at the barrier top
+	int continue_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position = 0.0); 
+
+	// Kane band gaps of the well and barrier materials in eV, used from the next call to set_well_params or continue_well_params
+	// gaps <= 0 return the solver to constant masses, the barrier gap must exceed the barrier height so that m_barr(E) stays positive
+	void set_nonparabolicity(double gap_well, double gap_barrier); 
+
+	double energy_eigenvalue(int n) const; // return the energy associated with the n^{th} energy level
+
+	double energy_eigenfunction(int n, double position) const; // return the value of the normalised wavefunction at some position
+
+	// normalised n^{th} wavefunction at the positions position[0..n_positions-1], written to psi[0..n_positions-1]
+	void energy_eigenfunction(int n, const double *position, int n_positions, double *psi) const; 
 
-	double energy_eigenfunction(int n, double position); // return the value of the normalised wavefunction at some position inside the well
+	// states n_first..n_first+n_count-1 at the positions position[0..n_positions-1]
+	// psi is state-major, psi[j * n_positions + i] is state n_first + j at position[i]
+	// positions are sorted into the well and barriers once and shared by every state
+	void energy_eigenfunction_table(const double *position, int n_positions, int n_first, int n_count, double *psi) const; 
+
+	// getters
+	inline int get_n_states() const { return n_states; }
+	inline int get_root_calls() const { return root_calls; } // eigenequation evaluations made by the last solve
+
+	static const int PARALLEL_MIN_STATES = 256; // wells with fewer bound states than this are solved on the calling thread
+
+	static const int PARALLEL_MIN_POINTS = 65536; // eigenfunction tables with fewer entries than this are evaluated on the calling thread
 
 private:
-	double energy_eigenequation(double beta, bool state);
+	// the eigenequations are functions of theta = k L / 2 and are called inside the root search, they do not throw and return NaN for theta > theta_max
+	// energy_eigenequation and eigenequation_derivative pass to the non-parabolic forms when that mode is set
+	double energy_eigenequation(double theta, bool state) const noexcept;
+
+	double even_eigenequation(double theta) const noexcept;
 
-	double even_eigenequation(double beta);
+	double odd_eigenequation(double theta) const noexcept; 
 
-	double odd_eigenequation(double beta); 
+	double nonparabolic_eigenequation(double theta, bool state) const noexcept; 
 
-	double K(double beta); 
+	double theta_energy(double theta) const noexcept; 
 
-	double Alpha(double beta); 
+	double K(double beta) const noexcept; 
+
+	double Alpha(double beta) const noexcept; 
+
+	void eigenequation_derivative(double theta, bool state, double &f, double &df) const noexcept; 
+
+	void assign_well_params(double length, double mass_well, double mass_barrier, double barrier_height, double centre_position); 
 
 	void solve_energy_eigenequation(); 
 
+	void continue_energy_eigenequation(double theta_max_curr); 
+
+	void store_state(int n, double theta); 
+
 private:
 	int n_states; // num. of bound states in the well
 
 	double L; // length of the well expressed in nm
 	double Lhalf; // half the length of the well expressed in nm
-	double M_well; // mass of the particle in the well expressed as a multiple of electron mass, which is in kg
-	double M_barr; // mass of the particle in the well expressed as a multiple of electron mass, which is in kg
+	double M_well; // mass of the particle in the well expressed in kg
+	double M_barr; // mass of the particle in the barrier expressed in kg
 	double M_ratio; // ratio of mass in barrier to mass in well
-	double A; // wavefunction normalisation constant
 	double x_c; // position of the centre of the well expressed in nm
 	double well_depth; // height of energy barrier expressed in eV
-	double E_range; // range over which energies are sought expressed in eV
+	double theta_max; // k L / 2 for a particle with energy equal to the well depth
+
+	bool nonparabolic; // true when the masses depend on energy
+	double inv_gap_well; // 1 / Eg_well in eV^{-1}, zero for a constant mass
+	double inv_gap_barr; // 1 / Eg_barr in eV^{-1}, zero for a constant mass
+	double theta_energy_const; // hbar^{2} / (2 m_well (L / 2)^{2}) in eV, E (1 + E / Eg_well) = theta_energy_const theta^{2}
+
+	int root_calls; // eigenequation evaluations made by the last solve
+
+	std::vector<double> energy_levels; // bound state energies expressed in eV, in increasing order
+
+	// history used by continue_well_params, u = theta / theta_max of each level at the current and the previous point of a sweep
+	std::vector<double> u_curr, u_prev; 
+	double theta_max_prev; // theta_max at the previous point of the sweep, zero if there is none
 
-	std::vector<double> energy_levels;  
+	// per state constants of the eigenfunctions, computed once by solve_energy_eigenequation
+	std::vector<double> state_k; // wavenumber in the well expressed in nm^{-1}
+	std::vector<double> state_alpha; // decay constant in the barrier expressed in nm^{-1}
+	std::vector<double> state_norm; // normalisation constant N of N cos(k x) or N sin(k x)
+	std::vector<double> state_wall; // value of the normalised wavefunction at the wall x = +L / 2
 }; 
 
 #endif
\ No newline at end of file
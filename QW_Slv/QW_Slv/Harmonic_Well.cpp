@@ -0,0 +1,279 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods declared in Harmonic_Well.h
+
+namespace {
+
+	const double HERMITE_BIG = 1.157920892373162e77; // 2^{256}, mantissas are scaled down once they pass this
+	const double HERMITE_SMALL = 8.636168555094445e-78; // 2^{-256}
+	const int HERMITE_SHIFT = 256;
+
+	void hermite_start(double xi, double amplitude, double &mantissa, int &K)
+	{
+		// amplitude pi^{-1/4} exp(-xi^{2} / 2) written as mantissa 2^{K} with mantissa in [1, 2), no under / overflow for any xi
+
+		double t = ( log(amplitude) - 0.25 * log(PI) - 0.5 * xi * xi ) / log(2.0);
+		double k = floor(t);
+
+		mantissa = exp2(t - k);
+		K = static_cast<int>(k);
+	}
+
+	// phi_n(xi) times amplitude, n = 0..n_levels-1, for a block of positions
+	// c1[n] = sqrt(2 / (n + 1)), c2[n] = sqrt(n / (n + 1)) are shared by every position of the block
+	// scale[j] = 2^{K_j} is only recomputed when the mantissas of position j are scaled down, an exact power of two or zero
+	// with AVX2 enabled an n-major block advances four positions per instruction, the x-major layout uses the plain loop
+	void hermite_table_block(const double *xi, int n_block, int n_levels, double amplitude, const double *c1, const double *c2, double *psi, size_t level_stride, size_t position_stride)
+	{
+		double p[harm_well::TABLE_BLOCK], p_prev[harm_well::TABLE_BLOCK], scale[harm_well::TABLE_BLOCK];
+		int K[harm_well::TABLE_BLOCK];
+
+		for (int j = 0; j < n_block; j++) {
+			hermite_start(xi[j], amplitude, p[j], K[j]);
+			p_prev[j] = 0.0;
+			scale[j] = ldexp(1.0, K[j]);
+			psi[j * position_stride] = p[j] * scale[j];
+		}
+
+		for (int n = 0; n + 1 < n_levels; n++) {
+			double *row = psi + (n + 1) * level_stride;
+			double a = c1[n], b = c2[n];
+
+			int over = 0, j = 0;
+
+#ifdef __AVX2__
+			if (position_stride == 1) {
+				__m256d va = _mm256_set1_pd(a), vb = _mm256_set1_pd(b), big = _mm256_set1_pd(HERMITE_BIG), sign = _mm256_set1_pd(-0.0);
+				__m256d flag = _mm256_setzero_pd();
+
+				for (; j + 4 <= n_block; j += 4) {
+					__m256d pc = _mm256_loadu_pd(p + j);
+					__m256d pn = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(va, _mm256_loadu_pd(xi + j)), pc), _mm256_mul_pd(vb, _mm256_loadu_pd(p_prev + j)));
+					_mm256_storeu_pd(p_prev + j, pc);
+					_mm256_storeu_pd(p + j, pn);
+					_mm256_storeu_pd(row + j, _mm256_mul_pd(pn, _mm256_loadu_pd(scale + j)));
+					flag = _mm256_or_pd(flag, _mm256_cmp_pd(_mm256_andnot_pd(sign, pn), big, _CMP_GT_OQ));
+				}
+
+				over = _mm256_movemask_pd(flag);
+			}
+#endif
+
+			for (; j < n_block; j++) {
+				double pn = a * xi[j] * p[j] - b * p_prev[j];
+				p_prev[j] = p[j];
+				p[j] = pn;
+				row[j * position_stride] = pn * scale[j];
+				over |= (fabs(pn) > HERMITE_BIG);
+			}
+
+			if (over) {
+				// rare, so kept out of the loop above, which then has no branch and can be vectorised
+				for (j = 0; j < n_block; j++) {
+					if (fabs(p[j]) > HERMITE_BIG) {
+						p[j] *= HERMITE_SMALL;
+						p_prev[j] *= HERMITE_SMALL;
+						K[j] += HERMITE_SHIFT;
+						scale[j] = ldexp(1.0, K[j]);
+						row[j * position_stride] = p[j] * scale[j];
+					}
+				}
+			}
+		}
+	}
+}
+
+harm_well::harm_well()
+{
+	// Default constructor
+	M = hbar_omega_eV = x0 = x_c = 0.0;
+}
+
+harm_well::harm_well(double hbar_omega, double mass, double centre_position)
+{
+	// Constructor
+
+	set_well_params(hbar_omega, mass, centre_position);
+}
+
+void harm_well::set_well_params(double hbar_omega, double mass, double centre_position)
+{
+	try{
+
+		bool c1 = hbar_omega > 0.0 ? true : false;
+		bool c2 = mass > 0.0 ? true : false;
+
+		if(c1 && c2){
+
+			M = mass;
+			hbar_omega_eV = hbar_omega;
+			x_c = centre_position;
+			x0 = 1.0e9 * H_BAR_J / sqrt(M * template_funcs::convert_ev_J(hbar_omega_eV)); // hbar / sqrt(m hbar omega) converted to nm
+		}
+		else{
+			std::string reason = "Error: void harm_well::set_well_params(double hbar_omega, double mass, double centre_position)\n";
+			if(!c1) reason += "hbar_omega is not positive\n";
+			if(!c2) reason += "mass is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void harm_well::set_graded_params(double length, double mass, double barrier_height, double centre_position)
+{
+	// m omega^{2} (L / 2)^{2} / 2 = V_0 gives omega = sqrt(8 V_0 / m L^{2})
+
+	try{
+
+		bool c1 = length > 0.0 ? true : false;
+		bool c2 = mass > 0.0 ? true : false;
+		bool c3 = barrier_height > 0.0 ? true : false;
+
+		if(c1 && c2 && c3){
+			double omega = sqrt( 8.0 * template_funcs::convert_ev_J(barrier_height) / mass ) / (length * 1.0e-9);
+
+			set_well_params(H_BAR_J * omega / template_funcs::convert_ev_J(1.0), mass, centre_position);
+		}
+		else{
+			std::string reason = "Error: void harm_well::set_graded_params(double length, double mass, double barrier_height, double centre_position)\n";
+			if(!c1) reason += "length is not positive\n";
+			if(!c2) reason += "mass is not positive\n";
+			if(!c3) reason += "barrier height is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double harm_well::energy_eigenvalue(int n) const
+{
+	// return the n^{th} energy eigenvalue in units of eV
+
+	try{
+
+		if(n > -1){
+			return ( hbar_omega_eV * (n + 0.5) );
+		}
+		else{
+			std::string reason = "Error: double harm_well::energy_eigenvalue(int n) const\n";
+			reason += "Value of n must not be negative\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+double harm_well::energy_eigenfunction(int n, double position) const
+{
+	// compute the value of the n^{th} energy eigenfunction by running the recurrence up to n
+	// position length scale is in nano-metres
+
+	try{
+
+		if(n > -1){
+			double xi = (position - x_c) / x0, p, p_prev = 0.0;
+			int K;
+
+			hermite_start(xi, 1.0 / sqrt(x0), p, K);
+
+			for (int k = 0; k < n; k++) {
+				double pn = sqrt(2.0 / (k + 1.0)) * xi * p - sqrt(k / (k + 1.0)) * p_prev;
+				p_prev = p;
+				p = pn;
+
+				if (fabs(p) > HERMITE_BIG) {
+					p *= HERMITE_SMALL;
+					p_prev *= HERMITE_SMALL;
+					K += HERMITE_SHIFT;
+				}
+			}
+
+			return ldexp(p, K);
+		}
+		else{
+			std::string reason = "Error: double harm_well::energy_eigenfunction(int n, double position) const\n";
+			reason += "Value of n must not be negative\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+void harm_well::energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies, bool n_major) const
+{
+	// evaluate levels n = 0..n_levels-1 at the positions position[0..n_positions-1], position in units of nm
+	// the recurrence coefficients are computed once and shared by every block
+	// positions are processed in blocks of TABLE_BLOCK, blocks of a large table are shared out between threads
+	// with n_major = false a block is a few positions wide so that each position writes to a short run of contiguous levels
+
+	try{
+
+		bool c1 = n_levels > 0 ? true : false;
+		bool c2 = n_positions > 0 && position != nullptr && psi != nullptr ? true : false;
+
+		if(c1 && c2){
+			if (energies != nullptr) {
+				for (int n = 0; n < n_levels; n++) energies[n] = hbar_omega_eV * (n + 0.5);
+			}
+
+			std::vector<double> a(n_levels), b(n_levels);
+			for (int n = 0; n < n_levels; n++) {
+				a[n] = sqrt(2.0 / (n + 1.0));
+				b[n] = sqrt(n / (n + 1.0));
+			}
+
+			int block = n_major ? TABLE_BLOCK : TABLE_BLOCK_X;
+			int n_blocks = (n_positions + block - 1) / block;
+
+			size_t level_stride = n_major ? static_cast<size_t>(n_positions) : 1;
+			size_t position_stride = n_major ? 1 : static_cast<size_t>(n_levels);
+
+			double amplitude = 1.0 / sqrt(x0);
+
+			auto eval = [&](int blk) {
+				double xi[TABLE_BLOCK];
+				int start = blk * block, n_block = std::min(block, n_positions - start);
+
+				for (int j = 0; j < n_block; j++) xi[j] = (position[start + j] - x_c) / x0;
+
+				hermite_table_block(xi, n_block, n_levels, amplitude, a.data(), b.data(), psi + start * position_stride, level_stride, position_stride);
+			};
+
+			if (static_cast<double>(n_levels) * n_positions >= PARALLEL_MIN_POINTS) {
+				parallel_funcs::parallel_for(n_blocks, eval);
+			}
+			else {
+				for (int blk = 0; blk < n_blocks; blk++) eval(blk);
+			}
+		}
+		else{
+			std::string reason = "Error: void harm_well::energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies, bool n_major) const\n";
+			if(!c1) reason += "Number of levels must be greater than zero\n";
+			if(!c2) reason += "No positions to evaluate\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
+}
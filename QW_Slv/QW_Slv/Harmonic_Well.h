@@ -0,0 +1,61 @@
+#ifndef HARMONIC_WELL_H
+#define HARMONIC_WELL_H
+
+// Implementation of a class that computes the solution of a harmonic oscillator well V(x) = m omega^{2} (x - x_c)^{2} / 2
+// The levels are E_n = hbar omega (n + 1/2), n = 0, 1, 2, ..., and the eigenfunctions are the Hermite functions
+// psi_n(x) = phi_n(xi) / sqrt(x_0), xi = (x - x_c) / x_0, x_0 = sqrt(hbar / m omega)
+// A graded well of width L whose potential reaches V_0 at x_c +/- L / 2 has hbar omega = hbar sqrt(8 V_0 / m L^{2})
+
+// The eigenfunctions come from the normalised recurrence phi_{n+1} = sqrt(2 / (n + 1)) xi phi_n - sqrt(n / (n + 1)) phi_{n-1},
+// phi_0 = pi^{-1/4} exp(-xi^{2} / 2), which never forms H_n(xi) or a separate Gaussian, both of which overflow or underflow for large n
+// phi_0 itself underflows for |xi| > 38 while phi_n for n in the thousands is still large out to |xi| ~ sqrt(2 n + 1), so each position
+// carries its values as a mantissa times an exact power of two 2^{K}, the mantissas are scaled down by 2^{-256} whenever they pass 2^{256}
+// and K absorbs the scaling, the output is mantissa * 2^{K}, which is zero until the true value is representable
+// In the oscillatory region the recurrence is stable and in the forbidden region phi_n is the growing solution,
+// so the error grows slowly with n and xi, testing::harmonic_well checks orthonormality for n in the thousands
+
+// All of the set up is done by set_well_params and every evaluation method is const and free of side effects
+// so a constructed harm_well is an immutable value that can be copied cheaply and shared read-only between threads
+
+class harm_well{
+
+public:
+	harm_well();
+
+	harm_well(double hbar_omega, double mass, double centre_position = 0.0);
+
+	// hbar_omega is the level spacing expressed in eV
+	void set_well_params(double hbar_omega, double mass, double centre_position = 0.0);
+
+	// parabolic well of width length in nm whose potential reaches barrier_height in eV at its edges
+	void set_graded_params(double length, double mass, double barrier_height, double centre_position = 0.0);
+
+	double energy_eigenvalue(int n) const; // return the energy associated with the n^{th} energy level, n counted from 0
+
+	double energy_eigenfunction(int n, double position) const; // value of the normalised n^{th} wavefunction at position, costs O(n)
+
+	// levels n = 0..n_levels-1 at the positions position[0..n_positions-1], every level of a position comes from one pass of the recurrence
+	// n_major = true: psi[n * n_positions + i], one row per level
+	// n_major = false: psi[i * n_levels + n], one row per position
+	// energies, if not null, receives E_0..E_{n_levels-1} in units of eV
+	void energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies = nullptr, bool n_major = true) const;
+
+	// getters
+	inline double get_hbar_omega() const { return hbar_omega_eV; }
+	inline double get_x0() const { return x0; }
+	inline double get_centre() const { return x_c; }
+
+	static const int PARALLEL_MIN_POINTS = 65536; // eigenfunction tables with fewer entries than this are evaluated on the calling thread
+
+	static const int TABLE_BLOCK = 256; // positions per block of an n-major table, the recurrence state of a block stays in L1 cache
+
+	static const int TABLE_BLOCK_X = 8; // positions per block of an x-major table
+
+private:
+	double M; // mass of the particle in the well expressed in kg
+	double hbar_omega_eV; // level spacing expressed in eV
+	double x0; // oscillator length sqrt(hbar / m omega) expressed in nm
+	double x_c; // position of the centre of the well
+};
+
+#endif
@@ -31,8 +31,8 @@ void inf_well::set_well_params(double length, double mass, double centre_positio
 			A = sqrt(2.0/L); // normalistion constant for energy eigenfunctions, it can be any complex number whose absolute value is sqrt(2.0/L)
 			M = mass; 
 			x_c = centre_position; 
-			bndry = x_c + Lhalf; 
-			En_const = template_funcs::DSQR(PLANCK_CONST_eV) / (8.0 * M * template_funcs::DSQR(L) ); // h^{2} / 8 m L^{2}
+			bndry = x_c - Lhalf; 
+			En_const = template_funcs::DSQR(PI * H_BAR_J / (L * 1.0e-9)) / (2.0 * M * template_funcs::convert_ev_J(1.0)); // h^{2} / 8 m L^{2} with L converted to m, same eV to J factor as the other wells
 			kn_const = PI / L; // \pi / L
 		}
 		else{
@@ -49,7 +49,7 @@ void inf_well::set_well_params(double length, double mass, double centre_positio
 	}
 }
 
-double inf_well::energy_eigenvalue(int n)
+double inf_well::energy_eigenvalue(int n) const
 {
 	// return the n^{th} energy eigenvalue in units of eV
 
@@ -59,7 +59,7 @@ double inf_well::energy_eigenvalue(int n)
 			return (template_funcs::DSQR(n) * En_const); // n^{2} h^{2} / 8 m L^{2}
 		}
 		else{
-			std::string reason = "Error: double inf_well::energy_eigenvalue(int n)\n"; 
+			std::string reason = "Error: double inf_well::energy_eigenvalue(int n) const\n"; 
 			reason += "Value of n must be greater than zero\n"; 
 			throw std::invalid_argument(reason); 
 		}
@@ -71,7 +71,7 @@ double inf_well::energy_eigenvalue(int n)
 	}
 }
 
-double inf_well::energy_eigenfunction(int n, double position)
+double inf_well::energy_eigenfunction(int n, double position) const
 {
 	// compute the value of the n^{th} energy eigenfunction
 	// position length scale is in nano-metres
@@ -79,14 +79,14 @@ double inf_well::energy_eigenfunction(int n, double position)
 	try{
 	
 		bool c1 = n > 0 ? true : false; 
-		bool c2 = fabs(position) < bndry ? true : false; 
+		bool c2 = fabs(position - x_c) < Lhalf ? true : false; 
 
 		if(c1 && c2){
 			double arg = n * kn_const * (position - bndry); // ( n \pi / L ) * ( x - x_{c} + L/2 )
 			return A * sin( arg ); 
 		}
 		else{
-			std::string reason = "Error: double inf_well::energy_eigenfunction(int n, double position)\n"; 
+			std::string reason = "Error: double inf_well::energy_eigenfunction(int n, double position) const\n"; 
 			if(!c1) reason += "Value of n must be greater than zero\n"; 
 			if(!c2) reason += "Position must be located inside the well\n"; 
 			throw std::invalid_argument(reason); 
@@ -97,4 +97,97 @@ double inf_well::energy_eigenfunction(int n, double position)
 		std::cerr<<e.what();
 		return 0.0; 
 	}
+}
+
+namespace {
+
+	// sin(n theta), n = 1..n_levels, for a block of positions by Reinsch's form of the recurrence s_{n+1} = 2 cos(theta) s_{n} - s_{n-1}
+	// the plain three-term recurrence loses accuracy like n eps / sin(theta) near theta = 0 and pi, i.e. near the walls of the well
+	// Reinsch carries s_{n} together with d_{n} = s_{n+1} - sigma s_{n}, sigma = sign(cos(theta)), and updates
+	// s_{n+1} = d_{n} + sigma s_{n}, d_{n+1} = sigma (d_{n} - lambda s_{n+1})
+	// lambda = 4 sin^{2}(theta / 2) for sigma = 1 and 4 cos^{2}(theta / 2) for sigma = -1, which is small exactly where the plain form is unstable
+	// starting from s_{0} = 0, d_{0} = sin(theta) the error grows like n eps rather than n eps / sin(theta)
+	// only n_levels sin, cos pairs per position are replaced by 4 flops per entry
+	void sine_table_block(const double *theta, const bool *inside, int n_block, int n_levels, double amplitude, double *psi, size_t level_stride, size_t position_stride)
+	{
+		double s[inf_well::TABLE_BLOCK], d[inf_well::TABLE_BLOCK], sigma[inf_well::TABLE_BLOCK], lambda[inf_well::TABLE_BLOCK]; 
+
+		for (int j = 0; j < n_block; j++) {
+			double half = 0.5 * theta[j]; 
+			bool up = cos(theta[j]) >= 0.0; 
+			double t = up ? sin(half) : cos(half); 
+
+			s[j] = 0.0; 
+			d[j] = inside[j] ? amplitude * sin(theta[j]) : 0.0; // positions outside the well stay zero for every level
+			sigma[j] = up ? 1.0 : -1.0; 
+			lambda[j] = 4.0 * t * t; 
+		}
+
+		for (int n = 0; n < n_levels; n++) {
+			double *row = psi + n * level_stride; 
+
+			for (int j = 0; j < n_block; j++) {
+				double sn = d[j] + sigma[j] * s[j]; 
+				d[j] = sigma[j] * (d[j] - lambda[j] * sn); 
+				s[j] = sn; 
+				row[j * position_stride] = sn; 
+			}
+		}
+	}
+}
+
+void inf_well::energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies, bool n_major) const
+{
+	// evaluate levels n = 1..n_levels at the positions position[0..n_positions-1], position in units of nm
+	// psi_{n}(x) = A sin( n theta ), theta = ( \pi / L ) ( x - x_{c} + L/2 ), is generated for every n from one sin, cos pair per position
+	// positions are processed in blocks of TABLE_BLOCK, blocks of a large table are shared out between threads
+	// with n_major = false a block is a few positions wide so that each position writes to a short run of contiguous levels
+
+	try{
+	
+		bool c1 = n_levels > 0 ? true : false; 
+		bool c2 = n_positions > 0 && position != nullptr && psi != nullptr ? true : false; 
+
+		if(c1 && c2){
+			if (energies != nullptr) {
+				for (int n = 1; n <= n_levels; n++) energies[n - 1] = template_funcs::DSQR(n) * En_const; 
+			}
+
+			int block = n_major ? TABLE_BLOCK : TABLE_BLOCK_X; 
+			int n_blocks = (n_positions + block - 1) / block; 
+
+			size_t level_stride = n_major ? static_cast<size_t>(n_positions) : 1; 
+			size_t position_stride = n_major ? 1 : static_cast<size_t>(n_levels); 
+
+			auto eval = [&](int b) {
+				double theta[TABLE_BLOCK]; 
+				bool inside[TABLE_BLOCK]; 
+				int start = b * block, n_block = std::min(block, n_positions - start); 
+
+				for (int j = 0; j < n_block; j++) {
+					inside[j] = fabs(position[start + j] - x_c) < Lhalf; 
+					theta[j] = inside[j] ? kn_const * (position[start + j] - bndry) : 0.0; 
+				}
+
+				sine_table_block(theta, inside, n_block, n_levels, A, psi + start * position_stride, level_stride, position_stride); 
+			}; 
+
+			if (static_cast<double>(n_levels) * n_positions >= PARALLEL_MIN_POINTS) {
+				parallel_funcs::parallel_for(n_blocks, eval); 
+			}
+			else {
+				for (int b = 0; b < n_blocks; b++) eval(b); 
+			}
+		}
+		else{
+			std::string reason = "Error: void inf_well::energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies, bool n_major) const\n"; 
+			if(!c1) reason += "Number of levels must be greater than zero\n"; 
+			if(!c2) reason += "No positions to evaluate\n"; 
+			throw std::invalid_argument(reason); 
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 // For calculation details see Bransden and Joachain.
 // R. Sheehan 24 - 10 - 2016
 
+// All of the set up is done by set_well_params and every evaluation method is const and free of side effects
+// so a constructed inf_well is an immutable value that can be copied cheaply and shared read-only between threads
+
 class inf_well{
 
 public: 
@@ -14,19 +17,35 @@ public:
 
 	void set_well_params(double length, double mass, double centre_position = 0.0); 
 
-	double energy_eigenvalue(int n); // return the energy associated with the n^{th} energy level
+	double energy_eigenvalue(int n) const; // return the energy associated with the n^{th} energy level
+
+	double energy_eigenfunction(int n, double position) const; // return the value of the normalised wavefunction at some position inside the well
+
+	// levels n = 1..n_levels at the positions position[0..n_positions-1], positions outside the well give zero
+	// n_major = true: psi[(n-1) * n_positions + i], one row per level
+	// n_major = false: psi[i * n_levels + (n-1)], one row per position
+	// energies, if not null, receives E_1..E_{n_levels} in units of eV
+	void energy_eigenfunction_table(const double *position, int n_positions, int n_levels, double *psi, double *energies = nullptr, bool n_major = true) const; 
+
+	// getters
+	inline double get_L() const { return L; }
+	inline double get_centre() const { return x_c; }
+
+	static const int PARALLEL_MIN_POINTS = 65536; // eigenfunction tables with fewer entries than this are evaluated on the calling thread
+
+	static const int TABLE_BLOCK = 256; // positions per block of an n-major table, the recurrence state of a block stays in L1 cache
 
-	double energy_eigenfunction(int n, double position); // return the value of the normalised wavefunction at some position inside the well
+	static const int TABLE_BLOCK_X = 8; // positions per block of an x-major table
 
 private:
-	double L; // length of the well
-	double Lhalf; // half the length of the well
-	double M; // mass of the particle in the well
+	double L; // length of the well expressed in nm
+	double Lhalf; // half the length of the well expressed in nm
+	double M; // mass of the particle in the well expressed in kg
 	double A; // wavefunction normalisation constant
 	double x_c; // position of the centre of the well
-	double En_const; // Constant associated with energy eigenvalues
+	double En_const; // Constant associated with energy eigenvalues, E_n = n^{2} En_const in units of eV
 	double kn_const; // Constant associated with energy eigenfunctions
-	double bndry; // position of the well boundary
+	double bndry; // position of the left hand boundary of the well
 }; 
 
 #endif
\ No newline at end of file
@@ -14,8 +14,58 @@ int main(int argc, char* argv[])
 
 	testing::potential_barrier(); 
 
+	//testing::energy_sweep(); 
+
+	//testing::wavefunction_batch(); 
+
+	//testing::wavefunction_grid(); 
+
+	//testing::multi_layer_stack(); 
+
+	//testing::shared_solution(); 
+
+	//testing::status_path(); 
+
+	//testing::structure_split(); 
+
+	//testing::adaptive_sampling(); 
+
+	//testing::density_map(); 
+
+	//testing::problem_batch(); 
+
 	//testing::infinite_well(); 
 
+	//testing::infinite_well_table(); 
+
+	//testing::well_evolution(); 
+
+	//testing::harmonic_well(); 
+
+	//testing::separable_box(); 
+
+	//testing::finite_well(); 
+
+	//testing::finite_well_continuation(); 
+
+	//testing::finite_well_nonparabolic(); 
+
+	//testing::finite_well_eigenfunctions(); 
+
+	//testing::cylindrical_wire(); 
+
+	//testing::spherical_dot(); 
+
+	//testing::finite_difference_well(); 
+
+	//testing::numerov_shooting(); 
+
+	//testing::chebyshev_collocation(); 
+
+	//testing::triangular_well(); 
+
+	//testing::biased_barrier(); 
+
 	std::cout<<"Press enter to close\n"; 
 	std::cin.get(); 
 
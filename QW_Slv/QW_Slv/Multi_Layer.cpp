@@ -0,0 +1,210 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the methods of the multi_layer class
+// Amplitudes are referenced to the near edge of each medium so that every propagation factor has modulus <= 1
+// For a section with scattering matrix S, incoming amplitudes a (from the left) and d (from the right) give outgoing amplitudes
+// b = R11 a + T12 d to the left and c = T21 a + R22 d to the right
+
+multi_layer::multi_layer()
+{
+	// Default constructor
+
+	params_defined = false; 
+}
+
+multi_layer::multi_layer(double mass_left, double height_left, double mass_right, double height_right, const std::vector<layer> &layers)
+{
+	// Primary constructor
+
+	set_params(mass_left, height_left, mass_right, height_right, layers); 
+}
+
+void multi_layer::set_params(double mass_left, double height_left, double mass_right, double height_right, const std::vector<layer> &layers)
+{
+	// assign the structure
+	// mass_left, height_left describe the lead the particle is incident from, mass_right, height_right the lead it is transmitted into
+	// layers are listed in order from left to right, an empty list describes a single step between the leads
+
+	try {
+		bool c1 = mass_left > 0.0 && mass_right > 0.0 ? true : false;
+		bool c2 = true, c3 = true; 
+
+		for (size_t j = 0; j < layers.size(); j++) {
+			if (!(layers[j].width > 0.0)) c2 = false; 
+			if (!(layers[j].mass > 0.0)) c3 = false; 
+		}
+
+		if (c1 && c2 && c3) {
+			int N = static_cast<int>(layers.size()); 
+
+			width.resize(N); 
+			height.resize(N + 2); 
+			mass.resize(N + 2); 
+			k_scale.resize(N + 2); 
+
+			height[0] = height_left; mass[0] = mass_left; 
+			height[N + 1] = height_right; mass[N + 1] = mass_right; 
+
+			for (int j = 0; j < N; j++) {
+				width[j] = layers[j].width; 
+				height[j + 1] = layers[j].height; 
+				mass[j + 1] = layers[j].mass; 
+			}
+
+			for (int j = 0; j < N + 2; j++) {
+				k_scale[j] = ( sqrt(2.0 * mass[j] * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J; 
+			}
+
+			params_defined = true; 
+		}
+		else {
+			std::string reason = "Error: void multi_layer::set_params(double mass_left, double height_left, double mass_right, double height_right, const std::vector<layer> &layers)\n";
+			if (!c1) reason += "lead mass is not positive\n";
+			if (!c2) reason += "layer width is not positive\n";
+			if (!c3) reason += "layer mass is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void multi_layer::check_energy(double particle_energy, std::string caller) const
+{
+	// the particle must be able to propagate in the left lead for the scattering problem to be defined
+
+	try {
+		if ( !params_defined || !(particle_energy > height[0]) ) {
+			std::string reason = "Error: " + caller + "\n";
+			if (!params_defined) reason += "No parameters defined for multi_layer class\n";
+			else reason += "particle_energy is not above the potential of the left lead\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double multi_layer::off_threshold(double particle_energy) const
+{
+	// energy at which to build the scattering matrices
+	// a layer with particle_energy equal to its potential has q = 0, exp(+/- i q x) are then the same function and the linear solution is lost
+	// two such media side by side give 0/0 in the interface coefficients, a single one blocks the layer completely
+	// T and R are smooth in the energy there, so the energy is raised off the layer potential by a small fraction of the kinetic energy in the left lead
+	// a right lead at q = 0 needs no shift, it carries no current and T = 0 is the correct limit
+
+	static const double nudge = 1.0e-9; 
+
+	double delta = nudge * (particle_energy - height[0]); 
+
+	for (int j = 1; j <= get_n_layers(); j++) {
+		if (fabs(particle_energy - height[j]) < delta) return height[j] + delta; 
+	}
+
+	return particle_energy; 
+}
+
+std::complex<double> multi_layer::wavenumber(int j, double particle_energy) const
+{
+	// wavenumber in medium j in units of nm^{-1}
+	// the principal square root gives Im(q) >= 0, for E < V this is q = i kappa so that exp(i q x) decays to the right
+
+	return ( k_scale[j] * sqrt( std::complex<double>(particle_energy - height[j], 0.0) ) ); 
+}
+
+void multi_layer::amplitudes(double particle_energy, std::complex<double> &r, std::complex<double> &t) const
+{
+	// reflection and transmission amplitudes for a unit wave incident from the left lead
+	// the scattering matrix of the stack is built up from the left one interface and one layer at a time
+
+	check_energy(particle_energy, "void multi_layer::amplitudes(double particle_energy, std::complex<double> &r, std::complex<double> &t)"); 
+
+	int N = get_n_layers(); 
+	double E = off_threshold(particle_energy); 
+
+	// scattering matrix of the part of the stack already processed, initially empty
+	std::complex<double> R11 = zero, T12 = one, T21 = one, R22 = zero; 
+	std::complex<double> q_a, q_b, beta_a, beta_b, ri, ti, ri_p, ti_p, denom, P; 
+
+	q_a = wavenumber(0, E); 
+	beta_a = q_a / mass[0]; 
+
+	for (int j = 1; j <= N + 1; j++) {
+		// interface between medium j-1 and medium j
+		q_b = wavenumber(j, E); 
+		beta_b = q_b / mass[j]; 
+
+		ri = (beta_a - beta_b) / (beta_a + beta_b); 
+		ti = (2.0 * beta_a) / (beta_a + beta_b); 
+		ri_p = -ri; 
+		ti_p = (2.0 * beta_b) / (beta_a + beta_b); 
+
+		denom = one - R22 * ri; 
+		R11 = R11 + (T12 * ri * T21) / denom; 
+		T12 = (T12 * ti_p) / denom; 
+		R22 = ri_p + (ti * R22 * ti_p) / denom; 
+		T21 = (ti * T21) / denom; 
+
+		// propagation across layer j, absent for the right lead
+		if (j <= N) {
+			P = exp(eye * q_b * width[j - 1]); 
+
+			T21 *= P; 
+			T12 *= P; 
+			R22 *= (P * P); 
+		}
+
+		q_a = q_b; 
+		beta_a = beta_b; 
+	}
+
+	r = R11; 
+	t = T21; 
+}
+
+void multi_layer::probabilities(double particle_energy, double &T, double &R) const
+{
+	// transmission and reflection probabilities
+	// probability current in a medium is proportional to Re(q / m) |amplitude|^{2}, there is no current in an evanescent lead
+	// the currents are taken at the energy the amplitudes were built at, see off_threshold
+
+	std::complex<double> r, t; 
+
+	amplitudes(particle_energy, r, t); 
+
+	int N = get_n_layers(); 
+	double E = off_threshold(particle_energy); 
+	
+	double beta_in = wavenumber(0, E).real() / mass[0]; 
+	double beta_out = wavenumber(N + 1, E).real() / mass[N + 1]; 
+
+	T = (beta_out / beta_in) * template_funcs::DSQR(abs(t)); 
+	R = template_funcs::DSQR(abs(r)); 
+}
+
+void multi_layer::energy_sweep(const double *particle_energy, int n_energies, double *T, double *R, int n_threads) const
+{
+	// compute T, R at each of the energies particle_energy[0..n_energies-1]
+	// energies are independent of one another and are shared out over n_threads threads, n_threads < 1 uses every core
+
+	try {
+		if (particle_energy != nullptr && T != nullptr && R != nullptr && n_energies > 0) {
+			parallel_funcs::parallel_for(n_energies, [&](int i) { probabilities(particle_energy[i], T[i], R[i]); }, n_threads); 
+		}
+		else {
+			std::string reason = "Error: void multi_layer::energy_sweep(const double *particle_energy, int n_energies, double *T, double *R, int n_threads) const\n";
+			reason += "No particle energies supplied\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef MULTI_LAYER_H
+#define MULTI_LAYER_H
+
+// Transmission and reflection through an arbitrary piecewise-constant potential
+// The structure is a stack of layers, each with its own width, height and effective mass, between two semi-infinite leads
+// Interfaces are matched with continuity of psi and (1/m) dpsi/dx, so pot_step and pot_barr are reproduced as special cases
+// Layers are combined with scattering matrices (Redheffer star products) rather than transfer matrix products
+// Propagation factors are then always exp(i q d) with Im(q) >= 0, which cannot overflow however thick an evanescent layer is
+// Cost is O(number of layers) per energy
+// An energy equal to the potential of a layer is raised by 1e-9 of the kinetic energy in the left lead, which moves T and R by about as much
+// Energies in units of eV, lengths in units of nm, masses in units of kg
+
+struct layer {
+	double width; // layer width in units of nm
+	double height; // potential in the layer in units of eV
+	double mass; // effective mass in the layer in units of kg
+};
+
+class multi_layer {
+public:
+	multi_layer(); 
+	multi_layer(double mass_left, double height_left, double mass_right, double height_right, const std::vector<layer> &layers); 
+
+	void set_params(double mass_left, double height_left, double mass_right, double height_right, const std::vector<layer> &layers); 
+
+	void amplitudes(double particle_energy, std::complex<double> &r, std::complex<double> &t) const; 
+
+	void probabilities(double particle_energy, double &T, double &R) const; 
+
+	void energy_sweep(const double *particle_energy, int n_energies, double *T, double *R, int n_threads = 0) const; 
+
+	// getters
+	inline int get_n_layers() const { return static_cast<int>(width.size()); }
+
+private:
+	void check_energy(double particle_energy, std::string caller) const; 
+
+	double off_threshold(double particle_energy) const; 
+
+	std::complex<double> wavenumber(int j, double particle_energy) const; 
+
+private:
+	bool params_defined; // boolean to decide if parameters have been assigned to the class
+
+	// media are numbered 0 (left lead), 1..N (layers), N+1 (right lead)
+	std::vector<double> width; // width of each layer in units of nm, leads are not included
+	std::vector<double> height; // potential in each medium in units of eV
+	std::vector<double> mass; // effective mass in each medium in units of kg
+	std::vector<double> k_scale; // wavenumber in medium j in units of nm^{-1} is k_scale[j] * sqrt(E - height[j]) with E in eV
+};
+
+#endif
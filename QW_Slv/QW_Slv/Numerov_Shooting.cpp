@@ -0,0 +1,355 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the Numerov shooting class
+
+namespace {
+
+	const double NUMEROV_BIG = 1.0e150; // phi and D are scaled down by NUMEROV_SMALL once |phi| passes this
+	const double NUMEROV_SMALL = 1.0e-150;
+
+	const double DELTA_MAX = PI * PI / 192.0; // k^{2} h^{2} / 12 at k h = pi / 4, eight points per wavelength, the highest energy searched
+
+	const int MAX_BISECTIONS = 200; // node count bisections allowed to isolate a level
+}
+
+numerov_well::numerov_well()
+{
+	// Default constructor
+	x_start = h = M = c_h2 = V_min = V_max = 0.0;
+}
+
+numerov_well::numerov_well(double x_left, double x_right, const std::vector<double> &potential, double mass)
+{
+	// Constructor
+
+	set_profile(x_left, x_right, potential, mass);
+}
+
+void numerov_well::set_profile(double x_left, double x_right, const std::vector<double> &potential, double mass)
+{
+	// store the sampled potential and the constant c = 2 m h^{2} / 12 hbar^{2}
+
+	try{
+
+		bool c1 = x_right > x_left ? true : false;
+		bool c2 = potential.size() > 3 ? true : false;
+		bool c3 = mass > 0.0 ? true : false;
+
+		if(c1 && c2 && c3){
+			int N = static_cast<int>(potential.size()) - 1;
+
+			x_start = x_left;
+			h = (x_right - x_left) / N;
+			M = mass;
+			c_h2 = 2.0 * M * template_funcs::DSQR(h * 1.0e-9) * template_funcs::convert_ev_J(1.0) / (12.0 * H_BAR_J * H_BAR_J);
+
+			V_grid = potential;
+			V_min = *std::min_element(V_grid.begin(), V_grid.end());
+			V_max = *std::max_element(V_grid.begin(), V_grid.end());
+		}
+		else{
+			std::string reason = "Error: void numerov_well::set_profile(double x_left, double x_right, const std::vector<double> &potential, double mass)\n";
+			if(!c1) reason += "x_right must be greater than x_left\n";
+			if(!c2) reason += "potential must be sampled at four or more points\n";
+			if(!c3) reason += "mass is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void numerov_well::shoot_outward(double E, int last, double &phi_last, double &phi_next, double *phi, int *nodes) const
+{
+	// phi_0 = 0, phi_1 = 1, D = phi_{i+1} - phi_i, the sign of psi_i is that of phi_i / u_i
+
+	double phi_i = 1.0, D = 1.0;
+	int count = 0;
+	bool negative = false;
+
+	if (phi != nullptr) {
+		phi[0] = 0.0;
+		phi[1] = 1.0;
+	}
+
+	for (int i = 1; i <= last; i++) {
+		double delta = numerov_delta(E, i);
+
+		D -= 12.0 * delta / (1.0 + delta) * phi_i;
+
+		double phi_n = phi_i + D;
+
+		if (nodes != nullptr) {
+			bool neg = (phi_n < 0.0) != (1.0 + numerov_delta(E, i + 1) < 0.0);
+			if (neg != negative) count++;
+			negative = neg;
+		}
+
+		if (phi != nullptr) phi[i + 1] = phi_n;
+
+		if (i == last) {
+			phi_last = phi_i;
+			phi_next = phi_n;
+		}
+
+		phi_i = phi_n;
+
+		if (fabs(phi_i) > NUMEROV_BIG) {
+			phi_i *= NUMEROV_SMALL;
+			D *= NUMEROV_SMALL;
+			if (phi != nullptr) for (int j = 0; j <= i + 1; j++) phi[j] *= NUMEROV_SMALL;
+			if (i == last) {
+				phi_last *= NUMEROV_SMALL;
+				phi_next *= NUMEROV_SMALL;
+			}
+		}
+	}
+
+	if (nodes != nullptr) *nodes = count;
+}
+
+void numerov_well::shoot_inward(double E, int last, double &phi_last, double &phi_next, double *phi) const
+{
+	// phi_N = 0, phi_{N-1} = 1, D = phi_{i-1} - phi_i, phi_last = phi at x_last, phi_next = phi at x_{last+1}
+
+	int N = get_n_intervals();
+
+	double phi_i = 1.0, D = 1.0;
+
+	if (phi != nullptr) {
+		phi[N] = 0.0;
+		phi[N - 1] = 1.0;
+	}
+
+	phi_next = 0.0;
+	phi_last = 1.0;
+
+	for (int i = N - 1; i > last; i--) {
+		double delta = numerov_delta(E, i);
+
+		D -= 12.0 * delta / (1.0 + delta) * phi_i;
+
+		double phi_n = phi_i + D;
+
+		if (phi != nullptr) phi[i - 1] = phi_n;
+
+		phi_next = phi_i;
+		phi_last = phi_n;
+		phi_i = phi_n;
+
+		if (fabs(phi_i) > NUMEROV_BIG) {
+			phi_i *= NUMEROV_SMALL;
+			D *= NUMEROV_SMALL;
+			phi_last *= NUMEROV_SMALL;
+			phi_next *= NUMEROV_SMALL;
+			if (phi != nullptr) for (int j = i - 1; j <= N; j++) phi[j] *= NUMEROV_SMALL;
+		}
+	}
+}
+
+int numerov_well::count_levels(double E) const
+{
+	// number of sign changes of the outward solution on x_1..x_N
+
+	int nodes = 0;
+	double phi_last, phi_next;
+
+	shoot_outward(E, get_n_intervals() - 1, phi_last, phi_next, nullptr, &nodes);
+
+	return nodes;
+}
+
+int numerov_well::matching_point(double E) const
+{
+	// last grid point below E, the inward solution then only grows as it is integrated
+
+	int N = get_n_intervals(), m = N - 2;
+
+	while (m > 1 && !(V_grid[m] < E)) m--;
+
+	return ( m > 1 ? m : N / 2 );
+}
+
+double numerov_well::matching_function(double E, int m) const
+{
+	// W / (|L| |R|) with L = (phi^{L}_m, phi^{L}_{m+1}), R = (phi^{R}_m, phi^{R}_{m+1})
+
+	double L0, L1, R0, R1;
+
+	shoot_outward(E, m, L0, L1);
+	shoot_inward(E, m, R0, R1);
+
+	return ( (L0 * R1 - L1 * R0) / (sqrt(L0 * L0 + L1 * L1) * sqrt(R0 * R0 + R1 * R1)) );
+}
+
+void numerov_well::level_bracket(int n, double &E_lo, double &E_hi) const
+{
+	// every level lies above min(V), the upper end is raised until n + 1 levels lie below it, then the bracket is bisected
+	// until it holds level n alone, levels above V_min + DELTA_MAX / c would have fewer than eight points per wavelength
+
+	double E_cap = V_min + DELTA_MAX / c_h2;
+
+	E_lo = V_min;
+	E_hi = std::min(std::max(V_max, V_min + 1.0e-3 * (E_cap - V_min)), E_cap);
+
+	int c_lo = 0, c_hi = count_levels(E_hi);
+
+	while (c_hi <= n && E_hi < E_cap) {
+		E_lo = E_hi;
+		c_lo = c_hi;
+		E_hi = std::min(V_min + 2.0 * (E_hi - V_min), E_cap);
+		c_hi = count_levels(E_hi);
+	}
+
+	if (c_hi <= n) {
+		std::string reason = "Error: void numerov_well::level_bracket(int n, double &E_lo, double &E_hi) const\n";
+		reason += "Level " + template_funcs::toString(n) + " is not resolved by the grid, use more points\n";
+		throw std::invalid_argument(reason);
+	}
+
+	for (int it = 0; it < MAX_BISECTIONS && !(c_lo == n && c_hi == n + 1); it++) {
+		double E = 0.5 * (E_lo + E_hi);
+		int c = count_levels(E);
+
+		if (c > n) {
+			E_hi = E;
+			c_hi = c;
+		}
+		else {
+			E_lo = E;
+			c_lo = c;
+		}
+	}
+}
+
+double numerov_well::refine_level(int n, double E_lo, double E_hi) const
+{
+	// Brent's method on the matching function, which has a single simple root in the isolating bracket
+	// should rounding hide the sign change the node count bisection is carried on to full precision instead
+
+	int m = matching_point(0.5 * (E_lo + E_hi)), iter;
+
+	auto func = [this, m](double E) { return matching_function(E, m); };
+
+	double f_lo = func(E_lo), f_hi = func(E_hi);
+
+	if (f_lo * f_hi < 0.0) {
+		return root_funcs::brent(func, E_lo, E_hi, f_lo, f_hi, 1.0e-15 * std::max(fabs(E_lo), fabs(E_hi)), iter);
+	}
+
+	while (E_hi - E_lo > 2.0e-16 * std::max(fabs(E_lo), fabs(E_hi))) {
+		double E = 0.5 * (E_lo + E_hi);
+		if (E <= E_lo || E >= E_hi) break;
+		if (count_levels(E) > n) E_hi = E;
+		else E_lo = E;
+	}
+
+	return ( 0.5 * (E_lo + E_hi) );
+}
+
+double numerov_well::energy_eigenvalue(int n) const
+{
+	// return the energy of level n in units of eV
+
+	try{
+
+		if(n > -1 && get_n_intervals() > 2){
+			double E_lo, E_hi;
+
+			level_bracket(n, E_lo, E_hi);
+
+			return refine_level(n, E_lo, E_hi);
+		}
+		else{
+			std::string reason = "Error: double numerov_well::energy_eigenvalue(int n) const\n";
+			if(n < 0) reason += "Value of n must not be negative\n";
+			else reason += "No profile has been set\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+void numerov_well::energy_eigenvalues(int n_first, int n_count, double *energies) const
+{
+	// each level is an independent search, the levels are shared out between threads
+
+	try{
+
+		if(n_first > -1 && n_count > 0 && energies != nullptr){
+			auto solve_level = [this, n_first, energies](int j) { energies[j] = energy_eigenvalue(n_first + j); };
+
+			if (n_count >= PARALLEL_MIN_LEVELS) {
+				parallel_funcs::parallel_for(n_count, solve_level);
+			}
+			else {
+				for (int j = 0; j < n_count; j++) solve_level(j);
+			}
+		}
+		else{
+			std::string reason = "Error: void numerov_well::energy_eigenvalues(int n_first, int n_count, double *energies) const\n";
+			if(n_first < 0) reason += "Value of n_first must not be negative\n";
+			if(n_count < 1 || energies == nullptr) reason += "No levels requested\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
+}
+
+double numerov_well::energy_eigenfunction(int n, std::vector<double> &psi) const
+{
+	// the outward and inward solutions are joined at the matching point, scaled to agree at x_m and x_{m+1} in the least squares sense,
+	// psi_i = phi_i / u_i and the sum of psi^{2} h is one, the first value larger than 1e-3 of the maximum is positive
+
+	double E = energy_eigenvalue(n);
+
+	int N = get_n_intervals();
+
+	if (N < 3 || n < 0) {
+		psi.clear();
+		return E;
+	}
+
+	int m = matching_point(E);
+
+	std::vector<double> phi_r(N + 1);
+	double L0, L1, R0, R1;
+
+	psi.assign(N + 1, 0.0);
+
+	shoot_outward(E, m, L0, L1, psi.data());
+	shoot_inward(E, m, R0, R1, phi_r.data());
+
+	double scale = (L0 * R0 + L1 * R1) / (R0 * R0 + R1 * R1);
+
+	for (int i = m + 2; i <= N; i++) psi[i] = scale * phi_r[i];
+
+	double v_max = 0.0;
+	for (int i = 0; i <= N; i++) {
+		psi[i] /= 1.0 + numerov_delta(E, i);
+		v_max = std::max(v_max, fabs(psi[i]));
+	}
+
+	double norm = 0.0;
+	for (int i = 0; i <= N; i++) norm += template_funcs::DSQR(psi[i] / v_max);
+
+	int i = 0;
+	while (i <= N && fabs(psi[i]) <= 1.0e-3 * v_max) i++;
+
+	norm = ((i <= N && psi[i] < 0.0) ? -1.0 : 1.0) / (v_max * sqrt(norm * h));
+	for (i = 0; i <= N; i++) psi[i] *= norm;
+
+	return E;
+}
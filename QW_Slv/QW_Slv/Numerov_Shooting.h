@@ -0,0 +1,91 @@
+#ifndef NUMEROV_SHOOTING_H
+#define NUMEROV_SHOOTING_H
+
+// Single bound states of an arbitrary smooth one dimensional potential V(x) by Numerov shooting
+// psi'' = -k^{2}(x) psi, k^{2} = 2 m (E - V(x)) / hbar^{2}, is integrated on the grid x_i = x_left + i h, i = 0..N, with psi = 0 at both ends
+// Numerov's method is sixth order locally and fourth order in the levels for a smooth V, against second order for fd_well,
+// a step in V adds a second order error, the mass is constant, use fd_well for a position dependent mass
+// With u_i = 1 + h^{2} k_i^{2} / 12 and phi_i = u_i psi_i the scheme is phi_{i+1} - 2 phi_i + phi_{i-1} = -12 (u_i - 1) / u_i phi_i,
+// which is integrated in the summed form D_i = D_{i-1} - 12 (u_i - 1) / u_i phi_i, phi_{i+1} = phi_i + D_i, so that the small h^{2} k^{2}
+// term is never added to the much larger 2 phi_i, values are scaled down whenever they pass NUMEROV_BIG
+
+// Level n, counted from 0, is found without the levels below it
+// 1. node counting: the solution shot from x_left has as many sign changes on x_1..x_N as there are levels below E,
+//    so level n is bracketed by bisection until the count is n at the lower end and n + 1 at the upper end
+// 2. matching: the solutions shot outward from x_left and inward from x_right meet at the outer classical turning point x_m,
+//    the discrete Wronskian W = phi^{L}_m phi^{R}_{m+1} - phi^{L}_{m+1} phi^{R}_m is zero only at a level and changes sign there,
+//    it is divided by the lengths of (phi_m, phi_{m+1}) for both solutions, which makes it sin of the angle between their
+//    log-derivatives, free of the poles of the log-derivative difference and of the arbitrary scale of each solution,
+//    and the one root in the isolated bracket is found by Brent's method
+// Each level is a separate search so a range of levels is shared out between threads, one level at a time
+
+// The natural scale for energy is eV, scale energies accordingly
+// The natural scale for length is nm, you can scale lengths accordingly
+
+class numerov_well{
+public:
+	numerov_well();
+
+	// potential[i] in eV is the value at x_i = x_left + i h, h = (x_right - x_left) / (potential.size() - 1), lengths are in nm
+	numerov_well(double x_left, double x_right, const std::vector<double> &potential, double mass);
+
+	void set_profile(double x_left, double x_right, const std::vector<double> &potential, double mass);
+
+	// sample the potential function V(x) in eV at the n_intervals + 1 grid points
+	template <class Potential> void set_profile(double x_left, double x_right, int n_intervals, Potential V, double mass)
+	{
+		std::vector<double> potential(n_intervals > 0 ? n_intervals + 1 : 0);
+
+		double h = n_intervals > 0 ? (x_right - x_left) / n_intervals : 0.0;
+
+		for (int i = 0; i <= n_intervals && n_intervals > 0; i++) potential[i] = V(x_left + i * h);
+
+		set_profile(x_left, x_right, potential, mass);
+	}
+
+	double energy_eigenvalue(int n) const; // energy of level n in eV, n counted from 0, the levels below n are not computed
+
+	// levels n_first..n_first+n_count-1 written to energies[0..n_count-1], one level per thread
+	void energy_eigenvalues(int n_first, int n_count, double *energies) const;
+
+	// normalised wavefunction of level n at the N + 1 grid points, psi[0] = psi[N] = 0, returns the energy of the level
+	double energy_eigenfunction(int n, std::vector<double> &psi) const;
+
+	int count_levels(double E) const; // number of levels below E, the node count of the outward solution
+
+	// getters
+	inline int get_n_intervals() const { return static_cast<int>(V_grid.size()) - 1; }
+	inline double get_h() const { return h; }
+	inline double position(int i) const { return ( x_start + i * h ); }
+
+	static const int PARALLEL_MIN_LEVELS = 2; // ranges with fewer levels than this are solved on the calling thread
+
+private:
+	// k^{2} h^{2} / 12 = c (E - V_i) at every point for the energy E
+	inline double numerov_delta(double E, int i) const { return ( c_h2 * (E - V_grid[i]) ); }
+
+	void level_bracket(int n, double &E_lo, double &E_hi) const; // isolating bracket of level n from node counting
+
+	double matching_function(double E, int m) const; // normalised Wronskian of the outward and inward solutions at x_m
+
+	int matching_point(double E) const; // outer classical turning point for the energy E, kept inside 1..N-2
+
+	double refine_level(int n, double E_lo, double E_hi) const; // root of the matching function in the isolating bracket
+
+	// integrate outward from x_0 to x_{last+1}, or inward from x_N to x_last, writing phi to phi when it is not null,
+	// the return values are phi at x_last and its neighbour x_{last+1}, scaled by the same factor as the stored values,
+	// nodes, if not null, receives the number of sign changes of psi on x_1..x_{last+1} of the outward solution
+	void shoot_outward(double E, int last, double &phi_last, double &phi_next, double *phi = nullptr, int *nodes = nullptr) const;
+	void shoot_inward(double E, int last, double &phi_last, double &phi_next, double *phi = nullptr) const;
+
+private:
+	double x_start; // left end of the domain expressed in nm, psi = 0 there
+	double h; // grid spacing expressed in nm
+	double M; // mass of the particle expressed in kg
+	double c_h2; // 2 m h^{2} / 12 hbar^{2} in units of 1 / eV
+	double V_min, V_max; // extremes of the potential on the grid in eV
+
+	std::vector<double> V_grid; // V_grid[i] = V(x_i) in eV
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Minimal thread helpers for spreading independent calculations across the available cores
+// Work is split into contiguous blocks of indices with one block per thread
+
+namespace parallel_funcs{
+
+	inline int num_threads()
+	{
+		// number of worker threads to use, at least one
+
+		unsigned int n = std::thread::hardware_concurrency(); 
+
+		return ( n > 0 ? static_cast<int>(n) : 1 ); 
+	}
+
+	template <class Func> void parallel_for(int n_items, Func func, int n_threads = 0)
+	{
+		// call func(i) for i = 0..n_items-1
+		// calls for different i must be independent of one another
+		// n_threads < 1 means use every available core, the calling thread processes the first block
+
+		if (n_threads < 1) n_threads = num_threads(); 
+		if (n_threads > n_items) n_threads = n_items; 
+
+		if (n_threads < 2) {
+			for (int i = 0; i < n_items; i++) func(i); 
+		}
+		else {
+			std::vector<std::thread> workers; 
+
+			int block = n_items / n_threads, extra = n_items % n_threads; 
+			int first_end = block + (extra > 0 ? 1 : 0), start = first_end; 
+
+			for (int t = 1; t < n_threads; t++) {
+				int end = start + block + (t < extra ? 1 : 0); 
+
+				workers.push_back(std::thread([=, &func]() { for (int i = start; i < end; i++) func(i); })); 
+
+				start = end; 
+			}
+
+			for (int i = 0; i < first_end; i++) func(i); // the calling thread processes the first block
+
+			for (size_t t = 0; t < workers.size(); t++) workers[t].join(); 
+		}
+	}
+}
+
+#endif
@@ -2,30 +2,32 @@
 #include "Attach.h"
 #endif
 
-// Class definitions for the potential barrier class
+// Class definitions for the potential barrier classes
 // R. Sheehan 31 - 8 - 2021
 
-pot_barr::pot_barr()
+barr_soln::barr_soln()
 {
 	// Default constructor
 	m = W = E = V = p1 = p2 = T = R = AA = 0.0;
 	
 	BB = CC = DD = EE = t1 = t2 = zero; 
-}
 
-pot_barr::pot_barr(double particle_mass, double particle_energy, double barr_height, double barr_width)
-{
-	// Primary constructor
-	set_params(particle_mass, particle_energy, barr_height, barr_width);
+	params_defined = false; 
 }
 
-void pot_barr::set_params(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud)
+barr_soln::barr_soln(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud)
 {
-	// assign values to the parameters for the potential barrier calculation
+	// compute the solution of the potential barrier problem
 	// particle mass in units of kg
 	// energies input in units of eV but converted to J for sake of calculation
 	// distances assumed to be in units of nm
 
+	m = W = E = V = p1 = p2 = T = R = AA = 0.0;
+
+	BB = CC = DD = EE = t1 = t2 = zero;
+
+	params_defined = false;
+
 	try {
 		bool c1 = particle_mass > 0.0 ? true : false;
 		bool c2 = particle_energy > 0.0 ? true : false;
@@ -36,22 +38,9 @@ void pot_barr::set_params(double particle_mass, double particle_energy, double b
 		if (c10) {
 			m = particle_mass;
 			W = barr_width; 
-			E = template_funcs::convert_ev_J(particle_energy);
 			V = template_funcs::convert_ev_J(barr_height);
-			p1 = sqrt(2.0 * m * E);
-			p2 = sqrt(2.0 * m * (V - E));
-			
-			AA = 1.0; 
-			BB = (0.5 * AA) * (1.0 + eye * (p1 / p2) ) * exp( ( ( eye * p1 ) - p2) * ((W * 1.0e-9) / H_BAR_J) );
-			CC = (0.5 * AA) * (1.0 - eye * (p1 / p2) ) * exp( ( ( eye * p1 ) + p2) * ((W * 1.0e-9) / H_BAR_J) );
-			DD = (0.5 * CC) * (1.0 + eye * (p2 / p1)) + (0.5 * BB) * (1.0 - eye * (p2 / p1)); 
-			EE = (0.5 * CC) * (1.0 - eye * (p2 / p1)) + (0.5 * BB) * (1.0 + eye * (p2 / p1)); 
 
-			t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum outside the barrier, scale length to nm
-			t2 = (1.0e-9 * p2) / H_BAR_J; // momentum inside the barrier, scale length to nm
-
-			T = template_funcs::DSQR(abs(AA)) / template_funcs::DSQR(abs(DD)); 
-			R = template_funcs::DSQR(abs(EE)) / template_funcs::DSQR(abs(DD)); 
+			assign_energy(template_funcs::convert_ev_J(particle_energy), 2.0 * m, (W * 1.0e-9) / H_BAR_J); 
 
 			if (loud) {
 				std::cout << "DD = " << DD << " , EE = " << EE << "\nBB = " << BB << " , CC = " << CC << "\nAA = " << AA << "\n";
@@ -66,7 +55,7 @@ void pot_barr::set_params(double particle_mass, double particle_energy, double b
 			params_defined = true;
 		}
 		else {
-			std::string reason = "Error: void pot_step::set_params(double particle_mass, double particle_energy, double step_height)\n";
+			std::string reason = "Error: barr_soln::barr_soln(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud)\n";
 			if (!c1) reason += "particle_mass is not positive\n";
 			if (!c2) reason += "particle_energy is not positive\n";
 			if (!c3) reason += "barr_height is less than particle_energy\n";
@@ -80,7 +69,34 @@ void pot_barr::set_params(double particle_mass, double particle_energy, double b
 	}
 }
 
-std::complex<double> pot_barr::wavefunction(double position)
+void barr_soln::assign_energy(double energy_J, double two_m, double w_scale)
+{
+	// compute every quantity that depends on the particle energy, m, W and V must already be assigned
+	// energy_J is the particle energy in units of J, two_m = 2 m and w_scale = W / hbar with W in m 
+	// are passed in so that barr_structure can supply its stored values
+
+	E = energy_J; 
+	p1 = sqrt(two_m * E);
+	p2 = sqrt(two_m * (V - E));
+
+	// exp( (i p1 -/+ p2) W / hbar ) share the phase factor and the real exponential, so one sincos and one exp are needed
+	std::complex<double> phase = std::polar(1.0, p1 * w_scale); 
+	double grow = exp(p2 * w_scale); 
+
+	AA = 1.0; 
+	BB = (0.5 * AA) * (1.0 + eye * (p1 / p2) ) * (phase / grow);
+	CC = (0.5 * AA) * (1.0 - eye * (p1 / p2) ) * (phase * grow);
+	DD = (0.5 * CC) * (1.0 + eye * (p2 / p1)) + (0.5 * BB) * (1.0 - eye * (p2 / p1)); 
+	EE = (0.5 * CC) * (1.0 - eye * (p2 / p1)) + (0.5 * BB) * (1.0 + eye * (p2 / p1)); 
+
+	t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum outside the barrier, scale length to nm
+	t2 = (1.0e-9 * p2) / H_BAR_J; // momentum inside the barrier, scale length to nm
+
+	T = template_funcs::DSQR(AA) / std::norm(DD); 
+	R = std::norm(EE) / std::norm(DD); 
+}
+
+std::complex<double> barr_soln::wavefunction(double position) const
 {
 	// Compute the value of the wavefunction for the potential barrier problem
 	// R. Sheehan 31 - 8 - 2021
@@ -101,8 +117,51 @@ std::complex<double> pot_barr::wavefunction(double position)
 			}
 		}
 		else {
-			std::string reason = "Error: std::complex<double> pot_barr::wavefunction(double position)\n";
-			reason += "No parameters defined for pot_barr class\n";
+			std::string reason = "Error: std::complex<double> barr_soln::wavefunction(double position) const\n";
+			reason += "No parameters defined for barr_soln class\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void barr_soln::regional_eval(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// evaluation shared by both batch wavefunction methods, no checks are made on the inputs
+	// only the index lists of partition can throw (std::bad_alloc)
+
+	std::vector<int> before, inside, after;
+
+	wave_kernels::partition(position, n_positions, 0.0, W, before, inside, after);
+
+	double k1 = t1.imag(); // t1 = i k1
+	double k2 = t2.real(); // t2 = k2
+
+	// DD e^{i k1 x} + EE e^{-i k1 x} before the barrier
+	wave_kernels::oscillatory(k1, DD + EE, eye * (DD - EE), position, before, psi_re, psi_im);
+	// BB e^{k2 x} + CC e^{-k2 x} inside the barrier
+	wave_kernels::evanescent(k2, BB, CC, position, inside, psi_re, psi_im);
+	// AA e^{i k1 x} after the barrier
+	wave_kernels::oscillatory(k1, AA * one, AA * eye, position, after, psi_re, psi_im);
+}
+
+void barr_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// Compute the value of the wavefunction at each of the positions position[0..n_positions-1]
+	// real and imaginary parts are written to psi_re[0..n_positions-1] and psi_im[0..n_positions-1]
+	// positions are sorted into before, inside and after the barrier and each region is evaluated by a single wave_kernels call
+
+	try {
+		if (params_defined && position != NULL && n_positions > 0) {
+			regional_eval(position, n_positions, psi_re, psi_im); 
+		}
+		else {
+			std::string reason = "Error: void barr_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const\n";
+			if (!params_defined) reason += "No parameters defined for barr_soln class\n";
+			if (position == NULL || n_positions < 1) reason += "No positions supplied\n";
 			throw std::invalid_argument(reason);
 		}
 	}
@@ -112,7 +171,73 @@ std::complex<double> pot_barr::wavefunction(double position)
 	}
 }
 
-void pot_barr::compute_wavefunction(std::string filename)
+int barr_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept
+{
+	// non-throwing version of the batch wavefunction
+	// status[i] receives the eval_status flags for position[i], flagged positions have psi set to NaN
+	// returns the number of flagged positions, or -1 if the arrays are missing
+
+	if (position == NULL || psi_re == NULL || psi_im == NULL || status == NULL || n_positions < 0) return -1; 
+
+	int fixed = params_defined ? EVAL_OK : EVAL_NO_PARAMS; 
+	int n_bad = 0; 
+
+	for (int i = 0; i < n_positions; i++) {
+		status[i] = fixed | (std::isfinite(position[i]) ? EVAL_OK : EVAL_BAD_POSITION); 
+		if (status[i] != EVAL_OK) n_bad++; 
+	}
+
+	if (params_defined && n_positions > 0) {
+		try {
+			regional_eval(position, n_positions, psi_re, psi_im); 
+		}
+		catch (std::bad_alloc&) {
+			for (int i = 0; i < n_positions; i++) status[i] |= EVAL_NO_MEMORY; 
+			n_bad = n_positions; 
+		}
+	}
+
+	if (n_bad > 0) {
+		double nan = std::numeric_limits<double>::quiet_NaN(); 
+		for (int i = 0; i < n_positions; i++) if (status[i] != EVAL_OK) psi_re[i] = psi_im[i] = nan; 
+	}
+
+	return n_bad; 
+}
+
+void barr_soln::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const
+{
+	// Compute the value of the wavefunction on the uniform grid x_{j} = x_start + j dx, j = 0..n_points-1
+	// the grid is split at the barrier edges and each part is generated by the phasor recurrences in wave_kernels
+	// see Wave_Kernels.h for the accuracy of the recurrences relative to the direct evaluation
+
+	try {
+		if (params_defined && dx > 0.0 && n_points > 0) {
+			int j0 = wave_kernels::grid_split(x_start, dx, n_points, 0.0); // first point with x >= 0
+			int j1 = wave_kernels::grid_split(x_start, dx, n_points, W, true); // first point with x > W
+
+			double k1 = t1.imag(); // t1 = i k1
+			double k2 = t2.real(); // t2 = k2
+
+			wave_kernels::oscillatory_grid(k1, DD + EE, eye * (DD - EE), x_start, dx, j0, psi_re, psi_im);
+			wave_kernels::evanescent_grid(k2, BB, CC, x_start + j0 * dx, dx, j1 - j0, psi_re + j0, psi_im + j0);
+			wave_kernels::oscillatory_grid(k1, AA * one, AA * eye, x_start + j1 * dx, dx, n_points - j1, psi_re + j1, psi_im + j1);
+		}
+		else {
+			std::string reason = "Error: void barr_soln::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const\n";
+			if (!params_defined) reason += "No parameters defined for barr_soln class\n";
+			if (dx <= 0.0) reason += "Grid spacing is not positive\n";
+			if (n_points < 1) reason += "No grid points requested\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void barr_soln::compute_wavefunction(std::string filename) const
 {
 	// send the computed wavefunction to a file
 	// R. Sheehan 20 - 8 - 2021
@@ -127,26 +252,25 @@ void pot_barr::compute_wavefunction(std::string filename)
 
 				int nn = 1001;
 				double x0 = -3.0, dx = (2.0 * fabs(x0)) / static_cast<double>(nn - 1);
-				std::complex<double> psi;
+				std::vector<double> psi_re(nn), psi_im(nn);
+
+				wavefunction_grid(x0, dx, nn, &psi_re[0], &psi_im[0]);
 
 				for (int i = 0; i < nn; i++) {
-					psi = wavefunction(x0);
-					write << std::setprecision(10) << x0 << " , " << psi.real() << " , " << psi.imag() << " , " << template_funcs::DSQR(psi.real()) + template_funcs::DSQR(psi.imag()) << "\n";
-					//write << std::setprecision(10) << x0 << " , " << psi.real() << " , " << psi.imag() << "\n";
-					x0 += dx;
+					write << std::setprecision(10) << x0 + i * dx << " , " << psi_re[i] << " , " << psi_im[i] << " , " << template_funcs::DSQR(psi_re[i]) + template_funcs::DSQR(psi_im[i]) << "\n";
 				}
 
 				write.close();
 			}
 			else {
-				std::string reason = "Error: void pot_barr::compute_wavefunction(std::string filename)\n";
+				std::string reason = "Error: void barr_soln::compute_wavefunction(std::string filename) const\n";
 				reason += "Could not open file: " + filename + "\n";
 				throw std::invalid_argument(reason);
 			}
 		}
 		else {
-			std::string reason = "Error: void pot_barr::compute_wavefunction(std::string filename)\n";
-			if (!params_defined) reason += "No parameters defined for pot_barr class\n";
+			std::string reason = "Error: void barr_soln::compute_wavefunction(std::string filename) const\n";
+			if (!params_defined) reason += "No parameters defined for barr_soln class\n";
 			if (filename == empty_str) reason += "Invalid filename\n";
 			throw std::invalid_argument(reason);
 		}
@@ -154,4 +278,317 @@ void pot_barr::compute_wavefunction(std::string filename)
 	catch (std::invalid_argument& e) {
 		std::cerr << e.what();
 	}
-}
\ No newline at end of file
+}
+
+barr_structure::barr_structure()
+{
+	// Default constructor
+	m = two_m = W = w_scale = V = V_eV = k_scale = 0.0;
+	params_defined = false;
+}
+
+barr_structure::barr_structure(double particle_mass, double barr_height, double barr_width)
+{
+	// store the energy independent quantities of the potential barrier problem
+	// particle mass in units of kg, barrier height in units of eV, barrier width in units of nm
+
+	m = two_m = W = w_scale = V = V_eV = k_scale = 0.0;
+	params_defined = false;
+
+	try {
+		bool c1 = particle_mass > 0.0 ? true : false;
+		bool c3 = barr_height > 0.0 ? true : false;
+		bool c4 = barr_width > 0.0 ? true : false;
+
+		if (c1 && c3 && c4) {
+			m = particle_mass;
+			two_m = 2.0 * m;
+			W = barr_width;
+			w_scale = (W * 1.0e-9) / H_BAR_J;
+			V_eV = barr_height;
+			V = template_funcs::convert_ev_J(barr_height);
+			k_scale = ( sqrt(two_m * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J;
+
+			params_defined = true;
+		}
+		else {
+			std::string reason = "Error: barr_structure::barr_structure(double particle_mass, double barr_height, double barr_width)\n";
+			if (!c1) reason += "particle_mass is not positive\n";
+			if (!c3) reason += "barr_height is not positive\n";
+			if (!c4) reason += "barr_width is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+barr_soln barr_structure::solve(double particle_energy) const
+{
+	// solution of the potential barrier problem for this structure at one particle energy in units of eV
+	// the result is identical to barr_soln(m, particle_energy, V, W) but only the energy dependent quantities are computed
+
+	try {
+		if (params_defined && particle_energy > 0.0 && V_eV > particle_energy) {
+			barr_soln soln;
+
+			soln.m = m;
+			soln.W = W;
+			soln.V = V;
+			soln.assign_energy(template_funcs::convert_ev_J(particle_energy), two_m, w_scale);
+			soln.params_defined = true;
+
+			return soln;
+		}
+		else {
+			std::string reason = "Error: barr_soln barr_structure::solve(double particle_energy) const\n";
+			if (!params_defined) reason += "No parameters defined for barr_structure class\n";
+			if (!(particle_energy > 0.0)) reason += "particle_energy is not positive\n";
+			if (!(V_eV > particle_energy)) reason += "barr_height is less than particle_energy\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void barr_structure::probabilities(double particle_energy, double &T, double &R) const noexcept
+{
+	// transmission and reflection probabilities at one particle energy in units of eV without building a barr_soln
+	// T = 1 / ( 1 + V^{2} sinh^{2}(k2 W) / (4 E (V - E)) ), which equals |AA|^{2} / |DD|^{2}
+	// T and R are NaN if no parameters are defined or particle_energy is outside (0, V)
+
+	if (params_defined && particle_energy > 0.0 && V_eV > particle_energy) {
+		double sh = sinh(k_scale * sqrt(V_eV - particle_energy) * W);
+
+		T = 1.0 / ( 1.0 + (V_eV * V_eV * sh * sh) / (4.0 * particle_energy * (V_eV - particle_energy)) );
+		R = 1.0 - T;
+	}
+	else {
+		T = R = std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+pot_barr::pot_barr()
+{
+	// Default constructor, no parameters are defined until set_params is called
+}
+
+pot_barr::pot_barr(double particle_mass, double particle_energy, double barr_height, double barr_width)
+{
+	// Primary constructor
+	set_params(particle_mass, particle_energy, barr_height, barr_width);
+}
+
+void pot_barr::set_params(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud)
+{
+	// replace the current solution with that for the new parameters
+	// particle mass in units of kg, energies in units of eV, distances in units of nm
+
+	structure = barr_structure(particle_mass, barr_height, barr_width);
+	soln = barr_soln(particle_mass, particle_energy, barr_height, barr_width, loud);
+}
+
+void pot_barr::set_energy(double particle_energy)
+{
+	// replace the current solution with that at a new particle energy in units of eV
+	// the mass and barrier are those of the last call to set_params
+
+	soln = structure.solve(particle_energy);
+}
+
+std::complex<double> pot_barr::wavefunction(double position) const
+{
+	// value of the wavefunction of the current solution at position
+	return soln.wavefunction(position);
+}
+
+void pot_barr::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// value of the wavefunction of the current solution at each of the positions
+	soln.wavefunction(position, n_positions, psi_re, psi_im);
+}
+
+int pot_barr::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept
+{
+	// non-throwing value of the wavefunction of the current solution at each of the positions
+	return soln.wavefunction(position, n_positions, psi_re, psi_im, status); 
+}
+
+void pot_barr::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const
+{
+	// value of the wavefunction of the current solution on a uniform grid
+	soln.wavefunction_grid(x_start, dx, n_points, psi_re, psi_im);
+}
+
+void pot_barr::compute_wavefunction(std::string filename) const
+{
+	// send the wavefunction of the current solution to a file
+	soln.compute_wavefunction(filename);
+}
+
+void barr_sweep::resize(int n_energies)
+{
+	// allocate space for the results of an energy sweep
+
+	E.resize(n_energies); T.resize(n_energies); R.resize(n_energies);
+	k1.resize(n_energies); k2.resize(n_energies);
+	BB_re.resize(n_energies); BB_im.resize(n_energies);
+	CC_re.resize(n_energies); CC_im.resize(n_energies);
+	DD_re.resize(n_energies); DD_im.resize(n_energies);
+	EE_re.resize(n_energies); EE_im.resize(n_energies);
+}
+
+void barr_sweep::invalidate(int i)
+{
+	// mark the results for the i^{th} energy as unavailable, the input energy is kept
+
+	double nan = std::numeric_limits<double>::quiet_NaN();
+
+	T[i] = R[i] = k1[i] = k2[i] = nan;
+	BB_re[i] = BB_im[i] = CC_re[i] = CC_im[i] = nan;
+	DD_re[i] = DD_im[i] = EE_re[i] = EE_im[i] = nan;
+}
+
+void pot_barr::sweep_kernel(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results) const noexcept
+{
+	// loop shared by both versions of energy_sweep, results must already be sized to hold n_energies values
+	// there are no checks here, invalid inputs produce NaN or inf rather than an exception
+
+	// when E is expressed in eV the wavenumber in units of nm^{-1} is k = k_scale * sqrt(E)
+	double k_scale = ( sqrt(2.0 * particle_mass * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J;
+	double V = barr_height; 
+	double W = barr_width; 
+
+	double *E_out = &results.E[0], *T_out = &results.T[0], *R_out = &results.R[0];
+	double *k1_out = &results.k1[0], *k2_out = &results.k2[0];
+	double *BB_re = &results.BB_re[0], *BB_im = &results.BB_im[0];
+	double *CC_re = &results.CC_re[0], *CC_im = &results.CC_im[0];
+	double *DD_re = &results.DD_re[0], *DD_im = &results.DD_im[0];
+	double *EE_re = &results.EE_re[0], *EE_im = &results.EE_im[0];
+
+	for (int i = 0; i < n_energies; i++) {
+		double E = particle_energy[i]; 
+		double k1 = k_scale * sqrt(E); 
+		double k2 = k_scale * sqrt(V - E); 
+		double a = k1 / k2; // p1 / p2
+		double b = k2 / k1; // p2 / p1
+		double c = cos(k1 * W), s = sin(k1 * W); 
+		double ep = exp(k2 * W), em = 1.0 / ep; 
+
+		// BB = (1/2) (1 + i p1/p2) exp( (i p1 - p2) W / hbar ) 
+		double bb_re = 0.5 * em * (c - a * s), bb_im = 0.5 * em * (s + a * c); 
+		// CC = (1/2) (1 - i p1/p2) exp( (i p1 + p2) W / hbar ) 
+		double cc_re = 0.5 * ep * (c + a * s), cc_im = 0.5 * ep * (s - a * c); 
+		// DD = (1/2) CC (1 + i p2/p1) + (1/2) BB (1 - i p2/p1)
+		double dd_re = 0.5 * ( (cc_re - b * cc_im) + (bb_re + b * bb_im) ); 
+		double dd_im = 0.5 * ( (cc_im + b * cc_re) + (bb_im - b * bb_re) ); 
+		// EE = (1/2) CC (1 - i p2/p1) + (1/2) BB (1 + i p2/p1)
+		double ee_re = 0.5 * ( (cc_re + b * cc_im) + (bb_re - b * bb_im) );
+		double ee_im = 0.5 * ( (cc_im - b * cc_re) + (bb_im + b * bb_re) );
+		double dd_sqr = dd_re * dd_re + dd_im * dd_im; 
+
+		E_out[i] = E; 
+		k1_out[i] = k1; 
+		k2_out[i] = k2; 
+		BB_re[i] = bb_re; BB_im[i] = bb_im; 
+		CC_re[i] = cc_re; CC_im[i] = cc_im; 
+		DD_re[i] = dd_re; DD_im[i] = dd_im; 
+		EE_re[i] = ee_re; EE_im[i] = ee_im; 
+		T_out[i] = 1.0 / dd_sqr; // |AA|^{2} / |DD|^{2} with AA = 1
+		R_out[i] = (ee_re * ee_re + ee_im * ee_im) / dd_sqr; 
+	}
+}
+
+void pot_barr::energy_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results) const
+{
+	// compute T, R and the solution constants for a contiguous array of particle energies in a single pass
+	// particle mass in units of kg, energies in units of eV, barrier width in units of nm
+	// quantities that depend only on the mass and the barrier are computed once outside the loop
+	// complex products are written out in real arithmetic so that the loop body can be vectorised
+	// results agree with those of set_params to within rounding, the state of the object is not changed
+
+	try {
+		bool c1 = particle_mass > 0.0 ? true : false;
+		bool c4 = barr_width > 0.0 ? true : false;
+		bool c5 = (particle_energy != NULL && n_energies > 0) ? true : false;
+		bool c2 = true, c3 = true; 
+
+		if (c5) {
+			for (int i = 0; i < n_energies; i++) {
+				if (!(particle_energy[i] > 0.0)) c2 = false;
+				if (!(barr_height > particle_energy[i])) c3 = false;
+			}
+		}
+
+		if (c1 && c2 && c3 && c4 && c5) {
+			results.resize(n_energies);
+
+			sweep_kernel(particle_mass, barr_height, barr_width, particle_energy, n_energies, results); 
+		}
+		else {
+			std::string reason = "Error: void pot_barr::energy_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results) const\n";
+			if (!c1) reason += "particle_mass is not positive\n";
+			if (!c2) reason += "particle_energy contains values that are not positive\n";
+			if (!c3) reason += "barr_height is less than particle_energy\n";
+			if (!c4) reason += "barr_width is not positive\n";
+			if (!c5) reason += "No particle energies supplied\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+int pot_barr::validate_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, int *status) const noexcept
+{
+	// cheap pre-pass that applies the checks of energy_sweep to every energy without stopping at the first failure
+	// status[i] receives the eval_status flags for particle_energy[i]
+	// returns the number of energies that cannot be computed, or -1 if the arrays are missing
+
+	if (particle_energy == NULL || status == NULL || n_energies < 0) return -1;
+
+	int fixed = (particle_mass > 0.0 ? EVAL_OK : EVAL_BAD_MASS) | (barr_width > 0.0 ? EVAL_OK : EVAL_BAD_WIDTH);
+	int n_bad = 0;
+
+	for (int i = 0; i < n_energies; i++) {
+		status[i] = fixed;
+		if (!(particle_energy[i] > 0.0)) status[i] |= EVAL_BAD_ENERGY;
+		if (!(barr_height > particle_energy[i])) status[i] |= EVAL_BAD_HEIGHT; // solution only valid for E < V
+		if (status[i] != EVAL_OK) n_bad++;
+	}
+
+	return n_bad;
+}
+
+int pot_barr::energy_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results, int *status) const noexcept
+{
+	// non-throwing version of energy_sweep, energies that fail validate_sweep are flagged in status and their results set to NaN
+	// returns the number of flagged energies, or -1 if the arrays are missing
+
+	int n_bad = validate_sweep(particle_mass, barr_height, barr_width, particle_energy, n_energies, status);
+
+	if (n_bad < 0) return n_bad;
+
+	try {
+		results.resize(n_energies);
+	}
+	catch (std::bad_alloc&) {
+		for (int i = 0; i < n_energies; i++) status[i] |= EVAL_NO_MEMORY;
+		return n_energies;
+	}
+
+	if (n_energies > 0) sweep_kernel(particle_mass, barr_height, barr_width, particle_energy, n_energies, results);
+
+	if (n_bad > 0) {
+		for (int i = 0; i < n_energies; i++) if (status[i] != EVAL_OK) results.invalidate(i);
+	}
+
+	return n_bad;
+}
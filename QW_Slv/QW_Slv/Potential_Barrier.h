@@ -5,22 +5,57 @@
 // Notation taken from "Quantum Theory" by David Bohm
 // R. Sheehan 31 - 8 - 2021
 
-class pot_barr {
+// Structure-of-arrays container for the output of pot_barr::energy_sweep
+// Element i of each array corresponds to the i^{th} particle energy in the sweep
+// Amplitudes are those of set_params with AA = 1, wavenumbers are expressed in units of nm^{-1}
+struct barr_sweep {
+	void resize(int n_energies);
+
+	void invalidate(int i);
+
+	std::vector<double> E; // particle energy in units of eV
+	std::vector<double> T; // transmission probability
+	std::vector<double> R; // reflection probability
+	std::vector<double> k1; // wavenumber before / after barrier
+	std::vector<double> k2; // decay constant within barrier
+	std::vector<double> BB_re, BB_im; // growing amplitude within barrier
+	std::vector<double> CC_re, CC_im; // decaying amplitude within barrier
+	std::vector<double> DD_re, DD_im; // incident amplitude
+	std::vector<double> EE_re, EE_im; // reflected amplitude
+};
+
+// Immutable solution of the potential barrier problem for one set of parameters
+// Every method is const and has no side effects, so a barr_soln can be copied cheaply 
+// and shared read-only between threads evaluating different positions or observables
+class barr_soln {
 public:
-	pot_barr(); 
-	pot_barr(double particle_mass, double particle_energy, double barr_height, double barr_width);
+	barr_soln();
+	barr_soln(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud = false);
 
-	void set_params(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud = false);
+	std::complex<double> wavefunction(double position) const;
+
+	void wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const;
+
+	// non-throwing batch evaluation, bad positions are flagged in status rather than ending the program
+	int wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept;
 
-	std::complex<double> wavefunction(double position);
+	void wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const;
 
-	void compute_wavefunction(std::string filename);
+	void compute_wavefunction(std::string filename) const;
 
 	// getters
-	inline double get_E() { return E; }
-	inline double get_V() { return V; }
-	inline double get_T() { return T; }
-	inline double get_R() { return R; }
+	inline bool defined() const { return params_defined; }
+	inline double get_E() const { return E; }
+	inline double get_V() const { return V; }
+	inline double get_T() const { return T; }
+	inline double get_R() const { return R; }
+
+private:
+	friend class barr_structure;
+
+	void assign_energy(double energy_J, double two_m, double w_scale);
+
+	void regional_eval(const double *position, int n_positions, double *psi_re, double *psi_im) const;
 
 private:
 	bool params_defined; // boolean to decide if parameters have been assigned to the class
@@ -42,4 +77,77 @@ private:
 	std::complex<double> t2; // solution constant
 };
 
+// Energy independent part of the potential barrier problem
+// The mass, barrier height and width are checked and converted once, solve then only does the work that depends on the particle energy
+class barr_structure {
+public:
+	barr_structure();
+	barr_structure(double particle_mass, double barr_height, double barr_width);
+
+	barr_soln solve(double particle_energy) const;
+
+	void probabilities(double particle_energy, double &T, double &R) const noexcept;
+
+	// getters
+	inline bool defined() const { return params_defined; }
+	inline double get_V() const { return V; }
+	inline double get_V_eV() const { return V_eV; }
+	inline double get_W() const { return W; }
+
+private:
+	bool params_defined; // boolean to decide if parameters have been assigned to the class
+	double m; // particle mass in units of kg
+	double two_m; // 2 m in units of kg
+	double W; // barrier width in units of nm
+	double w_scale; // W / hbar with W in units of m
+	double V; // barrier height in units of J
+	double V_eV; // barrier height in units of eV
+	double k_scale; // wavenumber in units of nm^{-1} is k = k_scale * sqrt(E) with E in units of eV
+};
+
+// pot_barr holds the current solution and replaces it each time set_params is called
+// Use get_soln() to take an immutable copy that can be shared between threads
+class pot_barr {
+public:
+	pot_barr(); 
+	pot_barr(double particle_mass, double particle_energy, double barr_height, double barr_width);
+
+	void set_params(double particle_mass, double particle_energy, double barr_height, double barr_width, bool loud = false);
+
+	void set_energy(double particle_energy); // keep the mass and barrier of the last set_params, only E dependent quantities are recomputed
+
+	std::complex<double> wavefunction(double position) const;
+
+	void wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const;
+
+	// non-throwing batch evaluation, bad positions are flagged in status rather than ending the program
+	int wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept;
+
+	void wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const;
+
+	void compute_wavefunction(std::string filename) const;
+
+	void energy_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results) const;
+
+	// non-throwing sweep, bad energies are flagged in status rather than ending the program
+	int validate_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, int *status) const noexcept;
+
+	int energy_sweep(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results, int *status) const noexcept;
+
+	// getters
+	inline const barr_soln& get_soln() const { return soln; }
+	inline const barr_structure& get_structure() const { return structure; }
+	inline double get_E() const { return soln.get_E(); }
+	inline double get_V() const { return soln.get_V(); }
+	inline double get_T() const { return soln.get_T(); }
+	inline double get_R() const { return soln.get_R(); }
+
+private:
+	void sweep_kernel(double particle_mass, double barr_height, double barr_width, const double *particle_energy, int n_energies, barr_sweep &results) const noexcept;
+
+private:
+	barr_structure structure; // mass and barrier of the current parameters
+	barr_soln soln; // solution for the current parameters
+};
+
 #endif
@@ -2,29 +2,27 @@
 #include "Attach.h"
 #endif
 
-// Class definitions for the potential step class
+// Class definitions for the potential step classes
 // R. Sheehan 19 - 8 - 2021
 
-pot_step::pot_step()
+step_soln::step_soln()
 {
 	// default constructor
 	m = E = V = p1 = p2 = T = R = A = B = C = D = 0.0; 
-	CC = DD = zero; 
+	t1 = t2 = CC = DD = zero; 
 	params_defined = high = false; 
 }
 
-pot_step::pot_step(double particle_mass, double particle_energy, double step_height)
-{
-	// primary constructor
-	set_params(particle_mass, particle_energy, step_height); 
-}
-
-void pot_step::set_params(double particle_mass, double particle_energy, double step_height, bool loud)
+step_soln::step_soln(double particle_mass, double particle_energy, double step_height, bool loud)
 {
-	// assign values to the parameters for the potential step calculation
+	// compute the solution of the potential step problem
 	// particle mass in units of kg
 	// energies input in units of eV but converted to J for sake of calculation
 
+	m = E = V = p1 = p2 = T = R = A = B = C = D = 0.0;
+	t1 = t2 = CC = DD = zero;
+	params_defined = high = false;
+
 	try {
 		bool c1 = particle_mass > 0.0 ? true : false;
 		bool c2 = particle_energy > 0.0 ? true : false;
@@ -33,60 +31,22 @@ void pot_step::set_params(double particle_mass, double particle_energy, double s
 
 		if (c10) {
 			m = particle_mass; 
-			E = template_funcs::convert_ev_J(particle_energy); 
 			V = template_funcs::convert_ev_J(step_height);
-			p1 = sqrt(2.0 * m * E); 
-			
-			if (E > V) {
-				//particle energy greater than step height
-				high = true; 
-				p2 = sqrt(2.0 * m * (E - V));				
-				double psum = p1 + p2; 
-				double pdiff = p2 - p1; 
-				B = 1;
-				C = ( pdiff * B ) / psum;
-				A = (2.0 * p1 * B) / psum; 
-				T = (4.0 * p1 * p2) / (template_funcs::DSQR(psum)); 
-				R = (template_funcs::DSQR(pdiff)) / (template_funcs::DSQR(psum)); 
-				
-				t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum before the step, scale length to nm
-				t2 = (eye * p2 * 1.0e-9) / H_BAR_J; // momentum after the step, scale length to nm
-
-				if (loud) {
-					std::cout << "B = " << B << " , C = " << C << " , A = " << A << "\n";
-					std::cout << "p1 = " << p1 << " , p2 = " << p2 << "\n";
-					std::cout << "t1 = " << t1 << " , t2 = " << t2 << "\n";
-					std::cout << "T = " << T << ", R = " << R << ", T+R = " << T + R << "\n";
-				}
-			}
-			else {
-				//particle energy less than step height
-				high = false; 
-				double delta = V - E; 
-				p2 = sqrt(2.0 * m * delta);
-				B = 1; 
-				D = sqrt(delta / E); 
-				CC = (B / 2) * (one + eye * D); 
-				DD = (B / 2) * (one - eye * D); 
-				R = 1.0; 
-				T = 0.0; 
-				
-				t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum before the step, scale length to nm
-				t2 = (-1.0e-9 * p2) / H_BAR_J; // momentum after the step, scale length to nm
 
+			assign_energy(template_funcs::convert_ev_J(particle_energy), 2.0 * m); 
 
-				if (loud) {
-					std::cout << "CC = " << CC << " , DD = " << DD << " , B = " << B << "\n";
-					std::cout << "p1 = " << p1 << " , p2 = " << p2 << "\n";
-					std::cout << "t1 = " << t1 << " , t2 = " << t2 << "\n";
-					std::cout << "T = " << T << ", R = " << R << ", T+R = " << T + R << "\n";
-				}
+			if (loud) {
+				if (high) std::cout << "B = " << B << " , C = " << C << " , A = " << A << "\n";
+				else std::cout << "CC = " << CC << " , DD = " << DD << " , B = " << B << "\n";
+				std::cout << "p1 = " << p1 << " , p2 = " << p2 << "\n";
+				std::cout << "t1 = " << t1 << " , t2 = " << t2 << "\n";
+				std::cout << "T = " << T << ", R = " << R << ", T+R = " << T + R << "\n";
 			}
 
 			params_defined = true; 
 		}
 		else {
-			std::string reason = "Error: void pot_step::set_params(double particle_mass, double particle_energy, double step_height)\n";
+			std::string reason = "Error: step_soln::step_soln(double particle_mass, double particle_energy, double step_height, bool loud)\n";
 			if (!c1) reason += "particle_mass is not positive\n";
 			if (!c2) reason += "particle_energy is not positive\n";
 			if (!c3) reason += "step_height is not positive\n";
@@ -99,7 +59,47 @@ void pot_step::set_params(double particle_mass, double particle_energy, double s
 	}
 }
 
-std::complex<double> pot_step::wavefunction(double position)
+void step_soln::assign_energy(double energy_J, double two_m)
+{
+	// compute every quantity that depends on the particle energy, m and V must already be assigned
+	// energy_J is the particle energy in units of J, two_m = 2 m is passed in so that step_structure can supply its stored value
+
+	E = energy_J; 
+	p1 = sqrt(two_m * E); 
+	
+	if (E > V) {
+		//particle energy greater than step height
+		high = true; 
+		p2 = sqrt(two_m * (E - V));				
+		double psum = p1 + p2; 
+		double pdiff = p2 - p1; 
+		B = 1;
+		C = ( pdiff * B ) / psum;
+		A = (2.0 * p1 * B) / psum; 
+		T = (4.0 * p1 * p2) / (template_funcs::DSQR(psum)); 
+		R = (template_funcs::DSQR(pdiff)) / (template_funcs::DSQR(psum)); 
+		
+		t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum before the step, scale length to nm
+		t2 = (eye * p2 * 1.0e-9) / H_BAR_J; // momentum after the step, scale length to nm
+	}
+	else {
+		//particle energy less than step height
+		high = false; 
+		double delta = V - E; 
+		p2 = sqrt(two_m * delta);
+		B = 1; 
+		D = sqrt(delta / E); 
+		CC = (B / 2) * (one + eye * D); 
+		DD = (B / 2) * (one - eye * D); 
+		R = 1.0; 
+		T = 0.0; 
+		
+		t1 = (eye * p1 * 1.0e-9) / H_BAR_J; // momentum before the step, scale length to nm
+		t2 = (-1.0e-9 * p2) / H_BAR_J; // momentum after the step, scale length to nm
+	}
+}
+
+std::complex<double> step_soln::wavefunction(double position) const
 {
 	// compute the value of the particle wavefunction for the potential step problem
 	// R. Sheehan 20 - 8 - 2021
@@ -131,8 +131,58 @@ std::complex<double> pot_step::wavefunction(double position)
 			}
 		}
 		else { 
-			std::string reason = "Error: std::complex<double> pot_step::wavefunction(double position)\n"; 
-			reason += "No parameters defined for pot_step class\n"; 
+			std::string reason = "Error: std::complex<double> step_soln::wavefunction(double position) const\n"; 
+			reason += "No parameters defined for step_soln class\n"; 
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void step_soln::regional_eval(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// evaluation shared by both batch wavefunction methods, no checks are made on the inputs
+	// only the index lists of partition can throw (std::bad_alloc)
+
+	std::vector<int> before, at, after; 
+
+	wave_kernels::partition(position, n_positions, 0.0, 0.0, before, at, after); 
+
+	double k1 = t1.imag(); // t1 = i k1
+	double k2 = high ? t2.imag() : -t2.real(); // t2 = i k2 when E > V, t2 = -k2 when E < V
+
+	if (high) {
+		// B e^{i k1 x} + C e^{-i k1 x} before the step, A e^{i k2 x} after
+		wave_kernels::oscillatory(k1, B + C, eye * (B - C), position, before, psi_re, psi_im); 
+		wave_kernels::oscillatory(k2, A, eye * A, position, at, psi_re, psi_im);
+		wave_kernels::oscillatory(k2, A, eye * A, position, after, psi_re, psi_im);
+	}
+	else {
+		// CC e^{i k1 x} + DD e^{-i k1 x} before the step, B e^{-k2 x} after
+		wave_kernels::oscillatory(k1, CC + DD, eye * (CC - DD), position, before, psi_re, psi_im);
+		wave_kernels::evanescent(k2, zero, B * one, position, at, psi_re, psi_im);
+		wave_kernels::evanescent(k2, zero, B * one, position, after, psi_re, psi_im);
+	}
+}
+
+void step_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// compute the value of the particle wavefunction at each of the positions position[0..n_positions-1]
+	// real and imaginary parts are written to psi_re[0..n_positions-1] and psi_im[0..n_positions-1]
+	// positions are sorted by region and each region is evaluated by a single wave_kernels call
+	// so the region test and the parameter check are done once per position set rather than once per position
+
+	try {
+		if (params_defined && position != NULL && n_positions > 0) {
+			regional_eval(position, n_positions, psi_re, psi_im); 
+		}
+		else {
+			std::string reason = "Error: void step_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const\n";
+			if (!params_defined) reason += "No parameters defined for step_soln class\n";
+			if (position == NULL || n_positions < 1) reason += "No positions supplied\n";
 			throw std::invalid_argument(reason);
 		}
 	}
@@ -142,7 +192,78 @@ std::complex<double> pot_step::wavefunction(double position)
 	}
 }
 
-void pot_step::compute_wavefunction(std::string filename)
+int step_soln::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept
+{
+	// non-throwing version of the batch wavefunction
+	// status[i] receives the eval_status flags for position[i], flagged positions have psi set to NaN
+	// returns the number of flagged positions, or -1 if the arrays are missing
+
+	if (position == NULL || psi_re == NULL || psi_im == NULL || status == NULL || n_positions < 0) return -1; 
+
+	int fixed = params_defined ? EVAL_OK : EVAL_NO_PARAMS; 
+	int n_bad = 0; 
+
+	for (int i = 0; i < n_positions; i++) {
+		status[i] = fixed | (std::isfinite(position[i]) ? EVAL_OK : EVAL_BAD_POSITION); 
+		if (status[i] != EVAL_OK) n_bad++; 
+	}
+
+	if (params_defined && n_positions > 0) {
+		try {
+			regional_eval(position, n_positions, psi_re, psi_im); 
+		}
+		catch (std::bad_alloc&) {
+			for (int i = 0; i < n_positions; i++) status[i] |= EVAL_NO_MEMORY; 
+			n_bad = n_positions; 
+		}
+	}
+
+	if (n_bad > 0) {
+		double nan = std::numeric_limits<double>::quiet_NaN(); 
+		for (int i = 0; i < n_positions; i++) if (status[i] != EVAL_OK) psi_re[i] = psi_im[i] = nan; 
+	}
+
+	return n_bad; 
+}
+
+void step_soln::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const
+{
+	// compute the value of the particle wavefunction on the uniform grid x_{j} = x_start + j dx, j = 0..n_points-1
+	// the grid is split at the step and each part is generated by the phasor recurrences in wave_kernels
+	// see Wave_Kernels.h for the accuracy of the recurrences relative to the direct evaluation
+
+	try {
+		if (params_defined && dx > 0.0 && n_points > 0) {
+			int j0 = wave_kernels::grid_split(x_start, dx, n_points, 0.0); // first point with x >= 0
+
+			double k1 = t1.imag(); // t1 = i k1
+			double k2 = high ? t2.imag() : -t2.real(); // t2 = i k2 when E > V, t2 = -k2 when E < V
+			double x0 = x_start + j0 * dx; 
+
+			if (high) {
+				wave_kernels::oscillatory_grid(k1, B + C, eye * (B - C), x_start, dx, j0, psi_re, psi_im);
+				wave_kernels::oscillatory_grid(k2, A, eye * A, x0, dx, n_points - j0, psi_re + j0, psi_im + j0);
+			}
+			else {
+				wave_kernels::oscillatory_grid(k1, CC + DD, eye * (CC - DD), x_start, dx, j0, psi_re, psi_im);
+				wave_kernels::evanescent_grid(k2, zero, B * one, x0, dx, n_points - j0, psi_re + j0, psi_im + j0);
+			}
+		}
+		else {
+			std::string reason = "Error: void step_soln::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const\n";
+			if (!params_defined) reason += "No parameters defined for step_soln class\n";
+			if (dx <= 0.0) reason += "Grid spacing is not positive\n";
+			if (n_points < 1) reason += "No grid points requested\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void step_soln::compute_wavefunction(std::string filename) const
 {
 	// send the computed wavefunction to a file
 	// R. Sheehan 20 - 8 - 2021
@@ -157,26 +278,25 @@ void pot_step::compute_wavefunction(std::string filename)
 
 				int nn = 501; 
 				double x0 = -3.0, dx = (2.0*fabs(x0)) / static_cast<double>(nn-1);
-				std::complex<double> psi; 
+				std::vector<double> psi_re(nn), psi_im(nn); 
+
+				wavefunction_grid(x0, dx, nn, &psi_re[0], &psi_im[0]); 
 
 				for (int i = 0; i < nn; i++) {
-					//write << std::setprecision(10) << x0 << " , " << abs(wavefunction(x0)) << "\n"; 
-					psi = wavefunction(x0); 
-					write << std::setprecision(10) << x0 << " , " << psi.real() << " , " << psi.imag() << " , " << template_funcs::DSQR(psi.real()) + template_funcs::DSQR(psi.imag()) << "\n";
-					x0 += dx; 
+					write << std::setprecision(10) << x0 + i * dx << " , " << psi_re[i] << " , " << psi_im[i] << " , " << template_funcs::DSQR(psi_re[i]) + template_funcs::DSQR(psi_im[i]) << "\n";
 				}
 				
 				write.close(); 
 			}
 			else {
-				std::string reason = "Error: void pot_step::compute_wavefunction(std::string filename)\n";
+				std::string reason = "Error: void step_soln::compute_wavefunction(std::string filename) const\n";
 				reason += "Could not open file: " + filename + "\n"; 
 				throw std::invalid_argument(reason);
 			}
 		}
 		else {
-			std::string reason = "Error: void pot_step::compute_wavefunction(std::string filename)\n";
-			if(!params_defined) reason += "No parameters defined for pot_step class\n";
+			std::string reason = "Error: void step_soln::compute_wavefunction(std::string filename) const\n";
+			if(!params_defined) reason += "No parameters defined for step_soln class\n";
 			if (filename == empty_str) reason += "Invalid filename\n"; 
 			throw std::invalid_argument(reason);
 		}
@@ -184,4 +304,305 @@ void pot_step::compute_wavefunction(std::string filename)
 	catch (std::invalid_argument& e) {
 		std::cerr << e.what();
 	}
-}
\ No newline at end of file
+}
+
+step_structure::step_structure()
+{
+	// default constructor
+	m = two_m = V = V_eV = k_scale = 0.0; 
+	params_defined = false; 
+}
+
+step_structure::step_structure(double particle_mass, double step_height)
+{
+	// store the energy independent quantities of the potential step problem
+	// particle mass in units of kg, step height in units of eV
+
+	m = two_m = V = V_eV = k_scale = 0.0;
+	params_defined = false;
+
+	try {
+		bool c1 = particle_mass > 0.0 ? true : false;
+		bool c3 = step_height > 0.0 ? true : false;
+
+		if (c1 && c3) {
+			m = particle_mass; 
+			two_m = 2.0 * m; 
+			V_eV = step_height; 
+			V = template_funcs::convert_ev_J(step_height); 
+			k_scale = ( sqrt(two_m * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J; 
+
+			params_defined = true; 
+		}
+		else {
+			std::string reason = "Error: step_structure::step_structure(double particle_mass, double step_height)\n";
+			if (!c1) reason += "particle_mass is not positive\n";
+			if (!c3) reason += "step_height is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+step_soln step_structure::solve(double particle_energy) const
+{
+	// solution of the potential step problem for this structure at one particle energy in units of eV
+	// the result is identical to step_soln(m, particle_energy, V) but only the energy dependent quantities are computed
+
+	try {
+		if (params_defined && particle_energy > 0.0) {
+			step_soln soln; 
+
+			soln.m = m; 
+			soln.V = V; 
+			soln.assign_energy(template_funcs::convert_ev_J(particle_energy), two_m); 
+			soln.params_defined = true; 
+
+			return soln; 
+		}
+		else {
+			std::string reason = "Error: step_soln step_structure::solve(double particle_energy) const\n";
+			if (!params_defined) reason += "No parameters defined for step_structure class\n";
+			if (!(particle_energy > 0.0)) reason += "particle_energy is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void step_structure::probabilities(double particle_energy, double &T, double &R) const noexcept
+{
+	// transmission and reflection probabilities at one particle energy in units of eV without building a step_soln
+	// T and R are NaN if no parameters are defined or particle_energy is not positive
+
+	if (params_defined && particle_energy > 0.0) {
+		if (particle_energy > V_eV) {
+			double k1 = k_scale * sqrt(particle_energy); 
+			double k2 = k_scale * sqrt(particle_energy - V_eV); 
+			double psum = k1 + k2; 
+
+			T = (4.0 * k1 * k2) / (psum * psum); 
+			R = ( (k2 - k1) * (k2 - k1) ) / (psum * psum); 
+		}
+		else {
+			T = 0.0; 
+			R = 1.0; 
+		}
+	}
+	else {
+		T = R = std::numeric_limits<double>::quiet_NaN(); 
+	}
+}
+
+pot_step::pot_step()
+{
+	// default constructor, no parameters are defined until set_params is called
+}
+
+pot_step::pot_step(double particle_mass, double particle_energy, double step_height)
+{
+	// primary constructor
+	set_params(particle_mass, particle_energy, step_height); 
+}
+
+void pot_step::set_params(double particle_mass, double particle_energy, double step_height, bool loud)
+{
+	// replace the current solution with that for the new parameters
+	// particle mass in units of kg, energies in units of eV
+
+	structure = step_structure(particle_mass, step_height); 
+	soln = step_soln(particle_mass, particle_energy, step_height, loud); 
+}
+
+void pot_step::set_energy(double particle_energy)
+{
+	// replace the current solution with that at a new particle energy in units of eV
+	// the mass and step height are those of the last call to set_params
+
+	soln = structure.solve(particle_energy); 
+}
+
+std::complex<double> pot_step::wavefunction(double position) const
+{
+	// value of the wavefunction of the current solution at position
+	return soln.wavefunction(position); 
+}
+
+void pot_step::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const
+{
+	// value of the wavefunction of the current solution at each of the positions
+	soln.wavefunction(position, n_positions, psi_re, psi_im); 
+}
+
+int pot_step::wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept
+{
+	// non-throwing value of the wavefunction of the current solution at each of the positions
+	return soln.wavefunction(position, n_positions, psi_re, psi_im, status); 
+}
+
+void pot_step::wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const
+{
+	// value of the wavefunction of the current solution on a uniform grid
+	soln.wavefunction_grid(x_start, dx, n_points, psi_re, psi_im); 
+}
+
+void pot_step::compute_wavefunction(std::string filename) const
+{
+	// send the wavefunction of the current solution to a file
+	soln.compute_wavefunction(filename); 
+}
+
+void step_sweep::resize(int n_energies)
+{
+	// allocate space for the results of an energy sweep
+
+	E.resize(n_energies); T.resize(n_energies); R.resize(n_energies); 
+	k1.resize(n_energies); k2.resize(n_energies); 
+	inc_re.resize(n_energies); inc_im.resize(n_energies); 
+	ref_re.resize(n_energies); ref_im.resize(n_energies); 
+	trn_re.resize(n_energies); trn_im.resize(n_energies); 
+}
+
+void step_sweep::invalidate(int i)
+{
+	// mark the results for the i^{th} energy as unavailable, the input energy is kept
+
+	double nan = std::numeric_limits<double>::quiet_NaN(); 
+
+	T[i] = R[i] = k1[i] = k2[i] = nan; 
+	inc_re[i] = inc_im[i] = ref_re[i] = ref_im[i] = trn_re[i] = trn_im[i] = nan; 
+}
+
+void pot_step::sweep_kernel(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results) const noexcept
+{
+	// loop shared by both versions of energy_sweep, results must already be sized to hold n_energies values
+	// there are no checks here, invalid inputs produce NaN or inf rather than an exception
+
+	// when E is expressed in eV the wavenumber in units of nm^{-1} is k = k_scale * sqrt(E)
+	double k_scale = ( sqrt(2.0 * particle_mass * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J; 
+	double V = step_height; 
+
+	double *E_out = &results.E[0], *T_out = &results.T[0], *R_out = &results.R[0]; 
+	double *k1_out = &results.k1[0], *k2_out = &results.k2[0]; 
+	double *inc_re = &results.inc_re[0], *inc_im = &results.inc_im[0]; 
+	double *ref_re = &results.ref_re[0], *ref_im = &results.ref_im[0]; 
+	double *trn_re = &results.trn_re[0], *trn_im = &results.trn_im[0]; 
+
+	for (int i = 0; i < n_energies; i++) {
+		double E = particle_energy[i]; 
+		double delta = fabs(E - V); 
+		bool high = E > V; 
+		double k1 = k_scale * sqrt(E); 
+		double k2 = k_scale * sqrt(delta); 
+		double psum = k1 + k2; 
+		double pdiff = k2 - k1; 
+		double D = sqrt(delta / E); 
+
+		E_out[i] = E; 
+		k1_out[i] = k1; 
+		k2_out[i] = k2; 
+		T_out[i] = high ? (4.0 * k1 * k2) / (psum * psum) : 0.0; 
+		R_out[i] = high ? (pdiff * pdiff) / (psum * psum) : 1.0; 
+
+		// E > V: B = 1, C = pdiff / psum, A = 2 p1 / psum
+		// E < V: CC = (1 + i D) / 2, DD = (1 - i D) / 2, B = 1
+		inc_re[i] = high ? 1.0 : 0.5; 
+		inc_im[i] = high ? 0.0 : 0.5 * D; 
+		ref_re[i] = high ? pdiff / psum : 0.5; 
+		ref_im[i] = high ? 0.0 : -0.5 * D; 
+		trn_re[i] = high ? (2.0 * k1) / psum : 1.0; 
+		trn_im[i] = 0.0; 
+	}
+}
+
+void pot_step::energy_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results) const
+{
+	// compute T, R and the solution constants for a contiguous array of particle energies in a single pass
+	// particle mass in units of kg, energies in units of eV
+	// quantities that depend only on the mass and the step height are computed once outside the loop
+	// the loop body is free of branches and function calls other than sqrt so that it can be vectorised
+	// results agree with those of set_params to within rounding, the state of the object is not changed
+
+	try {
+		bool c1 = particle_mass > 0.0 ? true : false;
+		bool c3 = step_height > 0.0 ? true : false;
+		bool c4 = (particle_energy != NULL && n_energies > 0) ? true : false;
+		bool c2 = true; 
+
+		if (c4) {
+			for (int i = 0; i < n_energies; i++) {
+				if (!(particle_energy[i] > 0.0)) c2 = false; 
+			}
+		}
+
+		if (c1 && c2 && c3 && c4) {
+			results.resize(n_energies); 
+
+			sweep_kernel(particle_mass, step_height, particle_energy, n_energies, results); 
+		}
+		else {
+			std::string reason = "Error: void pot_step::energy_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results) const\n";
+			if (!c1) reason += "particle_mass is not positive\n";
+			if (!c2) reason += "particle_energy contains values that are not positive\n";
+			if (!c3) reason += "step_height is not positive\n";
+			if (!c4) reason += "No particle energies supplied\n";
+			throw std::invalid_argument(reason);
+		}
+	}
+	catch (std::invalid_argument& e) {
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+int pot_step::validate_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, int *status) const noexcept
+{
+	// cheap pre-pass that applies the checks of energy_sweep to every energy without stopping at the first failure
+	// status[i] receives the eval_status flags for particle_energy[i]
+	// returns the number of energies that cannot be computed, or -1 if the arrays are missing
+
+	if (particle_energy == NULL || status == NULL || n_energies < 0) return -1; 
+
+	int fixed = (particle_mass > 0.0 ? EVAL_OK : EVAL_BAD_MASS) | (step_height > 0.0 ? EVAL_OK : EVAL_BAD_HEIGHT); 
+	int n_bad = 0; 
+
+	for (int i = 0; i < n_energies; i++) {
+		status[i] = fixed | (particle_energy[i] > 0.0 ? EVAL_OK : EVAL_BAD_ENERGY); 
+		if (status[i] != EVAL_OK) n_bad++; 
+	}
+
+	return n_bad; 
+}
+
+int pot_step::energy_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results, int *status) const noexcept
+{
+	// non-throwing version of energy_sweep for use inside long production sweeps
+	// energies that fail validate_sweep are flagged in status and their results are set to NaN, the rest are computed as normal
+	// returns the number of flagged energies, or -1 if the arrays are missing
+
+	int n_bad = validate_sweep(particle_mass, step_height, particle_energy, n_energies, status); 
+
+	if (n_bad < 0) return n_bad; 
+
+	try {
+		results.resize(n_energies); 
+	}
+	catch (std::bad_alloc&) {
+		for (int i = 0; i < n_energies; i++) status[i] |= EVAL_NO_MEMORY; 
+		return n_energies; 
+	}
+
+	if (n_energies > 0) sweep_kernel(particle_mass, step_height, particle_energy, n_energies, results); 
+
+	if (n_bad > 0) {
+		for (int i = 0; i < n_energies; i++) if (status[i] != EVAL_OK) results.invalidate(i); 
+	}
+
+	return n_bad; 
+}
@@ -5,22 +5,56 @@
 // Notation taken from "Quantum Theory" by David Bohm
 // R. Sheehan 19 - 8 - 2021
 
-class pot_step {
+// Structure-of-arrays container for the output of pot_step::energy_sweep
+// Element i of each array corresponds to the i^{th} particle energy in the sweep
+// Amplitudes are those of set_params with B = 1, wavenumbers are expressed in units of nm^{-1}
+struct step_sweep {
+	void resize(int n_energies); 
+
+	void invalidate(int i); 
+
+	std::vector<double> E; // particle energy in units of eV
+	std::vector<double> T; // transmission probability
+	std::vector<double> R; // reflection probability
+	std::vector<double> k1; // wavenumber before step
+	std::vector<double> k2; // wavenumber after step when E > V, decay constant after step when E < V
+	std::vector<double> inc_re, inc_im; // incident amplitude, B when E > V, CC when E < V
+	std::vector<double> ref_re, ref_im; // reflected amplitude, C when E > V, DD when E < V
+	std::vector<double> trn_re, trn_im; // transmitted amplitude, A when E > V, B when E < V
+};
+
+// Immutable solution of the potential step problem for one set of parameters
+// Every method is const and has no side effects, so a step_soln can be copied cheaply 
+// and shared read-only between threads evaluating different positions or observables
+class step_soln {
 public:
-	pot_step();
-	pot_step(double particle_mass, double particle_energy, double step_height);
+	step_soln();
+	step_soln(double particle_mass, double particle_energy, double step_height, bool loud = false);
 
-	void set_params(double particle_mass, double particle_energy, double step_height, bool loud = false);
+	std::complex<double> wavefunction(double position) const; 
+
+	void wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const; 
+
+	// non-throwing batch evaluation, bad positions are flagged in status rather than ending the program
+	int wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept; 
 
-	std::complex<double> wavefunction(double position); 
+	void wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const; 
 
-	void compute_wavefunction(std::string filename); 
+	void compute_wavefunction(std::string filename) const; 
 
 	// getters
-	inline double get_E() { return E;  }
-	inline double get_V() { return V;  }
-	inline double get_T() { return T;  }
-	inline double get_R() { return R;  }
+	inline bool defined() const { return params_defined; }
+	inline double get_E() const { return E;  }
+	inline double get_V() const { return V;  }
+	inline double get_T() const { return T;  }
+	inline double get_R() const { return R;  }
+
+private:
+	friend class step_structure; 
+
+	void assign_energy(double energy_J, double two_m); 
+
+	void regional_eval(const double *position, int n_positions, double *psi_re, double *psi_im) const; 
 
 private:
 	bool high; // boolean to decide whether E > V or E < V
@@ -42,4 +76,75 @@ private:
 	std::complex<double> DD; // solution constant
 };
 
+// Energy independent part of the potential step problem
+// The mass and step height are checked and converted once, solve then only does the work that depends on the particle energy
+// Use this when the structure is fixed and the energy varies, e.g. T(E) curves or per-energy wavefunctions
+class step_structure {
+public:
+	step_structure(); 
+	step_structure(double particle_mass, double step_height); 
+
+	step_soln solve(double particle_energy) const; 
+
+	void probabilities(double particle_energy, double &T, double &R) const noexcept; 
+
+	// getters
+	inline bool defined() const { return params_defined; }
+	inline double get_V() const { return V; }
+	inline double get_V_eV() const { return V_eV; }
+
+private:
+	bool params_defined; // boolean to decide if parameters have been assigned to the class
+	double m; // particle mass in units of kg
+	double two_m; // 2 m in units of kg
+	double V; // step height in units of J
+	double V_eV; // step height in units of eV
+	double k_scale; // wavenumber in units of nm^{-1} is k = k_scale * sqrt(E) with E in units of eV
+};
+
+// pot_step holds the current solution and replaces it each time set_params is called
+// Use get_soln() to take an immutable copy that can be shared between threads
+class pot_step {
+public:
+	pot_step();
+	pot_step(double particle_mass, double particle_energy, double step_height);
+
+	void set_params(double particle_mass, double particle_energy, double step_height, bool loud = false);
+
+	void set_energy(double particle_energy); // keep the mass and step height of the last set_params, only E dependent quantities are recomputed
+
+	std::complex<double> wavefunction(double position) const; 
+
+	void wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im) const; 
+
+	// non-throwing batch evaluation, bad positions are flagged in status rather than ending the program
+	int wavefunction(const double *position, int n_positions, double *psi_re, double *psi_im, int *status) const noexcept; 
+
+	void wavefunction_grid(double x_start, double dx, int n_points, double *psi_re, double *psi_im) const; 
+
+	void compute_wavefunction(std::string filename) const; 
+
+	void energy_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results) const; 
+
+	// non-throwing sweep, bad energies are flagged in status rather than ending the program
+	int validate_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, int *status) const noexcept; 
+
+	int energy_sweep(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results, int *status) const noexcept; 
+
+	// getters
+	inline const step_soln& get_soln() const { return soln; }
+	inline const step_structure& get_structure() const { return structure; }
+	inline double get_E() const { return soln.get_E();  }
+	inline double get_V() const { return soln.get_V();  }
+	inline double get_T() const { return soln.get_T();  }
+	inline double get_R() const { return soln.get_R();  }
+
+private:
+	void sweep_kernel(double particle_mass, double step_height, const double *particle_energy, int n_energies, step_sweep &results) const noexcept; 
+
+private:
+	step_structure structure; // mass and step height of the current parameters
+	step_soln soln; // solution for the current parameters
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,261 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the problem batch solvers
+// Each kernel solves problems [start, end) of a batch, the AVX2 loop handles four problems at a time and the scalar loop the remainder
+// In both loops the E > V and E < V results of the step are computed for every lane and the correct one selected, so there are no branches
+
+namespace {
+
+	// wavenumber in units of nm^{-1} is k = K_UNIT sqrt(m E) with m in kg and E in eV
+	const double K_UNIT = ( sqrt(2.0 * template_funcs::convert_ev_J(1.0)) * 1.0e-9 ) / H_BAR_J; 
+
+	void step_kernel(step_batch &b, int start, int end)
+	{
+		const double nan = std::numeric_limits<double>::quiet_NaN(); 
+		int i = start; 
+
+#ifdef __AVX2__
+		const __m256d ku = _mm256_set1_pd(K_UNIT), zero_v = _mm256_setzero_pd(), half = _mm256_set1_pd(0.5); 
+		const __m256d one_v = _mm256_set1_pd(1.0), two = _mm256_set1_pd(2.0), four = _mm256_set1_pd(4.0), sign_bit = _mm256_set1_pd(-0.0); 
+		const __m256d nan_v = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()); 
+
+		for (; i + 4 <= end; i += 4) {
+			__m256d m = _mm256_loadu_pd(&b.mass[i]), E = _mm256_loadu_pd(&b.E[i]), V = _mm256_loadu_pd(&b.V[i]); 
+			__m256d d = _mm256_sub_pd(E, V); 
+			__m256d high = _mm256_cmp_pd(d, zero_v, _CMP_GT_OQ); // lanes with E > V
+			__m256d ok = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(m, zero_v, _CMP_GT_OQ), _mm256_cmp_pd(E, zero_v, _CMP_GT_OQ)), _mm256_cmp_pd(V, zero_v, _CMP_GT_OQ)); // lanes that can be solved
+			__m256d delta = _mm256_andnot_pd(sign_bit, d); // |E - V|
+			__m256d k1 = _mm256_mul_pd(ku, _mm256_sqrt_pd(_mm256_mul_pd(m, E))); 
+			__m256d k2 = _mm256_mul_pd(ku, _mm256_sqrt_pd(_mm256_mul_pd(m, delta))); 
+			__m256d psum = _mm256_add_pd(k1, k2), pdiff = _mm256_sub_pd(k2, k1); 
+			__m256d inv = _mm256_div_pd(one_v, psum); 
+			__m256d hD = _mm256_mul_pd(half, _mm256_sqrt_pd(_mm256_div_pd(delta, E))); // D / 2 = sqrt( (V - E) / E ) / 2
+
+			__m256d T = _mm256_mul_pd(_mm256_mul_pd(four, _mm256_mul_pd(k1, k2)), _mm256_mul_pd(inv, inv)); 
+			__m256d R = _mm256_mul_pd(_mm256_mul_pd(pdiff, pdiff), _mm256_mul_pd(inv, inv)); 
+
+			_mm256_storeu_pd(&b.k1[i], _mm256_blendv_pd(nan_v, k1, ok)); 
+			_mm256_storeu_pd(&b.k2[i], _mm256_blendv_pd(nan_v, k2, ok)); 
+			_mm256_storeu_pd(&b.T[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(zero_v, T, high), ok)); 
+			_mm256_storeu_pd(&b.R[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(one_v, R, high), ok)); 
+			_mm256_storeu_pd(&b.inc_re[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(half, one_v, high), ok)); 
+			_mm256_storeu_pd(&b.inc_im[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(hD, zero_v, high), ok)); 
+			_mm256_storeu_pd(&b.ref_re[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(half, _mm256_mul_pd(pdiff, inv), high), ok)); 
+			_mm256_storeu_pd(&b.ref_im[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(_mm256_xor_pd(hD, sign_bit), zero_v, high), ok)); 
+			_mm256_storeu_pd(&b.trn_re[i], _mm256_blendv_pd(nan_v, _mm256_blendv_pd(one_v, _mm256_mul_pd(_mm256_mul_pd(two, k1), inv), high), ok)); 
+			_mm256_storeu_pd(&b.trn_im[i], _mm256_blendv_pd(nan_v, zero_v, ok)); 
+		}
+#endif
+
+		for (; i < end; i++) {
+			double E = b.E[i], V = b.V[i], m = b.mass[i]; 
+			double delta = fabs(E - V); 
+			bool high = E > V; 
+			double k1 = K_UNIT * sqrt(m * E); 
+			double k2 = K_UNIT * sqrt(m * delta); 
+			double psum = k1 + k2, pdiff = k2 - k1; 
+			double hD = 0.5 * sqrt(delta / E); 
+			double bad = (m > 0.0 && E > 0.0 && V > 0.0) ? 0.0 : nan; // adding bad turns every output of an unsolvable problem into NaN
+
+			b.k1[i] = k1 + bad; 
+			b.k2[i] = k2 + bad; 
+			b.T[i] = (high ? (4.0 * k1 * k2) / (psum * psum) : 0.0) + bad; 
+			b.R[i] = (high ? (pdiff * pdiff) / (psum * psum) : 1.0) + bad; 
+			b.inc_re[i] = (high ? 1.0 : 0.5) + bad; 
+			b.inc_im[i] = (high ? 0.0 : hD) + bad; 
+			b.ref_re[i] = (high ? pdiff / psum : 0.5) + bad; 
+			b.ref_im[i] = (high ? 0.0 : -hD) + bad; 
+			b.trn_re[i] = (high ? (2.0 * k1) / psum : 1.0) + bad; 
+			b.trn_im[i] = 0.0 + bad; 
+		}
+	}
+
+	void barr_kernel(barr_batch &b, int start, int end)
+	{
+		// same real arithmetic as pot_barr::sweep_kernel with the mass, height and width read per problem
+
+		const double nan = std::numeric_limits<double>::quiet_NaN(); 
+		int i = start; 
+
+#ifdef __AVX2__
+		const __m256d ku = _mm256_set1_pd(K_UNIT), half = _mm256_set1_pd(0.5), one_v = _mm256_set1_pd(1.0), zero_v = _mm256_setzero_pd(); 
+		const __m256d nan_v = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()); 
+
+		for (; i + 4 <= end; i += 4) {
+			__m256d m = _mm256_loadu_pd(&b.mass[i]), E = _mm256_loadu_pd(&b.E[i]), V = _mm256_loadu_pd(&b.V[i]), W = _mm256_loadu_pd(&b.W[i]); 
+			__m256d ok = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(m, zero_v, _CMP_GT_OQ), _mm256_cmp_pd(E, zero_v, _CMP_GT_OQ)), 
+				_mm256_and_pd(_mm256_cmp_pd(V, E, _CMP_GT_OQ), _mm256_cmp_pd(W, zero_v, _CMP_GT_OQ))); // lanes that can be solved
+			__m256d k1 = _mm256_mul_pd(ku, _mm256_sqrt_pd(_mm256_mul_pd(m, E))); 
+			__m256d k2 = _mm256_mul_pd(ku, _mm256_sqrt_pd(_mm256_mul_pd(m, _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(V, E))))); // |V - E|
+			__m256d a = _mm256_div_pd(k1, k2), bb = _mm256_div_pd(k2, k1); 
+			__m256d s, c; 
+			simd_funcs::sincos_pd(_mm256_mul_pd(k1, W), s, c); 
+			__m256d ep = simd_funcs::exp_pd(_mm256_mul_pd(k2, W)); 
+			__m256d hem = _mm256_div_pd(half, ep), hep = _mm256_mul_pd(half, ep); 
+
+			__m256d as = _mm256_mul_pd(a, s), ac = _mm256_mul_pd(a, c); 
+			__m256d bb_re = _mm256_mul_pd(hem, _mm256_sub_pd(c, as)), bb_im = _mm256_mul_pd(hem, _mm256_add_pd(s, ac)); 
+			__m256d cc_re = _mm256_mul_pd(hep, _mm256_add_pd(c, as)), cc_im = _mm256_mul_pd(hep, _mm256_sub_pd(s, ac)); 
+
+			__m256d bcr = _mm256_mul_pd(bb, cc_re), bci = _mm256_mul_pd(bb, cc_im), bbr = _mm256_mul_pd(bb, bb_re), bbi = _mm256_mul_pd(bb, bb_im); 
+			__m256d dd_re = _mm256_mul_pd(half, _mm256_add_pd(_mm256_sub_pd(cc_re, bci), _mm256_add_pd(bb_re, bbi))); 
+			__m256d dd_im = _mm256_mul_pd(half, _mm256_add_pd(_mm256_add_pd(cc_im, bcr), _mm256_sub_pd(bb_im, bbr))); 
+			__m256d ee_re = _mm256_mul_pd(half, _mm256_add_pd(_mm256_add_pd(cc_re, bci), _mm256_sub_pd(bb_re, bbi))); 
+			__m256d ee_im = _mm256_mul_pd(half, _mm256_add_pd(_mm256_sub_pd(cc_im, bcr), _mm256_add_pd(bb_im, bbr))); 
+			__m256d inv_dd = _mm256_div_pd(one_v, _mm256_add_pd(_mm256_mul_pd(dd_re, dd_re), _mm256_mul_pd(dd_im, dd_im))); 
+
+			_mm256_storeu_pd(&b.k1[i], _mm256_blendv_pd(nan_v, k1, ok)); 
+			_mm256_storeu_pd(&b.k2[i], _mm256_blendv_pd(nan_v, k2, ok)); 
+			_mm256_storeu_pd(&b.BB_re[i], _mm256_blendv_pd(nan_v, bb_re, ok)); _mm256_storeu_pd(&b.BB_im[i], _mm256_blendv_pd(nan_v, bb_im, ok)); 
+			_mm256_storeu_pd(&b.CC_re[i], _mm256_blendv_pd(nan_v, cc_re, ok)); _mm256_storeu_pd(&b.CC_im[i], _mm256_blendv_pd(nan_v, cc_im, ok)); 
+			_mm256_storeu_pd(&b.DD_re[i], _mm256_blendv_pd(nan_v, dd_re, ok)); _mm256_storeu_pd(&b.DD_im[i], _mm256_blendv_pd(nan_v, dd_im, ok)); 
+			_mm256_storeu_pd(&b.EE_re[i], _mm256_blendv_pd(nan_v, ee_re, ok)); _mm256_storeu_pd(&b.EE_im[i], _mm256_blendv_pd(nan_v, ee_im, ok)); 
+			_mm256_storeu_pd(&b.T[i], _mm256_blendv_pd(nan_v, inv_dd, ok)); 
+			_mm256_storeu_pd(&b.R[i], _mm256_blendv_pd(nan_v, _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(ee_re, ee_re), _mm256_mul_pd(ee_im, ee_im)), inv_dd), ok)); 
+		}
+#endif
+
+		for (; i < end; i++) {
+			double m = b.mass[i], E = b.E[i], V = b.V[i], W = b.W[i]; 
+			double k1 = K_UNIT * sqrt(m * E); 
+			double k2 = K_UNIT * sqrt(m * fabs(V - E)); // |V - E| keeps NaN out of sin, cos and exp for E > V, those problems are blanked by bad
+			double a = k1 / k2, bb = k2 / k1; 
+			double c = cos(k1 * W), s = sin(k1 * W); 
+			double ep = exp(k2 * W), em = 1.0 / ep; 
+			double bad = (m > 0.0 && E > 0.0 && V > E && W > 0.0) ? 0.0 : nan; 
+
+			double bb_re = 0.5 * em * (c - a * s), bb_im = 0.5 * em * (s + a * c); 
+			double cc_re = 0.5 * ep * (c + a * s), cc_im = 0.5 * ep * (s - a * c); 
+			double dd_re = 0.5 * ( (cc_re - bb * cc_im) + (bb_re + bb * bb_im) ); 
+			double dd_im = 0.5 * ( (cc_im + bb * cc_re) + (bb_im - bb * bb_re) ); 
+			double ee_re = 0.5 * ( (cc_re + bb * cc_im) + (bb_re - bb * bb_im) ); 
+			double ee_im = 0.5 * ( (cc_im - bb * cc_re) + (bb_im + bb * bb_re) ); 
+			double dd_sqr = dd_re * dd_re + dd_im * dd_im; 
+
+			b.k1[i] = k1 + bad; 
+			b.k2[i] = k2 + bad; 
+			b.BB_re[i] = bb_re + bad; b.BB_im[i] = bb_im + bad; 
+			b.CC_re[i] = cc_re + bad; b.CC_im[i] = cc_im + bad; 
+			b.DD_re[i] = dd_re + bad; b.DD_im[i] = dd_im + bad; 
+			b.EE_re[i] = ee_re + bad; b.EE_im[i] = ee_im + bad; 
+			b.T[i] = 1.0 / dd_sqr + bad; 
+			b.R[i] = (ee_re * ee_re + ee_im * ee_im) / dd_sqr + bad; 
+		}
+	}
+
+	int step_check(step_batch &b, int start, int end)
+	{
+		// status of the problems [start, end), the kernel has already set the results of unsolvable problems to NaN
+		// returns the number of problems flagged
+
+		int n_bad = 0; 
+
+		for (int i = start; i < end; i++) {
+			b.status[i] = (b.mass[i] > 0.0 ? EVAL_OK : EVAL_BAD_MASS) | (b.E[i] > 0.0 ? EVAL_OK : EVAL_BAD_ENERGY) | (b.V[i] > 0.0 ? EVAL_OK : EVAL_BAD_HEIGHT); 
+			n_bad += (b.status[i] != EVAL_OK); 
+		}
+
+		return n_bad; 
+	}
+
+	int barr_check(barr_batch &b, int start, int end)
+	{
+		int n_bad = 0; 
+
+		for (int i = start; i < end; i++) {
+			b.status[i] = (b.mass[i] > 0.0 ? EVAL_OK : EVAL_BAD_MASS) | (b.E[i] > 0.0 ? EVAL_OK : EVAL_BAD_ENERGY) | (b.V[i] > b.E[i] ? EVAL_OK : EVAL_BAD_HEIGHT) | (b.W[i] > 0.0 ? EVAL_OK : EVAL_BAD_WIDTH); 
+			n_bad += (b.status[i] != EVAL_OK); 
+		}
+
+		return n_bad; 
+	}
+
+	template <class Batch, class Kernel, class Check> int solve_blocks(Batch &batch, Kernel kernel, Check check, int n_threads)
+	{
+		// run kernel then check on blocks of BATCH_BLOCK problems, blocks are shared out between threads
+
+		int n = batch.size(), n_blocks = (n + batch_funcs::BATCH_BLOCK - 1) / batch_funcs::BATCH_BLOCK; 
+		std::vector<int> n_bad(n_blocks, 0); 
+
+		parallel_funcs::parallel_for(n_blocks, [&](int blk) {
+			int start = blk * batch_funcs::BATCH_BLOCK, end = std::min(n, start + batch_funcs::BATCH_BLOCK); 
+			kernel(batch, start, end); 
+			n_bad[blk] = check(batch, start, end); 
+		}, n_threads); 
+
+		int total = 0; 
+		for (int blk = 0; blk < n_blocks; blk++) total += n_bad[blk]; 
+
+		return total; 
+	}
+}
+
+void step_batch::resize(int n_problems)
+{
+	// allocate space for n_problems problems, inputs and outputs
+
+	mass.resize(n_problems); E.resize(n_problems); V.resize(n_problems); 
+	status.resize(n_problems); T.resize(n_problems); R.resize(n_problems); 
+	k1.resize(n_problems); k2.resize(n_problems); 
+	inc_re.resize(n_problems); inc_im.resize(n_problems); 
+	ref_re.resize(n_problems); ref_im.resize(n_problems); 
+	trn_re.resize(n_problems); trn_im.resize(n_problems); 
+}
+
+void barr_batch::resize(int n_problems)
+{
+	// allocate space for n_problems problems, inputs and outputs
+
+	mass.resize(n_problems); E.resize(n_problems); V.resize(n_problems); W.resize(n_problems); 
+	status.resize(n_problems); T.resize(n_problems); R.resize(n_problems); 
+	k1.resize(n_problems); k2.resize(n_problems); 
+	BB_re.resize(n_problems); BB_im.resize(n_problems); 
+	CC_re.resize(n_problems); CC_im.resize(n_problems); 
+	DD_re.resize(n_problems); DD_im.resize(n_problems); 
+	EE_re.resize(n_problems); EE_im.resize(n_problems); 
+}
+
+int batch_funcs::solve(step_batch &batch, int n_threads) noexcept
+{
+	// solve every potential step problem in the batch
+	// the input arrays must all be the same size, which is the case when the batch was sized with resize
+	// returns the number of problems flagged in batch.status, or -1 if the input arrays differ in size
+
+	int n = batch.size(); 
+
+	if (static_cast<int>(batch.mass.size()) != n || static_cast<int>(batch.V.size()) != n) return -1; 
+
+	if (static_cast<int>(batch.T.size()) != n) {
+		try {
+			batch.resize(n); 
+		}
+		catch (std::bad_alloc&) {
+			return -1; 
+		}
+	}
+
+	return solve_blocks(batch, step_kernel, step_check, n_threads); 
+}
+
+int batch_funcs::solve(barr_batch &batch, int n_threads) noexcept
+{
+	// solve every potential barrier problem in the batch, problems with E >= V are flagged with EVAL_BAD_HEIGHT
+	// returns the number of problems flagged in batch.status, or -1 if the input arrays differ in size
+
+	int n = batch.size(); 
+
+	if (static_cast<int>(batch.mass.size()) != n || static_cast<int>(batch.V.size()) != n || static_cast<int>(batch.W.size()) != n) return -1; 
+
+	if (static_cast<int>(batch.T.size()) != n) {
+		try {
+			batch.resize(n); 
+		}
+		catch (std::bad_alloc&) {
+			return -1; 
+		}
+	}
+
+	return solve_blocks(batch, barr_kernel, barr_check, n_threads); 
+}
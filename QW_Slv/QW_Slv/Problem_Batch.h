@@ -0,0 +1,60 @@
+#ifndef PROBLEM_BATCH_H
+#define PROBLEM_BATCH_H
+
+// Structure-of-arrays batches of independent potential step and barrier problems, each with its own mass, energy and potential
+// Element i of every array belongs to the i^{th} problem, so a design space scan is a single call rather than one set_params per point
+// The solvers work on four problems per AVX2 instruction when compiled with AVX2 enabled, otherwise a branch free scalar loop is used
+// Units and amplitudes are those of step_sweep and barr_sweep: masses in kg, energies in eV, widths in nm, wavenumbers in nm^{-1}
+
+struct step_batch {
+	void resize(int n_problems); 
+
+	inline int size() const { return static_cast<int>(E.size()); }
+
+	// inputs
+	std::vector<double> mass; // particle mass in units of kg
+	std::vector<double> E; // particle energy in units of eV
+	std::vector<double> V; // step height in units of eV
+
+	// outputs, E > V and E < V lanes are computed together and the results selected with a mask
+	std::vector<int> status; // eval_status flags, results are NaN where status is not EVAL_OK
+	std::vector<double> T, R; // transmission and reflection probabilities
+	std::vector<double> k1, k2; // wavenumber before step, wavenumber (E > V) or decay constant (E < V) after step
+	std::vector<double> inc_re, inc_im; // incident amplitude, B when E > V, CC when E < V
+	std::vector<double> ref_re, ref_im; // reflected amplitude, C when E > V, DD when E < V
+	std::vector<double> trn_re, trn_im; // transmitted amplitude, A when E > V, B when E < V
+};
+
+struct barr_batch {
+	void resize(int n_problems);
+
+	inline int size() const { return static_cast<int>(E.size()); }
+
+	// inputs
+	std::vector<double> mass; // particle mass in units of kg
+	std::vector<double> E; // particle energy in units of eV
+	std::vector<double> V; // barrier height in units of eV, must exceed E
+	std::vector<double> W; // barrier width in units of nm
+
+	// outputs
+	std::vector<int> status; // eval_status flags, results are NaN where status is not EVAL_OK
+	std::vector<double> T, R; // transmission and reflection probabilities
+	std::vector<double> k1, k2; // wavenumber outside barrier, decay constant within barrier
+	std::vector<double> BB_re, BB_im; // growing amplitude within barrier
+	std::vector<double> CC_re, CC_im; // decaying amplitude within barrier
+	std::vector<double> DD_re, DD_im; // incident amplitude
+	std::vector<double> EE_re, EE_im; // reflected amplitude
+};
+
+namespace batch_funcs{
+
+	static const int BATCH_BLOCK = 1024; // problems per thread work item
+
+	// solve every problem in the batch, the inputs are checked lane by lane as in pot_step::validate_sweep and never stop the program
+	// returns the number of problems that could not be solved
+	int solve(step_batch &batch, int n_threads = 0) noexcept; 
+
+	int solve(barr_batch &batch, int n_threads = 0) noexcept; 
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef ROOT_FINDER_H
+#define ROOT_FINDER_H
+
+// Root finding for functions of one variable on a bracketing interval
+// Brent's method combines inverse quadratic interpolation with bisection, so it converges superlinearly on smooth
+// functions and never takes more than a few times the number of bisection steps on awkward ones
+// Based on zbrent from Numerical Recipes in C, 2nd ed., section 9.3
+// When a good starting guess is available, e.g. from a neighbouring problem in a parameter sweep, Newton's method safeguarded
+// by the bracket converges in two or three steps, based on rtsafe from Numerical Recipes in C, 2nd ed., section 9.4
+
+namespace root_funcs{
+
+	template <class Func> double brent(Func func, double a, double b, double fa, double fb, double tol, int &iter, int max_iter = 100)
+	{
+		// find a root of func in [a, b], fa = func(a) and fb = func(b) must have opposite signs
+		// passing the end point values lets callers reuse values they have already computed
+		// the root is located to within tol, iter returns the number of calls made to func
+		// if the signs of fa, fb are the same NaN is returned and iter is set to zero
+
+		iter = 0; 
+
+		if ( (fa > 0.0 && fb > 0.0) || (fa < 0.0 && fb < 0.0) ) return std::numeric_limits<double>::quiet_NaN(); 
+		if (fa == 0.0) return a; 
+		if (fb == 0.0) return b; 
+
+		double c = b, fc = fb, d = 0.0, e = 0.0, min1, min2, p, q, r, s, tol1, xm; 
+
+		while (iter < max_iter) {
+			if ( (fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0) ) {
+				c = a; fc = fa; // rename a, b, c and adjust the bounding interval d
+				e = d = b - a; 
+			}
+			if (fabs(fc) < fabs(fb)) {
+				a = b; b = c; c = a; 
+				fa = fb; fb = fc; fc = fa; 
+			}
+
+			tol1 = 2.0 * EPS * fabs(b) + 0.5 * tol; // convergence check
+			xm = 0.5 * (c - b); 
+			if (fabs(xm) <= tol1 || fb == 0.0) return b; 
+
+			if (fabs(e) >= tol1 && fabs(fa) > fabs(fb)) {
+				s = fb / fa; // attempt inverse quadratic interpolation
+				if (a == c) {
+					p = 2.0 * xm * s; 
+					q = 1.0 - s; 
+				}
+				else {
+					q = fa / fc; 
+					r = fb / fc; 
+					p = s * (2.0 * xm * q * (q - r) - (b - a) * (r - 1.0)); 
+					q = (q - 1.0) * (r - 1.0) * (s - 1.0); 
+				}
+				if (p > 0.0) q = -q; // check whether in bounds
+				p = fabs(p); 
+				min1 = 3.0 * xm * q - fabs(tol1 * q); 
+				min2 = fabs(e * q); 
+				if (2.0 * p < (min1 < min2 ? min1 : min2)) {
+					e = d; // accept interpolation
+					d = p / q; 
+				}
+				else {
+					d = xm; // interpolation failed, use bisection
+					e = d; 
+				}
+			}
+			else {
+				d = xm; // bounds decreasing too slowly, use bisection
+				e = d; 
+			}
+
+			a = b; // move last best guess to a
+			fa = fb; 
+			b += ( fabs(d) > tol1 ? d : template_funcs::SIGN(tol1, xm) ); // evaluate new trial root
+			fb = func(b); 
+			iter++; 
+		}
+
+		return b; // maximum number of iterations reached, b is the best estimate
+	}
+
+	template <class FuncDeriv> double newton_bracketed(FuncDeriv funcd, double a, double b, bool positive_at_a, double x, double tol, int &iter, int max_iter = 100)
+	{
+		// find the root of a function that changes sign once in [a, b], starting from the guess x
+		// funcd(x, f, df) sets f and df to the function value and its derivative at x
+		// only the sign of the function at a is needed to orient the bracket, so no calls are spent on the end points
+		// Newton steps that would leave the bracket, or that fail to halve the previous step, are replaced by bisection
+		// the root is located to within tol, iter returns the number of calls made to funcd
+		// a guess outside (a, b) is replaced by the midpoint
+
+		double lo = positive_at_a ? b : a, hi = positive_at_a ? a : b; // f(lo) < 0 < f(hi)
+		double dx_old = fabs(b - a), dx = dx_old, f, df; 
+
+		if ( !(x > std::min(a, b) && x < std::max(a, b)) ) x = 0.5 * (a + b); 
+
+		funcd(x, f, df); 
+		iter = 1; 
+
+		while (iter < max_iter) {
+			if (f == 0.0) return x; 
+
+			if (f < 0.0) lo = x; else hi = x; 
+
+			if ( ((x - hi) * df - f) * ((x - lo) * df - f) > 0.0 || fabs(2.0 * f) > fabs(dx_old * df) ) {
+				dx_old = dx; // Newton out of range or too slow, bisect
+				dx = 0.5 * (hi - lo); 
+				x = lo + dx; 
+			}
+			else {
+				dx_old = dx; 
+				dx = f / df; 
+				x -= dx; 
+			}
+
+			if (fabs(dx) < tol) return x; 
+
+			funcd(x, f, df); 
+			iter++; 
+		}
+
+		return x; // maximum number of iterations reached, x is the best estimate
+	}
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the methods declared in Separable_Box.h
+
+const double sep_box::DEGENERACY_TOL = 1.0e-10; 
+
+sep_box::sep_box()
+{
+	// Default constructor, every direction unconfined
+
+	for (int a = 0; a < 3; a++) type[a] = UNCONFINED; 
+}
+
+void sep_box::check_axis(int axis, std::string caller) const
+{
+	// throw if axis is not one of 0, 1, 2
+
+	if (axis < 0 || axis > 2) {
+		std::string reason = "Error: " + caller + "\n"; 
+		reason += "axis must be 0, 1 or 2\n"; 
+		throw std::invalid_argument(reason); 
+	}
+}
+
+void sep_box::set_direction(int axis, const inf_well &well)
+{
+	// confine the particle along axis with an infinite well
+
+	try{
+		check_axis(axis, "void sep_box::set_direction(int axis, const inf_well &well)"); 
+
+		type[axis] = INFINITE_WELL; 
+		inf[axis] = well; 
+		factor[axis].clear(); 
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void sep_box::set_direction(int axis, const fin_well &well)
+{
+	// confine the particle along axis with a finite well
+
+	try{
+		check_axis(axis, "void sep_box::set_direction(int axis, const fin_well &well)"); 
+
+		type[axis] = FINITE_WELL; 
+		fin[axis] = well; 
+		factor[axis].clear(); 
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void sep_box::clear_direction(int axis)
+{
+	// leave the particle free along axis
+
+	try{
+		check_axis(axis, "void sep_box::clear_direction(int axis)"); 
+
+		type[axis] = UNCONFINED; 
+		factor[axis].clear(); 
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+double sep_box::level_energy(int axis, int i) const
+{
+	// 1D energy of level i, counted from 0, along axis
+
+	switch (type[axis]) {
+	case INFINITE_WELL: 
+		return inf[axis].energy_eigenvalue(i + 1); 
+	case FINITE_WELL: 
+		return ( i < fin[axis].get_n_states() ? fin[axis].energy_eigenvalue(i) : std::numeric_limits<double>::infinity() ); 
+	default: 
+		return ( i == 0 ? 0.0 : std::numeric_limits<double>::infinity() ); 
+	}
+}
+
+double sep_box::level_function(int axis, int i, double position) const
+{
+	// 1D factor of level i, counted from 0, along axis, zero outside an infinite well
+
+	switch (type[axis]) {
+	case INFINITE_WELL: 
+		return ( fabs(position - inf[axis].get_centre()) < 0.5 * inf[axis].get_L() ? inf[axis].energy_eigenfunction(i + 1, position) : 0.0 ); 
+	case FINITE_WELL: 
+		return fin[axis].energy_eigenfunction(i, position); 
+	default: 
+		return 1.0; 
+	}
+}
+
+void sep_box::lowest_states(int n_states, std::vector<box_state> &states) const
+{
+	// the lowest n_states states by a min-heap search over the sorted 1D levels
+	// (i + 1, j, k) is always pushed, (0, j + 1, k) only from i = 0, (0, 0, k + 1) only from i = j = 0, 
+	// which pushes each triple once from its unique parent, and a child never lies below its parent, so states leave the heap in order
+	// after n_states states the search continues while the energy matches the last one so the last degeneracy is complete
+
+	typedef std::pair<double, std::array<int, 3>> candidate; 
+
+	states.clear(); 
+
+	if (n_states < 1) return; 
+
+	std::priority_queue<candidate, std::vector<candidate>, std::greater<candidate>> heap; 
+
+	auto push = [&](int i, int j, int k) {
+		double E = level_energy(0, i) + level_energy(1, j) + level_energy(2, k); 
+		if (E < std::numeric_limits<double>::infinity()) heap.push(candidate(E, std::array<int, 3>{ { i, j, k } })); 
+	}; 
+
+	push(0, 0, 0); 
+
+	while (!heap.empty()) {
+		candidate c = heap.top(); 
+
+		if (static_cast<int>(states.size()) >= n_states && c.first > states.back().E * (1.0 + DEGENERACY_TOL)) break; 
+
+		heap.pop(); 
+
+		const std::array<int, 3> &t = c.second; 
+		box_state s; 
+		s.E = c.first; 
+		s.degeneracy = 1; 
+		for (int a = 0; a < 3; a++) {
+			s.index[a] = t[a]; 
+			s.n[a] = type[a] == INFINITE_WELL ? t[a] + 1 : t[a]; 
+		}
+		states.push_back(s); 
+
+		push(t[0] + 1, t[1], t[2]); 
+		if (t[0] == 0) push(0, t[1] + 1, t[2]); 
+		if (t[0] == 0 && t[1] == 0) push(0, 0, t[2] + 1); 
+	}
+
+	// group equal energies, then drop the states that were only needed to count the last degeneracy
+	for (size_t first = 0; first < states.size(); ) {
+		size_t last = first + 1; 
+		while (last < states.size() && states[last].E <= states[first].E * (1.0 + DEGENERACY_TOL)) last++; 
+		for (size_t s = first; s < last; s++) states[s].degeneracy = static_cast<int>(last - first); 
+		first = last; 
+	}
+
+	if (static_cast<int>(states.size()) > n_states) states.resize(n_states); 
+}
+
+double sep_box::wavefunction(const box_state &state, double x, double y, double z) const
+{
+	// psi(x, y, z) = psi_{i}(x) psi_{j}(y) psi_{k}(z)
+
+	return ( level_function(0, state.index[0], x) * level_function(1, state.index[1], y) * level_function(2, state.index[2], z) ); 
+}
+
+void sep_box::set_grid(int axis, const std::vector<double> &positions)
+{
+	// positions along axis at which wavefunction_grid evaluates the states
+
+	try{
+		check_axis(axis, "void sep_box::set_grid(int axis, const std::vector<double> &positions)"); 
+
+		grid[axis] = positions; 
+		factor[axis].clear(); 
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void sep_box::wavefunction_grid(const box_state &state, std::vector<double> &psi)
+{
+	// psi on the product grid as the outer product of the three 1D factors
+	// a missing factor along a well is filled with every level up to the one requested, at least doubling the number held, 
+	// using the table methods of inf_well and fin_well, so a run over the lowest states makes only a few table calls per direction
+
+	const double *f[3]; 
+	int n_pts[3]; 
+	double one = 1.0; 
+
+	for (int a = 0; a < 3; a++) {
+		int i = state.index[a], m = static_cast<int>(grid[a].size()); 
+
+		if (type[a] == UNCONFINED || m == 0) {
+			f[a] = &one; 
+			n_pts[a] = 1; 
+			continue; 
+		}
+
+		std::vector<std::vector<double>> &rows = factor[a]; 
+
+		if (i >= static_cast<int>(rows.size()) || rows[i].empty()) {
+			int n_rows = std::max(i + 1, 2 * static_cast<int>(rows.size())); 
+			if (type[a] == FINITE_WELL) n_rows = std::min(n_rows, fin[a].get_n_states()); 
+
+			std::vector<double> table(static_cast<size_t>(n_rows) * m); 
+
+			if (type[a] == INFINITE_WELL) {
+				inf[a].energy_eigenfunction_table(&grid[a][0], m, n_rows, &table[0]); 
+			}
+			else {
+				fin[a].energy_eigenfunction_table(&grid[a][0], m, 0, n_rows, &table[0]); 
+			}
+
+			rows.resize(n_rows); 
+			for (int r = 0; r < n_rows; r++) rows[r].assign(table.begin() + static_cast<size_t>(r) * m, table.begin() + static_cast<size_t>(r + 1) * m); 
+		}
+
+		f[a] = &rows[i][0]; 
+		n_pts[a] = m; 
+	}
+
+	psi.resize(static_cast<size_t>(n_pts[0]) * n_pts[1] * n_pts[2]); 
+
+	for (int ix = 0; ix < n_pts[0]; ix++) {
+		for (int iy = 0; iy < n_pts[1]; iy++) {
+			double fxy = f[0][ix] * f[1][iy]; 
+			double *row = &psi[(static_cast<size_t>(ix) * n_pts[1] + iy) * n_pts[2]]; 
+			for (int iz = 0; iz < n_pts[2]; iz++) row[iz] = fxy * f[2][iz]; 
+		}
+	}
+}
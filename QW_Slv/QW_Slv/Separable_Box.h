@@ -0,0 +1,65 @@
+#ifndef SEPARABLE_BOX_H
+#define SEPARABLE_BOX_H
+
+// Rectangular boxes, wires and dots whose confining potential is a sum of 1D wells along x, y and z
+// The states are products psi(x, y, z) = psi_{i}(x) psi_{j}(y) psi_{k}(z) of 1D states with energy E = E_{i} + E_{j} + E_{k}
+// Each direction takes an inf_well or a fin_well, a direction left unconfined contributes E = 0 and a factor 1, 
+// so two confined directions describe the subband edges of a wire and three describe a box or dot
+// The lowest states are found without enumerating every (i, j, k): the 1D levels are sorted, so starting from (0, 0, 0) a min-heap 
+// always holds the next candidate, every triple has the unique parent (i-1, j, k), else (0, j-1, k), else (0, 0, k-1) 
+// and is pushed only by that parent, so no triple is generated twice and finding the lowest n states costs O(n log n)
+// Wavefunctions on a grid are products of 1D factors, each 1D factor is computed the first time a state needs it and kept
+
+struct box_state {
+	double E; // energy expressed in eV
+	int n[3]; // quantum number along x, y, z, counted as in the 1D solver: from 1 for inf_well, from 0 for fin_well, 0 if unconfined
+	int index[3]; // position of the 1D level in its sorted list, counted from 0
+	int degeneracy; // number of states with the same energy, including any beyond those requested
+}; 
+
+class sep_box{
+public:
+	sep_box(); 
+
+	// axis = 0, 1, 2 for x, y, z, a copy of the well is kept
+	void set_direction(int axis, const inf_well &well); 
+
+	void set_direction(int axis, const fin_well &well); 
+
+	void clear_direction(int axis); 
+
+	// the lowest n_states states in order of increasing energy, fewer if the fin_wells do not have enough bound states
+	void lowest_states(int n_states, std::vector<box_state> &states) const; 
+
+	// value of the normalised state at (x, y, z), positions in units of nm
+	double wavefunction(const box_state &state, double x, double y, double z) const; 
+
+	// grid along one direction, used by wavefunction_grid, setting a grid discards the 1D factors cached for that direction
+	void set_grid(int axis, const std::vector<double> &positions); 
+
+	// the state on the product of the three grids, psi[(ix * n_y + iy) * n_z + iz], an unconfined direction or one with no grid has one point
+	// 1D factors are computed when first needed and cached, so the method is not const
+	void wavefunction_grid(const box_state &state, std::vector<double> &psi); 
+
+	static const double DEGENERACY_TOL; // states whose energies differ by less than this relative amount are counted as degenerate
+
+private:
+	// 1D energy of level i along axis in eV, infinity past the last bound state
+	double level_energy(int axis, int i) const; 
+
+	double level_function(int axis, int i, double position) const; 
+
+	void check_axis(int axis, std::string caller) const; 
+
+private:
+	enum confinement { UNCONFINED, INFINITE_WELL, FINITE_WELL }; 
+
+	confinement type[3]; // confinement along each direction
+	inf_well inf[3]; // used when type is INFINITE_WELL
+	fin_well fin[3]; // used when type is FINITE_WELL
+
+	std::vector<double> grid[3]; // positions along each direction for wavefunction_grid
+	std::vector<std::vector<double>> factor[3]; // factor[a][i] is 1D level i on grid[a], empty until it is needed
+}; 
+
+#endif
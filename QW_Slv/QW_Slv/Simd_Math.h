@@ -0,0 +1,110 @@
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+// AVX2 versions of sin, cos and exp acting on four doubles at a time
+// Range reductions and polynomial coefficients are those of the Cephes library
+// Accuracy is within a few ulp of the standard library for |x| < 1.0e8 (sin, cos) and all finite x (exp)
+// Only available when compiled with AVX2 enabled (/arch:AVX2, -mavx2), callers must provide a scalar fallback
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace simd_funcs{
+
+	// reduce x to z = x - n pi/2 with |z| <= pi/4 and return sin(x), cos(x)
+	inline void sincos_pd(__m256d x, __m256d &sin_x, __m256d &cos_x)
+	{
+		const __m256d two_over_pi = _mm256_set1_pd(0.63661977236758134308);
+		const __m256d DP1 = _mm256_set1_pd(2.0 * 7.85398125648498535156E-1); // pi / 2 split into three parts
+		const __m256d DP2 = _mm256_set1_pd(2.0 * 3.77489470793079817668E-8);
+		const __m256d DP3 = _mm256_set1_pd(2.0 * 2.69515142907905952645E-15);
+		const __m256d sign_bit = _mm256_set1_pd(-0.0);
+
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(x, two_over_pi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d z = _mm256_sub_pd(x, _mm256_mul_pd(n, DP1));
+		z = _mm256_sub_pd(z, _mm256_mul_pd(n, DP2));
+		z = _mm256_sub_pd(z, _mm256_mul_pd(n, DP3));
+		__m256d zz = _mm256_mul_pd(z, z);
+
+		// sin(z) = z + z^{3} P(z^{2})
+		__m256d ps = _mm256_set1_pd(1.58962301576546568060E-10);
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(-2.50507477628578072866E-8));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(2.75573136213857245213E-6));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(-1.98412698295895385996E-4));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(8.33333333332211858878E-3));
+		ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(-1.66666666666666307295E-1));
+		__m256d s = _mm256_add_pd(z, _mm256_mul_pd(_mm256_mul_pd(z, zz), ps));
+
+		// cos(z) = 1 - z^{2} / 2 + z^{4} Q(z^{2})
+		__m256d pc = _mm256_set1_pd(-1.13585365213876817300E-11);
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(2.08757008419747316778E-9));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(-2.75573141792967388112E-7));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(2.48015872888517045348E-5));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(-1.38888888888730564116E-3));
+		pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(4.16666666666665929218E-2));
+		__m256d c = _mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(_mm256_set1_pd(0.5), zz));
+		c = _mm256_add_pd(c, _mm256_mul_pd(_mm256_mul_pd(zz, zz), pc));
+
+		// quadrant q = n mod 4 decides which polynomial is used and its sign
+		__m128i q = _mm256_cvtpd_epi32(n);
+		__m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+		__m256d swap = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_and_si128(q, one), one)));
+		__m256d neg_s = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_and_si128(q, two), two)));
+		__m256d neg_c = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), two)));
+
+		sin_x = _mm256_blendv_pd(s, c, swap);
+		cos_x = _mm256_blendv_pd(c, s, swap);
+		sin_x = _mm256_xor_pd(sin_x, _mm256_and_pd(neg_s, sign_bit));
+		cos_x = _mm256_xor_pd(cos_x, _mm256_and_pd(neg_c, sign_bit));
+	}
+
+	// exp(x) = 2^{n} exp(r) with |r| <= ln(2) / 2, exp(r) from a Pade approximant
+	inline __m256d exp_pd(__m256d x)
+	{
+		const __m256d MAXLOG = _mm256_set1_pd(7.09782712893383996843E2);
+		const __m256d MINLOG = _mm256_set1_pd(-7.451332191019412076235E2);
+		const __m256d LOG2E = _mm256_set1_pd(1.4426950408889634073599);
+		const __m256d C1 = _mm256_set1_pd(6.93145751953125E-1); // ln(2) split into two parts
+		const __m256d C2 = _mm256_set1_pd(1.42860682030941723212E-6);
+
+		__m256d over = _mm256_cmp_pd(x, MAXLOG, _CMP_GT_OQ);
+		__m256d under = _mm256_cmp_pd(x, MINLOG, _CMP_LT_OQ);
+		__m256d nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q); // the clamp below would turn NaN into a finite bound
+		__m256d xc = _mm256_min_pd(_mm256_max_pd(x, MINLOG), MAXLOG);
+
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(xc, LOG2E), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = _mm256_sub_pd(xc, _mm256_mul_pd(n, C1));
+		r = _mm256_sub_pd(r, _mm256_mul_pd(n, C2));
+		__m256d rr = _mm256_mul_pd(r, r);
+
+		__m256d pp = _mm256_set1_pd(1.26177193074810590878E-4);
+		pp = _mm256_add_pd(_mm256_mul_pd(pp, rr), _mm256_set1_pd(3.02994407707441961300E-2));
+		pp = _mm256_add_pd(_mm256_mul_pd(pp, rr), _mm256_set1_pd(9.99999999999999999910E-1));
+		pp = _mm256_mul_pd(pp, r);
+		__m256d qq = _mm256_set1_pd(3.00198505138664455042E-6);
+		qq = _mm256_add_pd(_mm256_mul_pd(qq, rr), _mm256_set1_pd(2.52448340349684104192E-3));
+		qq = _mm256_add_pd(_mm256_mul_pd(qq, rr), _mm256_set1_pd(2.27265548208155028766E-1));
+		qq = _mm256_add_pd(_mm256_mul_pd(qq, rr), _mm256_set1_pd(2.00000000000000000009E0));
+		__m256d e = _mm256_div_pd(pp, _mm256_sub_pd(qq, pp));
+		e = _mm256_add_pd(_mm256_set1_pd(1.0), _mm256_add_pd(e, e));
+
+		// multiply by 2^{n} in two steps so that neither factor leaves the range of normal numbers
+		__m128i ni = _mm256_cvtpd_epi32(n);
+		__m128i n1 = _mm_srai_epi32(ni, 1);
+		__m128i n2 = _mm_sub_epi32(ni, n1);
+		__m256i bias = _mm256_set1_epi64x(1023);
+		__m256d f1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(n1), bias), 52));
+		__m256d f2 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(n2), bias), 52));
+		e = _mm256_mul_pd(_mm256_mul_pd(e, f1), f2);
+
+		e = _mm256_blendv_pd(e, _mm256_set1_pd(HUGE_VAL), over);
+		e = _mm256_blendv_pd(e, _mm256_setzero_pd(), under);
+		e = _mm256_blendv_pd(e, x, nan);
+
+		return e;
+	}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the methods declared in Sine_Transform.h
+
+dst_plan::dst_plan()
+{
+	// Default constructor
+
+	P = N = 0; 
+}
+
+dst_plan::dst_plan(int n_intervals)
+{
+	// Constructor
+
+	set_size(n_intervals); 
+}
+
+void dst_plan::set_size(int n_intervals)
+{
+	// prepare the plan for P = n_intervals, which must be a power of two no smaller than 2
+
+	try{
+	
+		bool c1 = n_intervals > 1 && (n_intervals & (n_intervals - 1)) == 0 ? true : false; 
+
+		if(c1){
+			P = n_intervals; 
+			N = 2 * P; 
+
+			int bits = 0; 
+			while ((1 << bits) < N) bits++; 
+
+			bit_rev.resize(N); 
+			for (int i = 0; i < N; i++) {
+				int r = 0; 
+				for (int b = 0; b < bits; b++) if (i & (1 << b)) r |= 1 << (bits - 1 - b); 
+				bit_rev[i] = r; 
+			}
+
+			twiddle.resize(N / 2); 
+			for (int k = 0; k < N / 2; k++) twiddle[k] = std::polar(1.0, -Two_PI * k / N); 
+		}
+		else{
+			std::string reason = "Error: void dst_plan::set_size(int n_intervals)\n"; 
+			reason += "n_intervals must be a power of two no smaller than 2\n"; 
+			throw std::invalid_argument(reason); 
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void dst_plan::fft(std::complex<double> *a) const
+{
+	// in place radix-2 decimation in time FFT of length N, the input is expected in bit reversed order
+
+	// the butterflies are written out in real arithmetic, std::complex multiplication carries checks for infinite operands that are not needed here
+
+	double *d = reinterpret_cast<double*>(a); 
+	const double *w = reinterpret_cast<const double*>(&twiddle[0]); 
+
+	for (int len = 2; len <= N; len <<= 1) {
+		int half = len / 2, step = N / len; 
+
+		for (int start = 0; start < N; start += len) {
+			for (int j = 0; j < half; j++) {
+				double *u = d + 2 * (start + j), *v = d + 2 * (start + j + half); 
+				double wr = w[2 * j * step], wi = w[2 * j * step + 1]; 
+				double vr = v[0] * wr - v[1] * wi, vi = v[0] * wi + v[1] * wr; 
+
+				v[0] = u[0] - vr; v[1] = u[1] - vi; 
+				u[0] += vr; u[1] += vi; 
+			}
+		}
+	}
+}
+
+void dst_plan::transform(std::complex<double> *f, std::complex<double> *work) const
+{
+	// S_{k} = sum_{j=1}^{M} f_{j} sin(pi j k / P) written over f, f[j-1] holds f_{j}
+	// the odd extension is scattered straight into bit reversed order so the FFT needs no separate permutation pass
+
+	std::complex<double> zero(0.0, 0.0); 
+
+	work[bit_rev[0]] = zero; 
+	work[bit_rev[P]] = zero; 
+
+	for (int j = 1; j < P; j++) {
+		work[bit_rev[j]] = f[j - 1]; 
+		work[bit_rev[N - j]] = -f[j - 1]; 
+	}
+
+	fft(work); 
+
+	// DFT_k = -2 i S_k, so S_k = (i / 2) DFT_k
+	for (int k = 1; k < P; k++) {
+		f[k - 1] = std::complex<double>(-0.5 * work[k].imag(), 0.5 * work[k].real()); 
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef SINE_TRANSFORM_H
+#define SINE_TRANSFORM_H
+
+// Discrete sine transform of type I computed through a radix-2 complex FFT
+// S_{k} = sum_{j=1}^{M} f_{j} sin(pi j k / P), k = 1..M, with P = M + 1 a power of two
+// Applying the transform twice returns (P / 2) f, so the same plan is used in both directions
+// f is extended to the odd sequence 0, f_{1}, .., f_{M}, 0, -f_{M}, .., -f_{1} of length 2P whose DFT is -2 i S_{k}, 
+// so one FFT of length 2P gives every S_{k} in O(P log P) operations
+// A plan holds the twiddle factors and the bit reversed ordering and is not changed by transform, 
+// so one plan can be shared between threads as long as each thread supplies its own work array
+
+class dst_plan{
+public:
+	dst_plan(); 
+	dst_plan(int n_intervals); 
+
+	void set_size(int n_intervals); 
+
+	// in place transform of f[0..M-1], work must hold 2P values
+	void transform(std::complex<double> *f, std::complex<double> *work) const; 
+
+	// getters
+	inline int get_M() const { return P - 1; }
+	inline int get_P() const { return P; }
+
+private:
+	void fft(std::complex<double> *a) const; 
+
+private:
+	int P; // number of intervals, P = M + 1
+	int N; // FFT length 2P
+
+	std::vector<int> bit_rev; // a[bit_rev[i]] is the i^{th} input of the butterflies
+	std::vector<std::complex<double>> twiddle; // exp(-2 pi i k / N), k = 0..N/2-1
+}; 
+
+#endif
@@ -180,6 +180,76 @@ double special::bessel_J(int n,double x)
 	}
 }
 
+void special::bessel_J_pair(int n, double x, double &Jnm1, double &Jn)
+{
+	// Returns J_{n-1}(x) in Jnm1 and J_{n}(x) in Jn for n >= 1 and all real x
+	// Both values are available from the recurrence used by bessj, so the pair costs the same as a single J_{n}(x)
+	int j,jsum,m;
+	double ax,bj,bjm,bjp,sum,tox,ans,ansm;
+
+	static const double ACC=40.0;
+	static const double BIGNO=1e10;
+	static const double BIGNI=1.0e-10;
+
+	if(n<1){
+		std::cerr<<"Index n less than 1 in bessel_J_pair\n";
+	}
+	ax=fabs(x);
+	if(n==1){
+		Jnm1=bessj0(x);
+		Jn=bessj1(x);
+		return;
+	}
+	if(ax==0.0){
+		Jnm1=Jn=0.0;
+		return;
+	}
+	else if(ax>static_cast<double>(n)){
+		//Upwards recurrence from J0 and J1
+		tox=2.0/ax;
+		bjm=bessj0(ax);
+		bj=bessj1(ax);
+		for(j=1;j<n;j++){
+			bjp=j*tox*bj-bjm;
+			bjm=bj;
+			bj=bjp;
+		}
+		ansm=bjm;
+		ans=bj;
+	}
+	else{
+		//Downwards recurrence from an even m here computed
+		tox=2.0/ax;
+		m=2*((n+static_cast<int>(sqrt(ACC*n)))/2);
+		jsum=0;
+		bjp=ans=ansm=sum=0.0;
+		bj=1.0;
+		for(j=m;j>0;j--){
+			bjm=j*tox*bj-bjp;
+			bjp=bj;
+			bj=bjm;
+			if(fabs(bj)>BIGNO){
+				bj*=BIGNI;
+				bjp*=BIGNI;
+				ans*=BIGNI;
+				ansm*=BIGNI;
+				sum*=BIGNI;
+			}
+			if(jsum) sum+=bj;
+			jsum=!jsum;
+			if(j==n){
+				ans=bjp;
+				ansm=bj;
+			}
+		}
+		sum=2.0*sum-bj;
+		ans/=sum;
+		ansm/=sum;
+	}
+	Jn = x<0.0 && (n&1) ? -ans:ans;
+	Jnm1 = x<0.0 && ((n-1)&1) ? -ansm:ansm;
+}
+
 double special::bessy0(double x)
 {
 	//Returns the Bessel Function Y0(x) for real positive values of x
@@ -859,6 +929,168 @@ void special::airy(double x, double *ai, double *bi, double *aip, double *bip)
 	}
 }
 
+void special::airy_scaled(double x, double *ai, double *bi, double *aip, double *bip)
+{
+	// Returns exp(zeta) Ai(x), exp(-zeta) Bi(x), exp(zeta) Ai'(x), exp(-zeta) Bi'(x) for x > 0, zeta = 2 x^{3/2} / 3, and airy(x) otherwise
+	// For large zeta, u_k = (6k-5)(6k-3)(6k-1) u_{k-1} / (216 k (2k-1)), v_k = -(6k+1) u_k / (6k-1), u_0 = v_0 = 1, and
+	// Ai ~ sum (-1)^k u_k / zeta^k / (2 sqrt(pi) x^{1/4}), Ai' ~ -x^{1/4} sum (-1)^k v_k / zeta^k / (2 sqrt(pi)),
+	// Bi ~ sum u_k / zeta^k / (sqrt(pi) x^{1/4}), Bi' ~ x^{1/4} sum v_k / zeta^k / sqrt(pi), the sums stop once the terms fall below 1e-17
+
+	if (x <= 0.0) {
+		airy(x, ai, bi, aip, bip); 
+		return; 
+	}
+
+	double zeta = 2.0 * x * sqrt(x) / 3.0; 
+
+	if (zeta < AIRY_ASYMPTOTIC_ZETA) {
+		airy(x, ai, bi, aip, bip); 
+
+		double up = exp(zeta), down = 1.0 / up; 
+
+		*ai *= up; 
+		*aip *= up; 
+		*bi *= down; 
+		*bip *= down; 
+	}
+	else {
+		double u = 1.0, v, r = 1.0 / zeta, p = 1.0; 
+		double su_alt = 1.0, sv_alt = 1.0, su = 1.0, sv = 1.0, sign = 1.0; 
+
+		for (int k = 1; k < 50; k++) {
+			u *= (6.0 * k - 5.0) * (6.0 * k - 3.0) * (6.0 * k - 1.0) / (216.0 * k * (2.0 * k - 1.0)); 
+			v = -(6.0 * k + 1.0) / (6.0 * k - 1.0) * u; 
+			p *= r; 
+			sign = -sign; 
+
+			su_alt += sign * u * p; 
+			sv_alt += sign * v * p; 
+			su += u * p; 
+			sv += v * p; 
+
+			if (fabs(u * p) < 1.0e-17 && fabs(v * p) < 1.0e-17) break; 
+		}
+
+		double q = sqrt(sqrt(x)), c = 1.0 / sqrt(PI); 
+
+		*ai = 0.5 * c * su_alt / q; 
+		*aip = -0.5 * c * q * sv_alt; 
+		*bi = c * su / q; 
+		*bip = c * q * sv; 
+	}
+}
+
+namespace {
+
+	std::mutex airy_zero_lock; // guards the growth of the zero tables
+
+	std::vector<double> airy_zero_table, airy_derivative_zero_table; // a_s and a'_s at index s - 1
+
+	void extend_airy_zeros(int s_max)
+	{
+		// fill both tables up to the next multiple of AIRY_ZERO_BLOCK at or above s_max, the caller holds airy_zero_lock
+
+		int s_old = static_cast<int>(airy_zero_table.size());
+		int s_new = special::AIRY_ZERO_BLOCK * ((s_max + special::AIRY_ZERO_BLOCK - 1) / special::AIRY_ZERO_BLOCK);
+
+		airy_zero_table.resize(s_new);
+		airy_derivative_zero_table.resize(s_new);
+
+		for (int s = s_old + 1; s <= s_new; s++) {
+			// T(t) and U(t) to the t^{-8} term, the first omitted term is below 1e-16 relative for s > AIRY_ZERO_NEWTON
+			double t = 3.0 * PI * (4.0 * s - 1.0) / 8.0, r = 1.0 / (t * t);
+			double a = -pow(t, 2.0 / 3.0) * (1.0 + r * (5.0 / 48.0 + r * (-5.0 / 36.0 + r * (77125.0 / 82944.0 - r * 108056875.0 / 6967296.0))));
+
+			t = 3.0 * PI * (4.0 * s - 3.0) / 8.0;
+			r = 1.0 / (t * t);
+			double ap = -pow(t, 2.0 / 3.0) * (1.0 + r * (-7.0 / 48.0 + r * (35.0 / 288.0 + r * (-181223.0 / 207360.0 + r * 18683371.0 / 1244160.0))));
+
+			// at s = 1 the expansion of a'_1 has t = 3 pi / 8 and diverges, start Newton from tabulated values instead
+			if (s == 1) {
+				a = -2.33810741;
+				ap = -1.01879297;
+			}
+
+			if (s <= special::AIRY_ZERO_NEWTON) {
+				double ai, bi, aip, bip, dx;
+
+				// Newton on Ai, then on Ai' with Ai'' = x Ai
+				for (int it = 0; it < 10; it++) {
+					special::airy(a, &ai, &bi, &aip, &bip);
+					dx = ai / aip;
+					a -= dx;
+					if (fabs(dx) < 1.0e-15 * fabs(a)) break;
+				}
+
+				for (int it = 0; it < 10; it++) {
+					special::airy(ap, &ai, &bi, &aip, &bip);
+					dx = aip / (ap * ai);
+					ap -= dx;
+					if (fabs(dx) < 1.0e-15 * fabs(ap)) break;
+				}
+			}
+
+			airy_zero_table[s - 1] = a;
+			airy_derivative_zero_table[s - 1] = ap;
+		}
+	}
+
+	double airy_zero_lookup(int s, bool derivative)
+	{
+		// s >= 1 is checked by the caller
+
+		std::lock_guard<std::mutex> guard(airy_zero_lock);
+
+		if (s > static_cast<int>(airy_zero_table.size())) extend_airy_zeros(s);
+
+		return ( derivative ? airy_derivative_zero_table[s - 1] : airy_zero_table[s - 1] );
+	}
+}
+
+double special::airy_zero(int s)
+{
+	// Returns the s^{th} zero of Ai(x)
+
+	try{
+
+		if(s > 0){
+			return airy_zero_lookup(s, false);
+		}
+		else{
+			std::string reason = "Error: double special::airy_zero(int s)\n";
+			reason += "Zeros are counted from s = 1\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+double special::airy_derivative_zero(int s)
+{
+	// Returns the s^{th} zero of Ai'(x)
+
+	try{
+
+		if(s > 0){
+			return airy_zero_lookup(s, true);
+		}
+		else{
+			std::string reason = "Error: double special::airy_derivative_zero(int s)\n";
+			reason += "Zeros are counted from s = 1\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
 void special::fresnel(double x, double *s, double *c)
 {
 	// Computes the Fresnel integrals S(x) and C(x) for all real x.
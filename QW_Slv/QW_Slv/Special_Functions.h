@@ -24,6 +24,8 @@ namespace special{
 
 	double bessel_K(int n,double x); // Modified Bessel Function Knu(x)
 
+	void bessel_J_pair(int n, double x, double &Jnm1, double &Jn); // J_{n-1}(x) and J_{n}(x) from a single recurrence for n >= 1
+
 	//Bessel Function of the 1st kind
 	double bessj0(double x);
 	double bessj1(double x);
@@ -69,6 +71,25 @@ namespace special{
 	// need to implement I_{nu}(x) and K_{nu}(x) where nu is fractional
 	// c.f. NRinC, sect. 6.7 on page 250
 	void airy(double x, double *ai, double *bi, double *aip, double *bip); 
+
+	// Exponentially scaled Airy functions, for x > 0 Ai and Ai' are multiplied by exp(zeta) and Bi and Bi' by exp(-zeta), zeta = 2 x^{3/2} / 3,
+	// for x <= 0 the values of airy are returned, so nothing overflows or underflows for large x
+	// Once zeta > AIRY_ASYMPTOTIC_ZETA the asymptotic expansions of DLMF 9.7.5 - 9.7.8 are summed instead, their error is below exp(-2 zeta)
+	static const double AIRY_ASYMPTOTIC_ZETA = 20.0; 
+
+	void airy_scaled(double x, double *ai, double *bi, double *aip, double *bip); 
+
+	// Zeros of Ai(x) and Ai'(x), a_s and a'_s for s = 1, 2, ..., both negative and decreasing
+	// They are held in a table that is extended on demand in blocks of AIRY_ZERO_BLOCK, so repeated calls cost a lookup
+	// New entries come from the asymptotic expansions a_s = -T(3 pi (4 s - 1) / 8), a'_s = -U(3 pi (4 s - 3) / 8), DLMF 9.9.6 and 9.9.18,
+	// polished by Newton's method on airy for the first AIRY_ZERO_NEWTON zeros, beyond which the expansion is accurate to round off
+	// The table is shared and may be extended from several threads at once
+	static const int AIRY_ZERO_BLOCK = 256; 
+	static const int AIRY_ZERO_NEWTON = 64; 
+
+	double airy_zero(int s); // a_s, the s^{th} zero of Ai(x), s >= 1
+
+	double airy_derivative_zero(int s); // a'_s, the s^{th} zero of Ai'(x), s >= 1
 	
 	// Fresnel Integrals
 	void fresnel(double x, double *s, double *c); // Fresnel Integrals 
@@ -0,0 +1,272 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods associated with the spherical dot class
+
+namespace {
+
+	const double K_ASYMPTOTIC = 600.0; // above this argument bessik underflows and K_{l+1/2} ratios are formed by recurrence
+
+	double sph_bessel_k_log_derivative(int l, double w)
+	{
+		// q(w) = -w k_l'(w) / k_l(w) = 1 / 2 - w K_{nu}'(w) / K_{nu}(w) with nu = l + 1 / 2, w = 0 is the limit q = l + 1
+		// past K_ASYMPTOTIC, -w K_{nu}' / K_{nu} = nu + w K_{nu-1} / K_{nu} with K_{nu-1} / K_{nu} from K_{nu+1} = K_{nu-1} + (2 nu / w) K_{nu},
+		// started from K_{-1/2} = K_{1/2}, which only forms ratios and so cannot underflow
+
+		if (w <= 0.0) return static_cast<double>(l + 1);
+
+		if (w <= K_ASYMPTOTIC) {
+			double ri, rk, rip, rkp;
+			special::bessik(w, l + 0.5, &ri, &rk, &rip, &rkp);
+			return ( 0.5 - w * rkp / rk );
+		}
+
+		double rho = 1.0; // K_{-1/2} / K_{1/2}
+
+		for (int j = 0; j < l; j++) rho = 1.0 / ((2.0 * j + 1.0) / w + rho);
+
+		return ( l + 1.0 + w * rho );
+	}
+}
+
+sph_dot::sph_dot()
+{
+	// Default Constructor
+
+	n_total = root_calls = 0;
+
+	M_ratio = 1.0;
+	a = M_well = M_barr = well_depth = u_max = 0.0;
+}
+
+sph_dot::sph_dot(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// Constructor
+
+	// radius of the dot is expressed in nm
+	// masses of the particle in the dot and in the barrier are expressed in kg, e.g. 0.067 * M_ELECTRON_KG
+	// barrier_height is the depth of the dot potential expressed in eV
+
+	set_dot_params(radius, mass_well, mass_barrier, barrier_height);
+}
+
+void sph_dot::set_dot_params(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// method for assigning values to the dot parameters, every bound state of every channel is solved
+	// channels are independent so a dot with several channels is shared out between threads
+	// the levels of all channels are then merged into a single spectrum sorted by energy
+
+	try{
+
+		assign_dot_params(radius, mass_well, mass_barrier, barrier_height);
+
+		extend_zeros(u_max);
+
+		int n_channels = static_cast<int>(floor(u_max)) + 1;
+
+		channel_u.assign(n_channels, std::vector<double>());
+
+		std::vector<int> calls(n_channels, 0);
+
+		auto solve_channel = [this, &calls](int l) { channel_levels(l, channel_u[l], calls[l]); };
+
+		if (n_channels >= PARALLEL_MIN_CHANNELS) {
+			parallel_funcs::parallel_for(n_channels, solve_channel);
+		}
+		else {
+			for (int l = 0; l < n_channels; l++) solve_channel(l);
+		}
+
+		root_calls = 0;
+		for (int l = 0; l < n_channels; l++) root_calls += calls[l];
+
+		while (!channel_u.empty() && channel_u.back().empty()) channel_u.pop_back(); // the first level rises with l, so empty channels are all at the end
+
+		spectrum.clear();
+		n_total = 0;
+
+		for (int l = 0; l < get_n_channels(); l++) {
+			for (int n = 0; n < get_n_states(l); n++) {
+				dot_level level = { energy_eigenvalue(l, n), l, n, 2 * l + 1 };
+				spectrum.push_back(level);
+				n_total += level.degeneracy;
+			}
+		}
+
+		std::sort(spectrum.begin(), spectrum.end(), [](const dot_level &x, const dot_level &y) { return ( x.E < y.E || (x.E == y.E && x.l < y.l) ); });
+	}
+	catch(std::invalid_argument &e){
+		std::string reason = "Error: void sph_dot::set_dot_params(double radius, double mass_well, double mass_barrier, double barrier_height)\n";
+		useful_funcs::exit_failure_output(reason + e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void sph_dot::assign_dot_params(double radius, double mass_well, double mass_barrier, double barrier_height)
+{
+	// check and store the dot parameters, the reasons for rejecting them are thrown to the caller
+
+	bool c1 = radius > 0.0 ? true : false;
+	bool c2 = mass_well > 0.0 ? true : false;
+	bool c2a = mass_barrier > 0.0 ? true : false;
+	bool c3 = barrier_height > 0.0 ? true : false;
+
+	if(c1 && c2 && c2a && c3){
+
+		a = radius;
+		M_well = mass_well;
+		M_barr = mass_barrier;
+		M_ratio = (M_barr / M_well);
+		well_depth = barrier_height;
+		u_max = sqrt(2.0 * M_well * template_funcs::convert_ev_J(well_depth)) * a * 1.0e-9 / H_BAR_J;
+	}
+	else{
+		std::string reason;
+		if(!c1) reason += "radius is not positive\n";
+		if(!c2) reason += "mass in dot is not positive\n";
+		if(!c2a) reason += "mass in barrier is not positive\n";
+		if(!c3) reason += "barrier height is not positive\n";
+		throw std::invalid_argument(reason);
+	}
+}
+
+double sph_dot::energy_eigenvalue(int l, int n) const
+{
+	// return the energy of the n^{th} level of channel l in units of eV
+
+	try{
+
+		if(n > -1 && n < get_n_states(l)){
+			return ( well_depth * template_funcs::DSQR(channel_u[l][n] / u_max) );
+		}
+		else{
+			std::string reason = "Error: double sph_dot::energy_eigenvalue(int l, int n) const\n";
+			reason += "Values of l and n must be in range of allowed values\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+void sph_dot::matching_function(int l, double u, double &f, double &df) const noexcept
+{
+	// F(u) = r u j_l'(u) + q(w) j_l(u) and its derivative for u > 0
+	// with L = l (l + 1) the Bessel equations give (u j_l')' = -j_l' - (u - L / u) j_l and dq / dw = (q^{2} - q - L) / w - w,
+	// and dw / du = -r u / w, so dF / du needs no further special function calls
+	// at the barrier top w = 0 the derivative is singular and only F is meaningful, df is returned without the q term
+
+	double w2 = M_ratio * (u_max - u) * (u_max + u);
+	double w = w2 > 0.0 ? sqrt(w2) : 0.0;
+	double L = l * (l + 1.0), sj, sy, sjp, syp;
+
+	special::sphbes(l, u, &sj, &sy, &sjp, &syp);
+
+	double q = sph_bessel_k_log_derivative(l, w);
+	double dq = w > 0.0 ? -M_ratio * u * ((q * q - q - L) / w2 - 1.0) : 0.0; // dq / du
+
+	f = M_ratio * u * sjp + q * sj;
+	df = -M_ratio * (sjp + (u - L / u) * sj) + q * sjp + dq * sj;
+}
+
+void sph_dot::channel_levels(int l, std::vector<double> &u, int &calls) const
+{
+	// level s, counting from s = 0, of channel l has u in (z_{l,s}, z_{l,s+1}) with z_{l,0} = 0, closed at u_max when z_{l,s+1} >= u_max
+	// F at a zero z of j_l is r z j_l'(z), taken from the zero table, F at the start of the first bracket and at u_max are computed
+	// for l = 0, F(0) = q(w) with j_0(0) = 1, for l > 0, F(0) = 0 and the first bracket starts at u = l, where j_l and j_l' are positive
+	// the secant through the bracket end points starts Newton's method
+
+	u.clear();
+	calls = 0;
+
+	if (l > 0 && l >= u_max) return;
+
+	const std::vector<double> &zeros = sph_zeros[l], &slopes = sph_slopes[l];
+
+	double lo = static_cast<double>(l), f_lo, df;
+
+	if (l == 0) {
+		f_lo = sph_bessel_k_log_derivative(0, sqrt(M_ratio) * u_max);
+	}
+	else {
+		matching_function(l, lo, f_lo, df);
+		calls++;
+	}
+
+	for (size_t s = 0; ; s++) {
+		bool top = !(zeros[s] < u_max);
+		double hi = top ? u_max : zeros[s], f_hi;
+
+		if (top) {
+			matching_function(l, hi, f_hi, df);
+			calls++;
+
+			if (!(f_hi > 0.0 ? f_lo < 0.0 : f_lo > 0.0)) break; // no sign change below the barrier top, the level is not bound
+		}
+		else {
+			f_hi = M_ratio * hi * slopes[s];
+		}
+
+		int iter;
+		double guess = lo - f_lo * (hi - lo) / (f_hi - f_lo);
+		double root = root_funcs::newton_bracketed([this, l](double x, double &f, double &d) { matching_function(l, x, f, d); }, lo, hi, f_lo > 0.0, guess, 1.0e-15 * hi, iter);
+
+		calls += iter;
+		u.push_back(root);
+
+		if (top) break;
+
+		lo = hi;
+		f_lo = f_hi;
+	}
+}
+
+void sph_dot::extend_zeros(double u_top)
+{
+	// the channels l = 0..floor(u_top) need the zeros of j_l up to the first one at or above u_top to close their last bracket
+
+	int l_top = static_cast<int>(floor(u_top));
+
+	for (int l = 0; l <= l_top; l++) {
+		if (static_cast<int>(sph_zeros.size()) <= l) extend_channel_zeros(l, 1);
+
+		while (sph_zeros[l].back() < u_top) extend_channel_zeros(l, static_cast<int>(sph_zeros[l].size()) + 1);
+	}
+}
+
+void sph_dot::extend_channel_zeros(int l, int n_zeros)
+{
+	// zeros of j_0(x) = sin(x) / x are s pi, where j_0' = (-1)^{s} / (s pi)
+	// zeros of j_l interlace with those of j_{l-1}, so the s^{th} zero of j_l needs s + 1 zeros of j_{l-1},
+	// j_l has the sign (-1)^{s-1} at the s^{th} zero of j_{l-1} and each zero is refined by Newton's method on its bracket
+	// sphbes returns j_l' with j_l, the slope at the last Newton step is kept as j_l' at the zero
+
+	if (static_cast<int>(sph_zeros.size()) <= l) {
+		sph_zeros.resize(l + 1);
+		sph_slopes.resize(l + 1);
+	}
+
+	if (l > 0) extend_channel_zeros(l - 1, n_zeros + 1);
+
+	std::vector<double> &zeros = sph_zeros[l], &slopes = sph_slopes[l];
+
+	for (int s = static_cast<int>(zeros.size()); s < n_zeros; s++) {
+		if (l == 0) {
+			zeros.push_back((s + 1) * PI);
+			slopes.push_back((s % 2 == 0 ? -1.0 : 1.0) / zeros.back());
+		}
+		else {
+			double lo = sph_zeros[l - 1][s], hi = sph_zeros[l - 1][s + 1], slope = 0.0, sy, syp;
+
+			auto funcd = [l, &slope, &sy, &syp](double x, double &f, double &df) { special::sphbes(l, x, &f, &sy, &df, &syp); slope = df; };
+
+			int iter;
+			zeros.push_back( root_funcs::newton_bracketed(funcd, lo, hi, s % 2 == 0, 0.5 * (lo + hi), 1.0e-15 * hi, iter) );
+			slopes.push_back(slope);
+		}
+	}
+}
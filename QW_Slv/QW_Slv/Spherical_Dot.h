@@ -0,0 +1,81 @@
+#ifndef SPHERICAL_DOT_H
+#define SPHERICAL_DOT_H
+
+// Bound states of a spherical quantum dot of radius a surrounded by a barrier of height V
+// The states are psi(r, theta, phi) = R(r) Y_{l m}(theta, phi), the radial part is j_l(k r) inside the dot and k_l(kappa r) outside,
+// with k_l(x) = sqrt(pi / 2 x) K_{l+1/2}(x), and the boundary conditions are continuity of psi and psi' / m at r = a
+// With u = k a, w = kappa a and r = m_barr / m_well the matching condition is r u j_l'(u) / j_l(u) = w k_l'(w) / k_l(w),
+// where w^{2} = r (u_max^{2} - u^{2}) and u_max = k a for a particle at the top of the barrier
+// As for cyl_wire the poles are removed with F(u) = r u j_l'(u) + q(w) j_l(u), q(w) = -w k_l'(w) / k_l(w) > 0,
+// and channel l has exactly one level between consecutive zeros of j_l below u_max, only channels l <= u_max can have bound states
+// Unlike the wire an l = 0 level needs a deep enough dot, F(u_max) = r u_max j_0'(u_max) + j_0(u_max) must be negative
+// Each call of F makes one special::sphbes call for j_l, j_l' and one special::bessik call for k_l, k_l', and the Bessel differential
+// equations turn these same values into dF / du, so the roots are refined by Newton's method safeguarded by the bracket
+// The zeros of j_l are kept between solves together with j_l' at each zero, F at a zero of j_l is r u j_l'(u) whatever the barrier,
+// so the end point values of every bracket are known without a call and give a secant starting guess for the Newton steps
+// Energies are E = V (u / u_max)^{2}, each level of channel l has degeneracy 2 l + 1
+
+// The natural scale for energy is eV, scale energies accordingly
+// The natural scale for length is nm, you can scale lengths accordingly
+
+struct dot_level {
+	double E; // energy expressed in eV
+	int l; // angular momentum quantum number
+	int n; // radial quantum number, counted from 0 within channel l
+	int degeneracy; // 2 l + 1
+};
+
+class sph_dot{
+public:
+	sph_dot();
+
+	sph_dot(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	void set_dot_params(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	double energy_eigenvalue(int l, int n) const; // energy of the n^{th} level of channel l in eV, n counted from 0
+
+	// getters
+	inline int get_n_channels() const { return static_cast<int>(channel_u.size()); } // channels l = 0..get_n_channels()-1 have bound states
+	inline int get_n_states(int l) const { return ( l > -1 && l < get_n_channels() ? static_cast<int>(channel_u[l].size()) : 0 ); }
+	inline int get_n_levels() const { return static_cast<int>(spectrum.size()); }
+	inline int get_n_states() const { return n_total; } // bound states counting the 2 l + 1 degeneracy
+	inline const std::vector<dot_level>& get_spectrum() const { return spectrum; } // every level of every channel in order of increasing energy
+	inline double get_u_max() const { return u_max; }
+	inline int get_root_calls() const { return root_calls; } // evaluations of F made by the last solve
+
+	static const int PARALLEL_MIN_CHANNELS = 8; // dots with fewer possible channels than this are solved on the calling thread
+
+private:
+	void assign_dot_params(double radius, double mass_well, double mass_barrier, double barrier_height);
+
+	// F(u) and dF / du of channel l, does not throw
+	void matching_function(int l, double u, double &f, double &df) const noexcept;
+
+	// every level of channel l in increasing order, reads the zero table only so channels can be solved from any number of threads
+	void channel_levels(int l, std::vector<double> &u, int &calls) const;
+
+	// make the zero table hold every zero of j_l up to and including the first above u_top for l = 0..floor(u_top)
+	void extend_zeros(double u_top);
+
+	void extend_channel_zeros(int l, int n_zeros); // make sph_zeros[l] hold at least n_zeros zeros
+
+private:
+	double a; // radius of the dot expressed in nm
+	double M_well; // mass of the particle in the dot expressed in kg
+	double M_barr; // mass of the particle in the barrier expressed in kg
+	double M_ratio; // ratio of mass in barrier to mass in dot
+	double well_depth; // height of energy barrier expressed in eV
+	double u_max; // k a for a particle with energy equal to the barrier height
+
+	int n_total; // bound states counting degeneracy
+	int root_calls; // evaluations of F made by the last solve
+
+	std::vector<std::vector<double>> channel_u; // channel_u[l][n] = k a of the n^{th} level of channel l
+	std::vector<dot_level> spectrum; // levels sorted by energy
+
+	std::vector<std::vector<double>> sph_zeros; // sph_zeros[l][s] = the (s+1)^{th} positive zero of j_l
+	std::vector<std::vector<double>> sph_slopes; // sph_slopes[l][s] = j_l' at sph_zeros[l][s]
+};
+
+#endif
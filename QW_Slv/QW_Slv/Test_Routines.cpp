@@ -84,6 +84,720 @@ void testing::potential_barrier()
 	classical.compute_wavefunction("Barrier_Solution.txt");
 }
 
+void testing::energy_sweep()
+{
+	// compare the batched energy sweep against repeated calls to set_params
+	// both the agreement in T, R and the time taken by each approach are reported
+
+	int n_energies = 1000000; 
+	double particle_mass = M_ELECTRON_KG;
+	double step_height = 1.0, barr_height = 1.1, barr_width = 1.0; 
+	double dT_max, dR_max; 
+
+	std::vector<double> energies(n_energies); 
+	
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (2.0 * i) / n_energies; // E / V runs from 0 to 2
+
+	// potential step
+	pot_step the_step; 
+	step_sweep step_res; 
+
+	the_step.energy_sweep(particle_mass, step_height, &energies[0], n_energies, step_res); // first call allocates the result arrays
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	
+	the_step.energy_sweep(particle_mass, step_height, &energies[0], n_energies, step_res); 
+	
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+	dT_max = dR_max = 0.0; 
+	for (int i = 0; i < n_energies; i++) {
+		the_step.set_params(particle_mass, energies[i], step_height); 
+		dT_max = std::max(dT_max, fabs(the_step.get_T() - step_res.T[i])); 
+		dR_max = std::max(dR_max, fabs(the_step.get_R() - step_res.R[i]));
+	}
+	
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Potential step, " << n_energies << " energies\n"; 
+	std::cout << "Batch sweep: " << std::chrono::duration<double>(t1 - t0).count() << " s\n"; 
+	std::cout << "Scalar loop: " << std::chrono::duration<double>(t2 - t1).count() << " s\n"; 
+	std::cout << "max |dT| = " << dT_max << " , max |dR| = " << dR_max << "\n\n"; 
+
+	// potential barrier, only energies below the barrier height are allowed
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (1.0 * i) / n_energies;
+
+	pot_barr the_barr; 
+	barr_sweep barr_res; 
+
+	the_barr.energy_sweep(particle_mass, barr_height, barr_width, &energies[0], n_energies, barr_res);
+
+	t0 = std::chrono::high_resolution_clock::now();
+
+	the_barr.energy_sweep(particle_mass, barr_height, barr_width, &energies[0], n_energies, barr_res);
+
+	t1 = std::chrono::high_resolution_clock::now();
+
+	dT_max = dR_max = 0.0;
+	for (int i = 0; i < n_energies; i++) {
+		the_barr.set_params(particle_mass, energies[i], barr_height, barr_width);
+		dT_max = std::max(dT_max, fabs(the_barr.get_T() - barr_res.T[i]));
+		dR_max = std::max(dR_max, fabs(the_barr.get_R() - barr_res.R[i]));
+	}
+
+	t2 = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Potential barrier, " << n_energies << " energies\n";
+	std::cout << "Batch sweep: " << std::chrono::duration<double>(t1 - t0).count() << " s\n";
+	std::cout << "Scalar loop: " << std::chrono::duration<double>(t2 - t1).count() << " s\n";
+	std::cout << "max |dT| = " << dT_max << " , max |dR| = " << dR_max << "\n";
+}
+
+void testing::wavefunction_batch()
+{
+	// compare the batched wavefunction evaluation against the scalar wavefunction method
+	// positions are deliberately unsorted so that every region is visited in an arbitrary order
+
+	int n_positions = 1000000; 
+	double particle_mass = M_ELECTRON_KG;
+	double err, err_max; 
+	std::complex<double> psi; 
+
+	std::vector<double> position(n_positions), psi_re(n_positions), psi_im(n_positions); 
+
+	for (int i = 0; i < n_positions; i++) position[i] = -3.0 + 6.0 * ( (static_cast<long long>(i) * 7919) % n_positions ) / n_positions; 
+
+	pot_step the_step; 
+	pot_barr the_barr; 
+
+	for (int c = 0; c < 3; c++) {
+		std::string label; 
+		
+		if (c == 0) { the_step.set_params(particle_mass, 2, 1); label = "Step E > V"; }
+		if (c == 1) { the_step.set_params(particle_mass, 1, 2); label = "Step E < V"; }
+		if (c == 2) { the_barr.set_params(particle_mass, 1, 1.1, 1); label = "Barrier"; }
+
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+		if (c < 2) the_step.wavefunction(&position[0], n_positions, &psi_re[0], &psi_im[0]); 
+		else the_barr.wavefunction(&position[0], n_positions, &psi_re[0], &psi_im[0]); 
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+		err_max = 0.0; 
+		for (int i = 0; i < n_positions; i++) {
+			psi = (c < 2) ? the_step.wavefunction(position[i]) : the_barr.wavefunction(position[i]); 
+			err = abs(psi - std::complex<double>(psi_re[i], psi_im[i])) / std::max(1.0, abs(psi)); 
+			err_max = std::max(err_max, err); 
+		}
+
+		std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+		std::cout << label << ", " << n_positions << " positions\n"; 
+		std::cout << "Batch: " << std::chrono::duration<double>(t1 - t0).count() << " s , Scalar: " << std::chrono::duration<double>(t2 - t1).count() << " s\n";
+		std::cout << "max relative error = " << err_max << "\n\n";
+	}
+
+	// far into the step exp(-k2 x) underflows to zero, the batch and status paths must give the scalar value (0, 0) and not NaN
+	// std::max ignores NaN, so non-finite values are counted separately
+
+	int n_deep = 501, n_nonfinite = 0, n_flagged;
+	std::vector<double> x_deep(n_deep), re_deep(n_deep), im_deep(n_deep), re_st(n_deep), im_st(n_deep);
+	std::vector<int> status(n_deep);
+
+	for (int i = 0; i < n_deep; i++) x_deep[i] = static_cast<double>(i); // 0 to 500 nm
+
+	the_step.set_params(particle_mass, 1, 2);
+	the_step.wavefunction(&x_deep[0], n_deep, &re_deep[0], &im_deep[0]);
+	n_flagged = the_step.wavefunction(&x_deep[0], n_deep, &re_st[0], &im_st[0], &status[0]);
+
+	err_max = 0.0;
+	for (int i = 0; i < n_deep; i++) {
+		psi = the_step.wavefunction(x_deep[i]);
+		if (!std::isfinite(re_deep[i]) || !std::isfinite(im_deep[i]) || !std::isfinite(re_st[i]) || !std::isfinite(im_st[i])) n_nonfinite++;
+		err_max = std::max(err_max, abs(psi - std::complex<double>(re_deep[i], im_deep[i])));
+		err_max = std::max(err_max, abs(psi - std::complex<double>(re_st[i], im_st[i])));
+	}
+
+	std::cout << "Step E < V, " << n_deep << " positions from 0 to 500 nm\n";
+	std::cout << "non-finite values = " << n_nonfinite << " , flagged = " << n_flagged << " , max error = " << err_max;
+	std::cout << (n_nonfinite == 0 && n_flagged == 0 && err_max < 1.0e-15 ? " (pass)" : " (FAIL)") << "\n\n";
+}
+
+void testing::wavefunction_grid()
+{
+	// compare the phasor recurrence on a uniform grid against direct evaluation at the same positions
+	// the error is measured relative to the largest value of |psi| on the grid and compared with the bound in Wave_Kernels.h
+	// the last case runs the decaying step solution out to 400 nm, far enough that exp(-k2 x) underflows,
+	// non-finite values are counted separately since std::max ignores NaN
+
+	int n_points = 1000000; 
+	double particle_mass = M_ELECTRON_KG;
+	double x_start, dx; 
+	double bound = 4.0 * wave_kernels::GRID_RESTART * std::numeric_limits<double>::epsilon(); 
+	double err_max, psi_max; 
+	int n_nonfinite; 
+	
+	std::vector<double> position(n_points), re_grid(n_points), im_grid(n_points), re_dir(n_points), im_dir(n_points);
+
+	pot_step the_step;
+	pot_barr the_barr;
+
+	for (int c = 0; c < 4; c++) {
+		std::string label;
+
+		x_start = -3.0; dx = 6.0 / (n_points - 1); 
+
+		if (c == 0) { the_step.set_params(particle_mass, 2, 1); label = "Step E > V"; }
+		if (c == 1) { the_step.set_params(particle_mass, 1, 2); label = "Step E < V"; }
+		if (c == 2) { the_barr.set_params(particle_mass, 1, 1.1, 1); label = "Barrier"; }
+		if (c == 3) { the_step.set_params(particle_mass, 1, 2); label = "Step E < V, 0 to 400 nm"; x_start = 0.0; dx = 400.0 / (n_points - 1); }
+
+		for (int i = 0; i < n_points; i++) position[i] = x_start + i * dx; 
+
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+		if (c != 2) the_step.wavefunction_grid(x_start, dx, n_points, &re_grid[0], &im_grid[0]); 
+		else the_barr.wavefunction_grid(x_start, dx, n_points, &re_grid[0], &im_grid[0]);
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+		if (c != 2) the_step.wavefunction(&position[0], n_points, &re_dir[0], &im_dir[0]);
+		else the_barr.wavefunction(&position[0], n_points, &re_dir[0], &im_dir[0]);
+
+		std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < n_points; i++) {
+			if (c != 2) the_step.wavefunction(position[i]); 
+			else the_barr.wavefunction(position[i]);
+		}
+
+		std::chrono::high_resolution_clock::time_point t3 = std::chrono::high_resolution_clock::now();
+
+		err_max = psi_max = 0.0; 
+		n_nonfinite = 0; 
+		for (int i = 0; i < n_points; i++) {
+			if (!std::isfinite(re_grid[i]) || !std::isfinite(im_grid[i]) || !std::isfinite(re_dir[i]) || !std::isfinite(im_dir[i])) n_nonfinite++; 
+			err_max = std::max(err_max, abs(std::complex<double>(re_grid[i] - re_dir[i], im_grid[i] - im_dir[i]))); 
+			psi_max = std::max(psi_max, abs(std::complex<double>(re_dir[i], im_dir[i]))); 
+		}
+
+		std::cout << label << ", " << n_points << " grid points\n";
+		std::cout << "Recurrence: " << std::chrono::duration<double>(t1 - t0).count() << " s , Batch: " << std::chrono::duration<double>(t2 - t1).count() << " s , Scalar: " << std::chrono::duration<double>(t3 - t2).count() << " s\n";
+		std::cout << "non-finite values = " << n_nonfinite << " , max error / max |psi| = " << err_max / psi_max << " , bound = " << bound << (n_nonfinite == 0 && err_max / psi_max < bound ? " (pass)" : " (FAIL)") << "\n\n";
+	}
+}
+
+void testing::multi_layer_stack()
+{
+	// check the multi_layer scattering engine against pot_step and pot_barr
+	// then look at a thick barrier, where the closed form of pot_barr overflows, and time a sweep across a long superlattice
+
+	double particle_mass = M_ELECTRON_KG;
+	double T, R; 
+
+	std::vector<layer> layers; 
+	
+	// potential step is a structure with no layers
+	pot_step the_step; 
+	multi_layer step_stack; 
+
+	for (int c = 0; c < 2; c++) {
+		double E = (c == 0 ? 2.0 : 1.0), V = (c == 0 ? 1.0 : 2.0); 
+
+		the_step.set_params(particle_mass, E, V); 
+		step_stack.set_params(particle_mass, 0.0, particle_mass, V, layers); 
+		step_stack.probabilities(E, T, R); 
+
+		std::cout << "Step E = " << E << ", V = " << V << ": pot_step T = " << the_step.get_T() << ", R = " << the_step.get_R() << " , multi_layer T = " << T << ", R = " << R << "\n"; 
+	}
+
+	// potential barrier is a structure with one layer
+	layer barrier = { 1.0, 1.1, particle_mass }; 
+	pot_barr the_barr; 
+	multi_layer barr_stack; 
+
+	for (int c = 0; c < 2; c++) {
+		barrier.width = (c == 0 ? 1.0 : 500.0); 
+		layers.assign(1, barrier); 
+
+		the_barr.set_params(particle_mass, 1.0, barrier.height, barrier.width); 
+		barr_stack.set_params(particle_mass, 0.0, particle_mass, 0.0, layers); 
+		barr_stack.probabilities(1.0, T, R); 
+
+		std::cout << "Barrier W = " << barrier.width << ": pot_barr T = " << the_barr.get_T() << ", R = " << the_barr.get_R() << " , multi_layer T = " << T << ", R = " << R << "\n";
+	}
+
+	// particle energy equal to the barrier height, q = 0 inside the barrier
+	// the closed form is T = 1 / (1 + (k W / 2)^{2}) with k the wavenumber in the leads
+	// the second case splits the barrier in two so that both sides of an interface have q = 0
+	barrier.width = 1.0; 
+	double k = ( sqrt(2.0 * particle_mass * template_funcs::convert_ev_J(barrier.height)) * 1.0e-9 ) / H_BAR_J; 
+	double T_exact = 1.0 / (1.0 + template_funcs::DSQR(0.5 * k * barrier.width)); 
+
+	for (int c = 0; c < 2; c++) {
+		layer half = { 0.5 * barrier.width, barrier.height, particle_mass }; 
+		if (c == 0) layers.assign(1, barrier); 
+		else layers.assign(2, half); 
+
+		barr_stack.set_params(particle_mass, 0.0, particle_mass, 0.0, layers); 
+		barr_stack.probabilities(barrier.height, T, R); 
+
+		std::cout << "Barrier E = V, " << layers.size() << " layer(s): exact T = " << T_exact << " , multi_layer T = " << T << ", R = " << R << " , |dT| = " << fabs(T - T_exact) << "\n";
+	}
+
+	// superlattice of alternating GaAs-like wells and AlGaAs-like barriers
+	int n_periods = 500, n_energies = 10000; 
+	layer well = { 5.0, 0.0, 0.067 * particle_mass }, barr = { 2.0, 0.3, 0.092 * particle_mass }; 
+	
+	layers.clear(); 
+	for (int i = 0; i < n_periods; i++) {
+		layers.push_back(barr); 
+		layers.push_back(well); 
+	}
+	layers.push_back(barr); 
+
+	multi_layer lattice(well.mass, 0.0, well.mass, 0.0, layers); 
+
+	std::vector<double> energies(n_energies), T_vals(n_energies), R_vals(n_energies); 
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (0.5 * i) / n_energies; 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+	lattice.energy_sweep(&energies[0], n_energies, &T_vals[0], &R_vals[0], 1); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+	lattice.energy_sweep(&energies[0], n_energies, &T_vals[0], &R_vals[0]);
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+	double err_max = 0.0; 
+	for (int i = 0; i < n_energies; i++) err_max = std::max(err_max, fabs(T_vals[i] + R_vals[i] - 1.0)); 
+
+	std::cout << "\nSuperlattice of " << lattice.get_n_layers() << " layers, " << n_energies << " energies\n"; 
+	std::cout << "1 thread: " << std::chrono::duration<double>(t1 - t0).count() << " s , " << parallel_funcs::num_threads() << " threads: " << std::chrono::duration<double>(t2 - t1).count() << " s\n"; 
+	std::cout << "max |T + R - 1| = " << err_max << "\n"; 
+}
+
+void testing::shared_solution()
+{
+	// solve the barrier problem once and share the immutable solution between worker threads
+	// each thread evaluates its own block of positions, the result must be identical to a serial evaluation
+
+	int n_positions = 1000000, n_blocks = 64; 
+	int block = n_positions / n_blocks; 
+	double x_start = -3.0, dx = 6.0 / n_positions; 
+
+	pot_barr the_barr(M_ELECTRON_KG, 1, 1.1, 1); 
+
+	const barr_soln shared = the_barr.get_soln(); // cheap copy, no set up is repeated
+
+	std::vector<double> re_par(n_positions), im_par(n_positions), re_ser(n_positions), im_ser(n_positions); 
+
+	parallel_funcs::parallel_for(n_blocks, [&](int b) { shared.wavefunction_grid(x_start + b * block * dx, dx, block, &re_par[b * block], &im_par[b * block]); }); 
+
+	for (int b = 0; b < n_blocks; b++) shared.wavefunction_grid(x_start + b * block * dx, dx, block, &re_ser[b * block], &im_ser[b * block]); 
+
+	int n_diff = 0; 
+	for (int i = 0; i < n_positions; i++) if (re_par[i] != re_ser[i] || im_par[i] != im_ser[i]) n_diff++; 
+
+	std::cout << "Shared barr_soln evaluated on " << parallel_funcs::num_threads() << " threads, T = " << shared.get_T() << "\n"; 
+	std::cout << "Positions that differ from the serial evaluation: " << n_diff << "\n"; 
+}
+
+void testing::status_path()
+{
+	// run the non-throwing sweeps and batch wavefunctions over inputs that contain bad values
+	// the bad values should be flagged in the status arrays while the remaining values match the throwing versions
+
+	int n_energies = 1000000, n_bad_in = 0; 
+	double particle_mass = M_ELECTRON_KG;
+	double barr_height = 1.1, barr_width = 1.0; 
+	double nan = std::numeric_limits<double>::quiet_NaN(); 
+
+	std::vector<double> energies(n_energies), good; 
+	std::vector<int> status(n_energies); 
+
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (1.0 * i) / n_energies;
+
+	// spoil every 1000th energy, cycling through negative, NaN and above the barrier
+	for (int i = 0; i < n_energies; i += 1000) {
+		energies[i] = (i % 3000 == 0) ? -1.0 : ( (i % 3000 == 1000) ? nan : 2.0 * barr_height );
+		n_bad_in++; 
+	}
+
+	pot_barr the_barr; 
+	barr_sweep res, ref; 
+
+	int n_bad = the_barr.energy_sweep(particle_mass, barr_height, barr_width, &energies[0], n_energies, res, &status[0]); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+	the_barr.energy_sweep(particle_mass, barr_height, barr_width, &energies[0], n_energies, res, &status[0]); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+	for (int i = 0; i < n_energies; i++) if (status[i] == EVAL_OK) good.push_back(energies[i]); 
+
+	the_barr.energy_sweep(particle_mass, barr_height, barr_width, &good[0], static_cast<int>(good.size()), ref); 
+
+	double dT_max = 0.0; 
+	int n_nan = 0; 
+	for (int i = 0, j = 0; i < n_energies; i++) {
+		if (status[i] == EVAL_OK) dT_max = std::max(dT_max, fabs(res.T[i] - ref.T[j++])); 
+		else if (std::isnan(res.T[i])) n_nan++; 
+	}
+
+	std::cout << "Potential barrier status sweep, " << n_energies << " energies, " << n_bad_in << " bad\n"; 
+	std::cout << "Flagged: " << n_bad << " , set to NaN: " << n_nan << "\n"; 
+	std::cout << "Status of E = -1: " << status[0] << " , E = NaN: " << status[1000] << " , E > V: " << status[2000] << "\n"; 
+	std::cout << "Status sweep: " << std::chrono::duration<double>(t1 - t0).count() << " s\n"; 
+	std::cout << "max |dT| against throwing sweep = " << dT_max << "\n\n"; 
+
+	// batch wavefunction with non-finite positions
+	int n_positions = 100000; 
+	std::vector<double> position(n_positions), re(n_positions), im(n_positions), re_ref(n_positions), im_ref(n_positions); 
+	std::vector<int> pos_status(n_positions); 
+
+	for (int i = 0; i < n_positions; i++) position[i] = -5.0 + (10.0 * i) / n_positions; 
+
+	pot_step the_step(particle_mass, 0.5, 1.0); 
+
+	the_step.wavefunction(&position[0], n_positions, &re_ref[0], &im_ref[0]); 
+
+	position[10] = nan; 
+	position[20] = std::numeric_limits<double>::infinity(); 
+
+	n_bad = the_step.wavefunction(&position[0], n_positions, &re[0], &im[0], &pos_status[0]); 
+
+	double dpsi_max = 0.0; 
+	for (int i = 0; i < n_positions; i++) if (pos_status[i] == EVAL_OK) dpsi_max = std::max(dpsi_max, fabs(re[i] - re_ref[i]) + fabs(im[i] - im_ref[i])); 
+
+	std::cout << "Potential step status wavefunction, " << n_positions << " positions\n"; 
+	std::cout << "Flagged: " << n_bad << " , status " << pos_status[10] << " " << pos_status[20] << "\n"; 
+	std::cout << "max |dpsi| against throwing evaluation = " << dpsi_max << "\n\n"; 
+
+	// solution without parameters
+	step_soln empty; 
+	n_bad = empty.wavefunction(&position[0], n_positions, &re[0], &im[0], &pos_status[0]); 
+
+	std::cout << "Undefined step_soln, flagged: " << n_bad << " , status " << pos_status[0] << "\n\n"; 
+
+	// batch Chebyshev evaluation with points outside the fit interval
+	int n_coeffs = 30, n_points = 1000; 
+	double a = 0.0, b = 2.0; 
+	std::vector<double> nodes(n_coeffs), coeffs(n_coeffs), pts(n_points), vals(n_points); 
+	std::vector<int> pts_status(n_points); 
+
+	for (int k = 0; k < n_coeffs; k++) nodes[k] = exp(0.5 * (b + a) + 0.5 * (b - a) * cos(PI * (k + 0.5) / n_coeffs)); 
+
+	cheb_appr::chebft(a, b, &coeffs[0], n_coeffs, &nodes[0]); 
+
+	for (int i = 0; i < n_points; i++) pts[i] = a + ((b - a) * i) / (n_points - 1); 
+
+	pts[0] = -0.5; 
+	pts[500] = nan; 
+	pts[n_points - 1] = b + 0.5; 
+
+	n_bad = cheb_appr::chebev(a, b, &coeffs[0], n_coeffs, &pts[0], n_points, &vals[0], &pts_status[0]); 
+
+	double dcheb_max = 0.0; 
+	for (int i = 0; i < n_points; i++) if (pts_status[i] == EVAL_OK) dcheb_max = std::max(dcheb_max, fabs(vals[i] - cheb_appr::chebev(a, b, &coeffs[0], n_coeffs, pts[i]))); 
+
+	std::cout << "Chebyshev status evaluation, " << n_points << " points\n"; 
+	std::cout << "Flagged: " << n_bad << " , status " << pts_status[0] << " " << pts_status[500] << " " << pts_status[n_points - 1] << "\n"; 
+	std::cout << "max |df| against throwing evaluation = " << dcheb_max << "\n"; 
+
+	// interval given the wrong way round
+	n_bad = cheb_appr::chebev(b, a, &coeffs[0], n_coeffs, &pts[0], n_points, &vals[0], &pts_status[0]); 
+
+	std::cout << "Reversed interval, flagged: " << n_bad << " , status " << pts_status[1] << "\n"; 
+}
+
+void testing::structure_split()
+{
+	// per-energy cost of set_params against set_energy, which reuses the stored structure, and structure.probabilities
+	// the three paths should agree to within rounding
+
+	int n_energies = 1000000; 
+	double particle_mass = M_ELECTRON_KG;
+	double barr_height = 1.1, barr_width = 1.0, step_height = 1.0; 
+	double T, R, dT_soln, dT_prob, sum = 0.0; 
+
+	std::vector<double> energies(n_energies), T_full(n_energies); 
+
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (1.0 * i) / n_energies;
+
+	// potential barrier
+	pot_barr the_barr(particle_mass, energies[0], barr_height, barr_width); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+	for (int i = 0; i < n_energies; i++) {
+		the_barr.set_params(particle_mass, energies[i], barr_height, barr_width); 
+		T_full[i] = the_barr.get_T(); 
+	}
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+	dT_soln = 0.0; 
+	for (int i = 0; i < n_energies; i++) {
+		the_barr.set_energy(energies[i]); 
+		dT_soln = std::max(dT_soln, fabs(the_barr.get_T() - T_full[i])); 
+	}
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+	dT_prob = 0.0; 
+	for (int i = 0; i < n_energies; i++) {
+		the_barr.get_structure().probabilities(energies[i], T, R); 
+		dT_prob = std::max(dT_prob, fabs(T - T_full[i])); 
+		sum += R; 
+	}
+
+	std::chrono::high_resolution_clock::time_point t3 = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Potential barrier, " << n_energies << " energies, time per energy\n"; 
+	std::cout << "set_params: " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / n_energies << " ns\n"; 
+	std::cout << "set_energy: " << 1.0e9 * std::chrono::duration<double>(t2 - t1).count() / n_energies << " ns , max |dT| = " << dT_soln << "\n"; 
+	std::cout << "probabilities: " << 1.0e9 * std::chrono::duration<double>(t3 - t2).count() / n_energies << " ns , max |dT| = " << dT_prob << "\n\n"; 
+
+	// potential step, energies span both sides of the step
+	for (int i = 0; i < n_energies; i++) energies[i] = 0.001 + (2.0 * i) / n_energies;
+
+	pot_step the_step(particle_mass, energies[0], step_height); 
+
+	t0 = std::chrono::high_resolution_clock::now();
+
+	for (int i = 0; i < n_energies; i++) {
+		the_step.set_params(particle_mass, energies[i], step_height); 
+		T_full[i] = the_step.get_T(); 
+	}
+
+	t1 = std::chrono::high_resolution_clock::now();
+
+	dT_soln = 0.0; 
+	for (int i = 0; i < n_energies; i++) {
+		the_step.set_energy(energies[i]); 
+		dT_soln = std::max(dT_soln, fabs(the_step.get_T() - T_full[i])); 
+	}
+
+	t2 = std::chrono::high_resolution_clock::now();
+
+	dT_prob = 0.0; 
+	for (int i = 0; i < n_energies; i++) {
+		the_step.get_structure().probabilities(energies[i], T, R); 
+		dT_prob = std::max(dT_prob, fabs(T - T_full[i])); 
+		sum += R; 
+	}
+
+	t3 = std::chrono::high_resolution_clock::now();
+
+	std::cout << "Potential step, " << n_energies << " energies, time per energy\n"; 
+	std::cout << "set_params: " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / n_energies << " ns\n"; 
+	std::cout << "set_energy: " << 1.0e9 * std::chrono::duration<double>(t2 - t1).count() / n_energies << " ns , max |dT| = " << dT_soln << "\n"; 
+	std::cout << "probabilities: " << 1.0e9 * std::chrono::duration<double>(t3 - t2).count() / n_energies << " ns , max |dT| = " << dT_prob << "\n"; 
+	std::cout << "(checksum " << sum << ")\n"; 
+}
+
+void testing::adaptive_sampling()
+{
+	// compare the adaptive T(E) sampler against the uniform grid used in potential_step_ratio
+	// the uniform grid is written out and plotted as a polyline, so its error is that of linear interpolation, that of the adaptive
+	// samples is that of sample_funcs::interpolate, both are measured against a dense reference grid
+	// the uniform grid read through interpolate is shown as well, on the smooth barrier most of the saving comes from the cubic
+
+	int n_uniform = 1000, n_dense = 200000; 
+	double particle_mass = M_ELECTRON_KG;
+	double step_height = 1.0, barr_height = 1.0, barr_width = 1.0; 
+	double t, r; 
+
+	step_structure step(particle_mass, step_height); 
+	barr_structure barr(particle_mass, barr_height, barr_width); 
+
+	for (int problem = 0; problem < 2; problem++) {
+		// step: E / V from 0.5 to 2.0, which contains the cusp at E = V, barrier: E / V from 0.001 to 0.999
+		double E_lo = problem == 0 ? 0.5 * step_height : 0.001 * barr_height; 
+		double E_hi = problem == 0 ? 2.0 * step_height : 0.999 * barr_height; 
+		double dE = (E_hi - E_lo) / (n_uniform - 1); 
+
+		std::vector<double> E_uni(n_uniform), T_uni(n_uniform), E_ad, T_ad; 
+
+		for (int i = 0; i < n_uniform; i++) {
+			E_uni[i] = E_lo + i * dE; 
+			if (problem == 0) step.probabilities(E_uni[i], t, r); 
+			else barr.probabilities(E_uni[i], t, r); 
+			T_uni[i] = t; 
+		}
+
+		// max interpolation error of a set of samples against the dense reference, linear joins on the uniform grid or interpolate
+		auto max_error = [&](const std::vector<double> &E, const std::vector<double> &T, bool linear) {
+			double err = 0.0; 
+			for (int i = 0; i < n_dense; i++) {
+				double e = E_lo + ( (E_hi - E_lo) * i ) / (n_dense - 1), value; 
+				if (problem == 0) step.probabilities(e, t, r); 
+				else barr.probabilities(e, t, r); 
+				if (linear) {
+					int k = std::min(static_cast<int>((e - E_lo) / dE), n_uniform - 2); 
+					double w = (e - E[k]) / dE; 
+					value = (1.0 - w) * T[k] + w * T[k + 1]; 
+				}
+				else {
+					value = sample_funcs::interpolate(E, T, e); 
+				}
+				err = std::max(err, fabs(value - t)); 
+			}
+			return err; 
+		}; 
+
+		double err_uni = max_error(E_uni, T_uni, true); 
+
+		std::cout << (problem == 0 ? "Potential step" : "Potential barrier") << ", uniform grid: " << n_uniform << " evaluations, max error " << err_uni << " (linear), " << max_error(E_uni, T_uni, false) << " (interpolate)\n"; 
+
+		// adaptive curves with the tolerance set by the uniform grid and tighter
+		double tol = err_uni; 
+		for (int j = 0; j < 3; j++) {
+			int n_evals = problem == 0 ? sample_funcs::transmission_curve(step, E_lo, E_hi, tol, E_ad, T_ad) : sample_funcs::transmission_curve(barr, E_lo, E_hi, tol, E_ad, T_ad); 
+			double err = max_error(E_ad, T_ad, false); 
+
+			std::cout << "adaptive, tol = " << tol << ": " << n_evals << " evaluations (" << static_cast<double>(n_uniform) / n_evals << "x fewer), " << E_ad.size() << " points, max error " << err << (err <= tol ? " (pass)" : " (FAIL)") << "\n"; 
+
+			tol *= 0.1; 
+		}
+		std::cout << "\n"; 
+	}
+}
+
+void testing::density_map()
+{
+	// compute |psi(x, E)|^{2} maps for the potential barrier with the tiled map engine
+	// the map is checked against a row by row evaluation with set_params and the scalar wavefunction, and the throughput of both is reported
+
+	int n_E = 2000, n_x = 2000; 
+	double particle_mass = M_ELECTRON_KG;
+	double barr_height = 1.0, barr_width = 1.0; 
+	double E_start = 0.01, dE = 0.98 / n_E, x_start = -3.0, dx = 7.0 / n_x; 
+
+	barr_structure barr(particle_mass, barr_height, barr_width); 
+	std::vector<double> density, row(n_x); 
+
+	double rate = map_funcs::density_map(barr, E_start, dE, n_E, x_start, dx, n_x, density); 
+
+	// reference, one set_params per energy and one scalar wavefunction call per point, timed on a subset of the rows
+	int n_check = 200; 
+	double err = 0.0; 
+	pot_barr the_barr; 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	for (int i = 0; i < n_E; i += n_E / n_check) {
+		the_barr.set_params(particle_mass, E_start + i * dE, barr_height, barr_width); 
+		for (int j = 0; j < n_x; j++) row[j] = std::norm(the_barr.wavefunction(x_start + j * dx)); 
+		for (int j = 0; j < n_x; j++) err = std::max(err, fabs(row[j] - density[static_cast<size_t>(i) * n_x + j]) / std::max(1.0, row[j])); 
+	}
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << "Potential barrier density map, " << n_E << " energies x " << n_x << " positions on " << parallel_funcs::num_threads() << " threads\n"; 
+	std::cout << "Map engine: " << rate << " points / s\n"; 
+	std::cout << "Row by row: " << (static_cast<double>(n_check) * n_x) / std::chrono::duration<double>(t1 - t0).count() << " points / s\n"; 
+	std::cout << "max relative difference = " << err << "\n\n"; 
+
+	// streamed version
+	rate = map_funcs::density_map(barr, E_start, 100 * dE, n_E / 100, x_start, dx, n_x, "Barrier_Density_Map.txt"); 
+
+	std::cout << "Streamed " << n_E / 100 << " x " << n_x << " map to Barrier_Density_Map.txt: " << rate << " points / s\n"; 
+}
+
+void testing::problem_batch()
+{
+	// solve a batch of independent step and barrier problems with random mass, energy and potential
+	// the results are compared with step_soln and barr_soln built one problem at a time, and the time per problem is reported
+
+	int n_problems = 1000000; 
+	unsigned long long seed = 12345; 
+
+	// uniform random number on [0, 1), a 64 bit linear congruential generator is enough here
+	auto uniform = [&seed]() { seed = 6364136223846793005ULL * seed + 1442695040888963407ULL; return static_cast<double>(seed >> 11) / 9007199254740992.0; }; 
+
+	step_batch steps; 
+	barr_batch barrs; 
+
+	steps.resize(n_problems); 
+	barrs.resize(n_problems); 
+
+	for (int i = 0; i < n_problems; i++) {
+		steps.mass[i] = barrs.mass[i] = (0.05 + 0.95 * uniform()) * M_ELECTRON_KG; 
+		steps.E[i] = barrs.E[i] = 0.01 + 2.0 * uniform(); // E > V and E < V mixed within every group of lanes
+		steps.V[i] = barrs.V[i] = 0.1 + 2.0 * uniform(); 
+		barrs.W[i] = 0.2 + 3.0 * uniform(); 
+	}
+
+	steps.E[7] = -1.0; // one bad problem to check the status flags
+
+	batch_funcs::solve(steps); // first calls touch the output arrays
+	batch_funcs::solve(barrs); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	int n_bad_step = batch_funcs::solve(steps); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	int n_bad_barr = batch_funcs::solve(barrs); 
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	double dT_step = 0.0, dT_barr = 0.0; 
+	int n_barr = 0; 
+
+	for (int i = 0; i < n_problems; i++) {
+		if (steps.status[i] == EVAL_OK) {
+			step_soln soln(steps.mass[i], steps.E[i], steps.V[i]); 
+			dT_step = std::max(dT_step, fabs(soln.get_T() - steps.T[i]) + fabs(soln.get_R() - steps.R[i])); 
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point t3 = std::chrono::high_resolution_clock::now(); 
+
+	for (int i = 0; i < n_problems; i++) {
+		if (barrs.status[i] == EVAL_OK) {
+			barr_soln soln(barrs.mass[i], barrs.E[i], barrs.V[i], barrs.W[i]); 
+			dT_barr = std::max(dT_barr, fabs(soln.get_T() - barrs.T[i]) / std::max(soln.get_T(), 1.0e-300)); 
+			n_barr++; 
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point t4 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << n_problems << " potential step problems, " << n_bad_step << " flagged, status of E < 0 problem = " << steps.status[7] << "\n"; 
+	std::cout << "Batch: " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / n_problems << " ns per problem , one at a time: " << 1.0e9 * std::chrono::duration<double>(t3 - t2).count() / n_problems << " ns per problem\n"; 
+	std::cout << "max |dT| + |dR| = " << dT_step << "\n\n"; 
+
+	std::cout << n_problems << " potential barrier problems, " << n_bad_barr << " flagged as E >= V\n"; 
+	std::cout << "Batch: " << 1.0e9 * std::chrono::duration<double>(t2 - t1).count() / n_problems << " ns per problem , one at a time: " << 1.0e9 * std::chrono::duration<double>(t4 - t3).count() / n_barr << " ns per problem\n"; 
+	std::cout << "max relative |dT| = " << dT_barr << "\n\n"; 
+
+	// NaN inputs in full groups of four lanes must come out as NaN, from the batch solver and from the exp kernel it shares with wave_kernels
+	double nan = std::numeric_limits<double>::quiet_NaN(); 
+	std::vector<double> x_nan = { 0.1, nan, 0.3, 0.4, nan, 0.6, 0.7, 0.8 }, psi_nan(x_nan.size()); 
+
+	wave_kernels::decaying(1.0, 1.0, x_nan.data(), static_cast<int>(x_nan.size()), psi_nan.data()); 
+
+	barrs.resize(8); 
+	for (int i = 0; i < 8; i++) { barrs.mass[i] = M_ELECTRON_KG; barrs.E[i] = 0.5; barrs.V[i] = 1.0; barrs.W[i] = 1.0; } 
+	barrs.E[1] = nan; barrs.W[4] = nan; 
+	batch_funcs::solve(barrs); 
+
+	bool nan_ok = true; 
+	for (int i = 0; i < 8; i++) {
+		bool lane_nan = (i == 1 || i == 4); 
+		if (std::isnan(psi_nan[i]) != lane_nan || std::isnan(barrs.T[i]) != lane_nan || (barrs.status[i] != EVAL_OK) != lane_nan) nan_ok = false; 
+	}
+	std::cout << "NaN lanes propagate through exp and the barrier batch: " << (nan_ok ? "pass" : "FAIL") << "\n"; 
+}
+
 void testing::infinite_well()
 {
 	// test the implementation of the code for the infinite square well
@@ -101,4 +815,1101 @@ void testing::infinite_well()
 	std::cout<<"\n";
 
 	std::cout<<"Probability of being located at position x = 0.7: "<<template_funcs::DSQR( the_well.energy_eigenfunction(1, pos) )<<"\n";
-}
\ No newline at end of file
+}
+
+void testing::infinite_well_table()
+{
+	// all levels at once evaluation of the infinite well eigenfunctions against the scalar method, in both layouts
+	// E_1 is compared with h^{2} / 8 m L^{2} and with the ground state of a deep finite well of the same length
+
+	double length = 20.0, centre = 3.0; 
+
+	inf_well the_well(length, M_ELECTRON_KG, centre); 
+
+	double E1 = template_funcs::DSQR(PLANCK_CONST_J) / (8.0 * M_ELECTRON_KG * template_funcs::DSQR(length * 1.0e-9) * template_funcs::convert_ev_J(1.0)); 
+	fin_well deep_well(length, M_ELECTRON_KG, M_ELECTRON_KG, 1000.0, centre); 
+
+	std::cout << "Infinite well E_1 = " << the_well.energy_eigenvalue(1) << " eV, h^2 / 8 m L^2 = " << E1 << " eV, deep finite well E_0 = " << deep_well.energy_eigenvalue(0) << " eV\n"; 
+
+	int n_levels = 1000, n_x = 4096; 
+	std::vector<double> x(n_x), E(n_levels), psi_n(static_cast<size_t>(n_levels) * n_x), psi_x(static_cast<size_t>(n_levels) * n_x); 
+	for (int i = 0; i < n_x; i++) x[i] = centre - 0.5 * length + length * (i + 0.5) / n_x; 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	the_well.energy_eigenfunction_table(x.data(), n_x, n_levels, psi_n.data(), E.data(), true); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	the_well.energy_eigenfunction_table(x.data(), n_x, n_levels, psi_x.data(), nullptr, false); 
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	double max_n = 0.0, max_x = 0.0, max_E = 0.0, sum = 0.0; 
+	for (int n = 1; n <= n_levels; n++) {
+		max_E = std::max(max_E, fabs(E[n - 1] - the_well.energy_eigenvalue(n)) / E[n - 1]); 
+		for (int i = 0; i < n_x; i++) {
+			double psi = the_well.energy_eigenfunction(n, x[i]); 
+			sum += psi; 
+			max_n = std::max(max_n, fabs(psi_n[static_cast<size_t>(n - 1) * n_x + i] - psi)); 
+			max_x = std::max(max_x, fabs(psi_x[static_cast<size_t>(i) * n_levels + n - 1] - psi)); 
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point t3 = std::chrono::high_resolution_clock::now(); 
+
+	double n_total = static_cast<double>(n_levels) * n_x; 
+
+	std::cout << n_levels << " levels at " << n_x << " positions, max relative error in E_n = " << max_E << "\n"; 
+	std::cout << "max |table - scalar|, n-major = " << max_n << " , x-major = " << max_x << " , sqrt(2 / L) = " << sqrt(2.0 / length) << "\n"; 
+	std::cout << "n-major table: " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / n_total << " ns / entry\n"; 
+	std::cout << "x-major table: " << 1.0e9 * std::chrono::duration<double>(t2 - t1).count() / n_total << " ns / entry\n"; 
+	std::cout << "scalar calls + compare: " << 1.0e9 * std::chrono::duration<double>(t3 - t2).count() / n_total << " ns / entry (" << sum << ")\n"; 
+
+	// positions outside the well give zero
+	double outside[2] = { centre - length, centre + length }, psi_out[4]; 
+	the_well.energy_eigenfunction_table(outside, 2, 2, psi_out); 
+	std::cout << "outside the well: " << psi_out[0] << " " << psi_out[1] << " " << psi_out[2] << " " << psi_out[3] << "\n"; 
+}
+
+void testing::well_evolution()
+{
+	// time evolution of a Gaussian wavepacket in an infinite well by discrete sine transforms
+	// the frames at t = 0 and at the revival time should reproduce the initial state, the norm should be conserved
+	// and an intermediate frame is compared with the direct sum over the eigenstates from inf_well::energy_eigenfunction_table
+
+	double length = 20.0, x0 = -4.0, sigma = 1.0, k0 = 5.0; // packet centred at x0 with width sigma and mean wavenumber k0 in nm^{-1}
+	int P = 1024; 
+
+	inf_well_evolution packet(length, M_ELECTRON_KG, P); 
+
+	packet.set_initial_state([=](double x) { return exp(-0.25 * template_funcs::DSQR((x - x0) / sigma)) * std::polar(1.0, k0 * x) / sqrt(sigma * sqrt(Two_PI)); }); 
+
+	int M = packet.get_M(); 
+	double dx = length / P, T_rev = packet.revival_time(); 
+
+	std::vector<std::complex<double>> psi0(M), psi(M), work(2 * P); 
+	for (int j = 0; j < M; j++) { double x = packet.position(j); psi0[j] = exp(-0.25 * template_funcs::DSQR((x - x0) / sigma)) * std::polar(1.0, k0 * x) / sqrt(sigma * sqrt(Two_PI)); }
+
+	std::cout << "Infinite well L = " << length << " nm, M = " << M << " grid points, revival time = " << T_rev * 1.0e12 << " ps\n"; 
+
+	double times[3] = { 0.0, 0.37 * T_rev, T_rev }; 
+	for (int t = 0; t < 3; t++) {
+		packet.frame(times[t], &psi[0], &work[0]); 
+
+		double norm = 0.0, diff = 0.0; 
+		for (int j = 0; j < M; j++) {
+			norm += std::norm(psi[j]) * dx; 
+			diff = std::max(diff, std::abs(psi[j] - psi0[j])); 
+		}
+
+		std::cout << "t = " << times[t] / T_rev << " T_rev: int |psi|^2 dx = " << std::setprecision(15) << norm << std::setprecision(6) << " , max |psi - psi(0)| = " << diff << "\n"; 
+	}
+
+	// direct sum over every eigenstate at t = 0.37 T_rev
+	inf_well the_well(length, M_ELECTRON_KG); 
+
+	std::vector<double> x(M), basis(static_cast<size_t>(M) * M), E(M); 
+	for (int j = 0; j < M; j++) x[j] = packet.position(j); 
+
+	the_well.energy_eigenfunction_table(&x[0], M, M, &basis[0], &E[0]); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	std::vector<std::complex<double>> direct(M, std::complex<double>(0.0, 0.0)); 
+	for (int n = 1; n <= M; n++) {
+		std::complex<double> cn = packet.coefficient(n) * std::polar(1.0, -fmod(E[n - 1] * times[1] / H_BAR_eV, Two_PI)); 
+		for (int j = 0; j < M; j++) direct[j] += cn * basis[static_cast<size_t>(n - 1) * M + j]; 
+	}
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	int n_repeat = 100; 
+	for (int r = 0; r < n_repeat; r++) packet.frame(times[1], &psi[0], &work[0]); 
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	double diff = 0.0; 
+	for (int j = 0; j < M; j++) diff = std::max(diff, std::abs(psi[j] - direct[j])); 
+
+	std::cout << "t = 0.37 T_rev, max |DST - direct sum| = " << diff << "\n"; 
+	std::cout << "direct sum: " << 1.0e6 * std::chrono::duration<double>(t1 - t0).count() << " us / frame, DST: " << 1.0e6 * std::chrono::duration<double>(t2 - t1).count() / n_repeat << " us / frame\n"; 
+
+	// streamed evolution over one revival period
+	int n_frames = 2000; 
+	double rate = packet.evolve(0.0, T_rev / n_frames, n_frames, "Well_Evolution.txt"); 
+
+	std::cout << "Streamed " << n_frames << " frames to Well_Evolution.txt: " << rate << " frames / s\n"; 
+}
+
+void testing::harmonic_well()
+{
+	// Hermite function table of the harmonic well: small n against H_n(xi) exp(-xi^{2} / 2), orthonormality for n in the thousands,
+	// positions far in the forbidden region, and the n-major and x-major layouts against the scalar method
+
+	double m = 0.067 * M_ELECTRON_KG; 
+
+	harm_well the_well; 
+	the_well.set_graded_params(20.0, m, 0.3); 
+
+	double x0 = the_well.get_x0(); 
+
+	std::cout << "Graded well L = 20 nm, V_0 = 0.3 eV: hbar omega = " << the_well.get_hbar_omega() << " eV, x_0 = " << x0 << " nm, E_0 = " << the_well.energy_eigenvalue(0) << " eV\n"; 
+
+	// explicit Hermite polynomials for small n, H_{n+1} = 2 xi H_n - 2 n H_{n-1}
+	double max_diff = 0.0; 
+	for (double xi = -6.0; xi <= 6.0; xi += 0.25) {
+		double h_prev = 0.0, h = 1.0, norm = 1.0 / sqrt(sqrt(PI) * x0); // (2^n n! sqrt(pi) x_0)^{-1/2}
+		for (int n = 0; n <= 20; n++) {
+			max_diff = std::max(max_diff, fabs(the_well.energy_eigenfunction(n, xi * x0) - norm * h * exp(-0.5 * xi * xi))); 
+			double h_next = 2.0 * xi * h - 2.0 * n * h_prev; 
+			h_prev = h; 
+			h = h_next; 
+			norm /= sqrt(2.0 * (n + 1.0)); 
+		}
+	}
+	std::cout << "n <= 20, |xi| <= 6: max |recurrence - H_n exp(-xi^2 / 2)| = " << max_diff << " nm^{-1/2}\n"; 
+
+	// orthonormality by the trapezoidal rule, which is spectrally accurate for these functions once the spacing resolves the fastest oscillation
+	int n_levels = 2048, n_pts = 4096; 
+	double xi_max = 72.0, dxi = 2.0 * xi_max / (n_pts - 1); 
+	std::vector<double> x(n_pts), table(static_cast<size_t>(n_levels) * n_pts), energies(n_levels); 
+	for (int i = 0; i < n_pts; i++) x[i] = x0 * (-xi_max + i * dxi); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	the_well.energy_eigenfunction_table(x.data(), n_pts, n_levels, table.data(), energies.data()); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	bool finite = true; 
+	for (size_t k = 0; k < table.size(); k++) if (!(fabs(table[k]) < 1.0e10)) finite = false; 
+
+	auto overlap = [&](int p, int q) {
+		double sum = 0.0; 
+		for (int i = 0; i < n_pts; i++) sum += table[static_cast<size_t>(p) * n_pts + i] * table[static_cast<size_t>(q) * n_pts + i]; 
+		return ( sum * dxi * x0 ); 
+	}; 
+
+	double max_orth = 0.0; 
+	for (int n = 0; n < n_levels; n++) for (int k = 0; k <= 2 && n + k < n_levels; k++) max_orth = std::max(max_orth, fabs(overlap(n, n + k) - (k == 0 ? 1.0 : 0.0))); 
+	for (int t = 0; t < 2000; t++) {
+		int p = (t * 7919) % n_levels, q = (t * 104729 + 13) % n_levels; 
+		max_orth = std::max(max_orth, fabs(overlap(p, q) - (p == q ? 1.0 : 0.0))); 
+	}
+
+	std::cout << n_levels << " levels at " << n_pts << " positions, |xi| <= " << xi_max << ": all values finite " << (finite ? "yes" : "no") << ", max |<p|q> - delta_pq| = " << max_orth << "\n"; 
+	std::cout << "E_" << n_levels - 1 << " = " << energies[n_levels - 1] << " eV, table " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / (static_cast<double>(n_levels) * n_pts) << " ns / entry\n"; 
+
+	// scalar method and x-major layout against the n-major table
+	std::vector<double> table_x(static_cast<size_t>(n_levels) * n_pts); 
+	the_well.energy_eigenfunction_table(x.data(), n_pts, n_levels, table_x.data(), nullptr, false); 
+
+	double max_layout = 0.0, max_scalar = 0.0; 
+	for (int n = 0; n < n_levels; n++) for (int i = 0; i < n_pts; i++) max_layout = std::max(max_layout, fabs(table[static_cast<size_t>(n) * n_pts + i] - table_x[static_cast<size_t>(i) * n_levels + n])); 
+	for (int n = 0; n < n_levels; n += 97) for (int i = 0; i < n_pts; i += 61) max_scalar = std::max(max_scalar, fabs(table[static_cast<size_t>(n) * n_pts + i] - the_well.energy_eigenfunction(n, x[i]))); 
+
+	std::cout << "max |n-major - x-major| = " << max_layout << ", max |table - scalar| = " << max_scalar << "\n"; 
+
+	// far in the forbidden region of the low levels, the values underflow to zero and grow to O(1) near the turning point sqrt(2 n + 1)
+	std::cout << "xi = 50, turning point at n = 1250:"; 
+	for (int n = 0; n <= 1600; n += 200) std::cout << " n = " << n << ": " << sqrt(x0) * the_well.energy_eigenfunction(n, 50.0 * x0); 
+	std::cout << "\n"; 
+}
+
+void testing::separable_box()
+{
+	// lowest states of separable boxes, wires and dots against a brute force enumeration of every 1D level combination
+
+	double L = 10.0; 
+
+	// cube of infinite wells, degeneracies 1, 3, 3, 3, 1, 6, ...
+	sep_box cube; 
+	for (int a = 0; a < 3; a++) cube.set_direction(a, inf_well(L, M_ELECTRON_KG)); 
+
+	std::vector<box_state> states; 
+	cube.lowest_states(20, states); 
+
+	std::cout << "Infinite cube L = " << L << " nm, lowest 20 states\n"; 
+	for (size_t s = 0; s < states.size(); s++) std::cout << "(" << states[s].n[0] << ", " << states[s].n[1] << ", " << states[s].n[2] << ") E = " << states[s].E << " eV, degeneracy " << states[s].degeneracy << "\n"; 
+	std::cout << "\n"; 
+
+	// dot of three different finite wells
+	double Ls[3] = { 8.0, 12.0, 20.0 }; 
+	fin_well wells[3]; 
+	sep_box dot; 
+	for (int a = 0; a < 3; a++) { wells[a].set_well_params(Ls[a], 0.067 * M_ELECTRON_KG, 0.092 * M_ELECTRON_KG, 0.6); dot.set_direction(a, wells[a]); }
+
+	std::vector<double> brute; 
+	for (int i = 0; i < wells[0].get_n_states(); i++) for (int j = 0; j < wells[1].get_n_states(); j++) for (int k = 0; k < wells[2].get_n_states(); k++) brute.push_back(wells[0].energy_eigenvalue(i) + wells[1].energy_eigenvalue(j) + wells[2].energy_eigenvalue(k)); 
+	std::sort(brute.begin(), brute.end()); 
+
+	dot.lowest_states(static_cast<int>(brute.size()) + 10, states); 
+
+	double max_diff = 0.0; 
+	for (size_t s = 0; s < states.size(); s++) max_diff = std::max(max_diff, fabs(states[s].E - brute[s])); 
+
+	std::cout << "Finite dot " << Ls[0] << " x " << Ls[1] << " x " << Ls[2] << " nm: " << states.size() << " states found, " << brute.size() << " by enumeration, max |E - E_brute| = " << max_diff << " eV\n"; 
+
+	// wire confined in x and y, free along z
+	sep_box wire; 
+	wire.set_direction(0, wells[0]); 
+	wire.set_direction(1, wells[0]); 
+	wire.lowest_states(6, states); 
+
+	std::cout << "Square wire " << Ls[0] << " x " << Ls[0] << " nm subband edges:"; 
+	for (size_t s = 0; s < states.size(); s++) std::cout << " " << states[s].E << " (x" << states[s].degeneracy << ")"; 
+	std::cout << "\n\n"; 
+
+	// wavefunction on a grid from cached 1D factors against the scalar method, and the normalisation of the grid values
+	int n_g = 64; 
+	std::vector<double> gx(n_g), gy(n_g), gz(n_g), psi; 
+	for (int g = 0; g < n_g; g++) { gx[g] = -10.0 + 20.0 * g / (n_g - 1.0); gy[g] = -14.0 + 28.0 * g / (n_g - 1.0); gz[g] = -20.0 + 40.0 * g / (n_g - 1.0); }
+	dot.set_grid(0, gx); dot.set_grid(1, gy); dot.set_grid(2, gz); 
+
+	dot.lowest_states(50, states); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	double max_grid = 0.0; 
+	for (size_t s = 0; s < states.size(); s++) {
+		dot.wavefunction_grid(states[s], psi); 
+
+		for (int ix = 0; ix < n_g; ix += 7) for (int iy = 0; iy < n_g; iy += 5) for (int iz = 0; iz < n_g; iz += 3) {
+			max_grid = std::max(max_grid, fabs(psi[(static_cast<size_t>(ix) * n_g + iy) * n_g + iz] - dot.wavefunction(states[s], gx[ix], gy[iy], gz[iz]))); 
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << "50 dot states on a " << n_g << "^3 grid, max |grid - scalar| = " << max_grid << ", " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms including the checks\n\n"; 
+
+	// many states of a large box, heap search against enumerating and sorting every combination up to the same 1D level
+	sep_box big; 
+	big.set_direction(0, inf_well(100.0, M_ELECTRON_KG)); 
+	big.set_direction(1, inf_well(130.0, M_ELECTRON_KG)); 
+	big.set_direction(2, inf_well(170.0, M_ELECTRON_KG)); 
+
+	int n_want = 20000; 
+
+	t0 = std::chrono::high_resolution_clock::now(); 
+	big.lowest_states(n_want, states); 
+	t1 = std::chrono::high_resolution_clock::now(); 
+
+	// every state in the list has n_a <= n_max along each direction, so enumerating up to n_max covers them
+	int n_max = 0; 
+	for (size_t s = 0; s < states.size(); s++) for (int a = 0; a < 3; a++) n_max = std::max(n_max, states[s].n[a]); 
+
+	inf_well wx(100.0, M_ELECTRON_KG), wy(130.0, M_ELECTRON_KG), wz(170.0, M_ELECTRON_KG); 
+	brute.clear(); 
+	for (int i = 1; i <= n_max; i++) for (int j = 1; j <= n_max; j++) for (int k = 1; k <= n_max; k++) brute.push_back(wx.energy_eigenvalue(i) + wy.energy_eigenvalue(j) + wz.energy_eigenvalue(k)); 
+	std::sort(brute.begin(), brute.end()); 
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	max_diff = 0.0; 
+	for (int s = 0; s < n_want; s++) max_diff = std::max(max_diff, fabs(states[s].E - brute[s]) / brute[s]); 
+
+	std::cout << "Lowest " << n_want << " states of a 100 x 130 x 170 nm box, max relative |E - E_brute| = " << max_diff << "\n"; 
+	std::cout << "heap search: " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms, enumerate " << n_max << "^3 and sort: " << 1.0e3 * std::chrono::duration<double>(t2 - t1).count() << " ms\n"; 
+}
+
+void testing::finite_well()
+{
+	// bound states of a GaAs / AlGaAs finite well and of a deep, wide well with hundreds of states
+	// the energies are checked against the even / odd conditions alpha / m_b = (k / m_w) tan(k L / 2), -(k / m_w) cot(k L / 2)
+	// and the eigenfunctions against a numerical normalisation integral
+
+	double length = 10.0, depth = 0.3; 
+	double m_w = 0.067 * M_ELECTRON_KG, m_b = 0.092 * M_ELECTRON_KG; 
+
+	fin_well the_well(length, m_w, m_b, depth); 
+
+	std::cout << "Finite well L = " << length << " nm, V = " << depth << " eV, " << the_well.get_n_states() << " bound states\n"; 
+
+	for (int n = 0; n < the_well.get_n_states(); n++) {
+		double E = the_well.energy_eigenvalue(n); 
+		double k = sqrt(2.0 * m_w * template_funcs::convert_ev_J(E)) * 1.0e-9 / H_BAR_J; 
+		double alpha = sqrt(2.0 * m_b * template_funcs::convert_ev_J(depth - E)) * 1.0e-9 / H_BAR_J; 
+		double residual = n % 2 == 0 ? alpha / m_b - (k / m_w) * tan(0.5 * k * length) : alpha / m_b + (k / m_w) / tan(0.5 * k * length); 
+
+		// normalisation by the trapezoidal rule over the well and 40 decay lengths either side
+		int n_pts = 200000; 
+		double x_lo = -0.5 * length - 40.0 / alpha, dx = (length + 80.0 / alpha) / n_pts, integral = 0.0; 
+		for (int j = 0; j <= n_pts; j++) integral += (j == 0 || j == n_pts ? 0.5 : 1.0) * template_funcs::DSQR(the_well.energy_eigenfunction(n, x_lo + j * dx)); 
+
+		std::cout << "E_" << n << " = " << std::setprecision(10) << E << " eV , relative residual = " << residual / (k / m_w) << " , int |psi|^2 dx = " << integral * dx << "\n"; 
+	}
+	std::cout << "\n"; 
+
+	// deep, wide well
+	fin_well deep_well(500.0, M_ELECTRON_KG, M_ELECTRON_KG, 10.0); 
+
+	int n_repeat = 20; 
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	for (int r = 0; r < n_repeat; r++) deep_well.set_well_params(500.0, M_ELECTRON_KG, M_ELECTRON_KG, 10.0); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	inf_well inf(500.0, M_ELECTRON_KG); 
+
+	std::cout << "Finite well L = 500 nm, V = 10 eV, " << deep_well.get_n_states() << " bound states solved in " << 1.0e6 * std::chrono::duration<double>(t1 - t0).count() / n_repeat << " us\n"; 
+	std::cout << "E_0 = " << deep_well.energy_eigenvalue(0) << " eV , E_N-1 = " << deep_well.energy_eigenvalue(deep_well.get_n_states() - 1) << " eV\n"; 
+	std::cout << "Infinite well E_1 = " << inf.energy_eigenvalue(1) << " eV\n"; 
+}
+
+void testing::finite_well_continuation()
+{
+	// sweeps of the width and depth of a GaAs / AlGaAs finite well, solved from scratch at every point and by continuation
+	// the levels should agree, the continuation should need far fewer eigenequation evaluations,
+	// and new levels should appear at the top of the well with the index after the last existing level
+
+	double m_w = 0.067 * M_ELECTRON_KG, m_b = 0.092 * M_ELECTRON_KG; 
+	int n_points = 20000; 
+
+	for (int sweep = 0; sweep < 2; sweep++) {
+		bool width = (sweep == 0); 
+		double p_lo = width ? 2.0 : 0.05, p_hi = width ? 40.0 : 1.0; // L in nm with V = 0.3 eV, or V in eV with L = 15 nm
+
+		fin_well cold, warm; 
+		long long cold_calls = 0, warm_calls = 0, cold_levels = 0, warm_levels = 0; 
+		double max_diff = 0.0, t_cold = 0.0, t_warm = 0.0; 
+		int n_appeared = 0; 
+
+		for (int i = 0; i < n_points; i++) {
+			double par = p_lo + (p_hi - p_lo) * i / (n_points - 1.0); 
+			double L = width ? par : 15.0, V = width ? 0.3 : par; 
+
+			std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+			cold.set_well_params(L, m_w, m_b, V); 
+
+			std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+			int n_new = warm.continue_well_params(L, m_w, m_b, V); 
+
+			std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+			t_cold += std::chrono::duration<double>(t1 - t0).count(); 
+			t_warm += std::chrono::duration<double>(t2 - t1).count(); 
+
+			cold_calls += cold.get_root_calls(); cold_levels += cold.get_n_states(); 
+			warm_calls += warm.get_root_calls(); warm_levels += warm.get_n_states(); 
+
+			if (i > 0 && n_new > 0) {
+				n_appeared += n_new; 
+				if (n_appeared <= 3) std::cout << "level " << warm.get_n_states() - 1 << " appears at " << (width ? "L = " : "V = ") << par << (width ? " nm" : " eV") << " with E = " << warm.energy_eigenvalue(warm.get_n_states() - 1) << " eV\n"; 
+			}
+
+			if (cold.get_n_states() != warm.get_n_states()) std::cout << "state count differs at point " << i << "\n"; 
+			for (int n = 0; n < std::min(cold.get_n_states(), warm.get_n_states()); n++) max_diff = std::max(max_diff, fabs(cold.energy_eigenvalue(n) - warm.energy_eigenvalue(n)) / cold.energy_eigenvalue(n)); 
+		}
+
+		std::cout << (width ? "Width" : "Depth") << " sweep of " << n_points << " points, " << n_appeared << " levels appeared, max relative |E_warm - E_cold| = " << max_diff << "\n"; 
+		std::cout << "cold: " << static_cast<double>(cold_calls) / cold_levels << " calls / level, " << 1.0e6 * t_cold / n_points << " us / point\n"; 
+		std::cout << "warm: " << static_cast<double>(warm_calls) / warm_levels << " calls / level, " << 1.0e6 * t_warm / n_points << " us / point\n\n"; 
+	}
+}
+
+void testing::finite_well_nonparabolic()
+{
+	// finite well with Kane non-parabolic masses, In0.53Ga0.47As well with InP-like barriers
+	// the levels are checked against the tan / cot conditions with the energy dependent masses,
+	// very large gaps should reproduce the parabolic levels, and the cost of a non-parabolic solve is compared with the parabolic one
+
+	double length = 10.0, depth = 0.25, Eg_w = 0.75, Eg_b = 1.42; 
+	double m_w = 0.041 * M_ELECTRON_KG, m_b = 0.077 * M_ELECTRON_KG; 
+
+	fin_well para(length, m_w, m_b, depth), kane, limit; 
+
+	kane.set_nonparabolicity(Eg_w, Eg_b); 
+	kane.set_well_params(length, m_w, m_b, depth); 
+
+	limit.set_nonparabolicity(1.0e9, 1.0e9); 
+	limit.set_well_params(length, m_w, m_b, depth); 
+
+	std::cout << "In0.53Ga0.47As / InP well L = " << length << " nm, V = " << depth << " eV\n"; 
+	std::cout << "parabolic: " << para.get_n_states() << " levels, Kane: " << kane.get_n_states() << " levels\n"; 
+
+	for (int n = 0; n < kane.get_n_states(); n++) {
+		double E = kane.energy_eigenvalue(n); 
+		double mw = m_w * (1.0 + E / Eg_w), mb = m_b * (1.0 + (E - depth) / Eg_b); 
+		double k = sqrt(2.0 * mw * template_funcs::convert_ev_J(E)) * 1.0e-9 / H_BAR_J; 
+		double alpha = sqrt(2.0 * mb * template_funcs::convert_ev_J(depth - E)) * 1.0e-9 / H_BAR_J; 
+		double residual = n % 2 == 0 ? alpha / mb - (k / mw) * tan(0.5 * k * length) : alpha / mb + (k / mw) / tan(0.5 * k * length); 
+
+		std::cout << "E_" << n << ": parabolic " << std::setprecision(10) << (n < para.get_n_states() ? para.energy_eigenvalue(n) : 0.0) << " eV , Kane " << E << " eV , relative residual " << residual / (k / mw); 
+		std::cout << " , Eg -> inf " << fabs(limit.energy_eigenvalue(n < para.get_n_states() ? n : 0) - para.energy_eigenvalue(n < para.get_n_states() ? n : 0)) << "\n"; 
+	}
+	std::cout << "\n"; 
+
+	// cost of a deep, wide well with many levels
+	int n_repeat = 200; 
+	fin_well wide_para, wide_kane; 
+	wide_kane.set_nonparabolicity(Eg_w, Eg_b); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	for (int r = 0; r < n_repeat; r++) wide_para.set_well_params(100.0, m_w, m_b, 0.5); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+	for (int r = 0; r < n_repeat; r++) wide_kane.set_well_params(100.0, m_w, m_b, 0.5); 
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	double tp = std::chrono::duration<double>(t1 - t0).count() / n_repeat, tk = std::chrono::duration<double>(t2 - t1).count() / n_repeat; 
+
+	std::cout << "L = 100 nm, V = 0.5 eV\n"; 
+	std::cout << "parabolic: " << wide_para.get_n_states() << " levels, " << static_cast<double>(wide_para.get_root_calls()) / wide_para.get_n_states() << " calls / level, " << 1.0e6 * tp << " us\n"; 
+	std::cout << "Kane: " << wide_kane.get_n_states() << " levels, " << static_cast<double>(wide_kane.get_root_calls()) / wide_kane.get_n_states() << " calls / level, " << 1.0e6 * tk << " us, cost ratio " << tk / tp << "\n\n"; 
+
+	// composition sweep of In(x)Ga(1-x)As wells in InP, linear interpolation of mass and gap between GaAs and InAs, 
+	// band offset taken as 40% of the gap difference, solved from scratch and by continuation
+	int n_points = 2000; 
+	fin_well cold, warm; 
+	long long cold_calls = 0, warm_calls = 0, levels = 0; 
+	double max_diff = 0.0; 
+
+	for (int i = 0; i < n_points; i++) {
+		double x = 0.45 + 0.3 * i / (n_points - 1.0); 
+		double gap = 1.424 * (1.0 - x) + 0.354 * x, mass = (0.067 * (1.0 - x) + 0.023 * x) * M_ELECTRON_KG, V = 0.4 * (1.344 - gap); 
+
+		cold.set_nonparabolicity(gap, Eg_b); 
+		cold.set_well_params(length, mass, m_b, V); 
+
+		warm.set_nonparabolicity(gap, Eg_b); 
+		warm.continue_well_params(length, mass, m_b, V); 
+
+		cold_calls += cold.get_root_calls(); warm_calls += warm.get_root_calls(); levels += cold.get_n_states(); 
+		for (int n = 0; n < std::min(cold.get_n_states(), warm.get_n_states()); n++) max_diff = std::max(max_diff, fabs(cold.energy_eigenvalue(n) - warm.energy_eigenvalue(n)) / cold.energy_eigenvalue(n)); 
+	}
+
+	std::cout << "Composition sweep of " << n_points << " points, max relative |E_warm - E_cold| = " << max_diff << "\n"; 
+	std::cout << "cold: " << static_cast<double>(cold_calls) / levels << " calls / level, warm: " << static_cast<double>(warm_calls) / levels << " calls / level\n"; 
+}
+
+void testing::finite_well_eigenfunctions()
+{
+	// batch evaluation of the finite well eigenfunctions against the scalar method
+	// the overlap matrix <m|n> computed from the table by the trapezoidal rule should be the identity
+
+	fin_well the_well(10.0, 0.067 * M_ELECTRON_KG, 0.092 * M_ELECTRON_KG, 0.3); 
+
+	int n_states = the_well.get_n_states(), n_pts = 20001; 
+	double x_lo = -40.0, dx = 80.0 / (n_pts - 1); 
+
+	std::vector<double> x(n_pts), table(static_cast<size_t>(n_states) * n_pts); 
+	for (int i = 0; i < n_pts; i++) x[i] = x_lo + i * dx; 
+
+	the_well.energy_eigenfunction_table(x.data(), n_pts, 0, n_states, table.data()); 
+
+	double max_diff = 0.0; 
+	for (int n = 0; n < n_states; n++) for (int i = 0; i < n_pts; i++) max_diff = std::max(max_diff, fabs(table[n * n_pts + i] - the_well.energy_eigenfunction(n, x[i]))); 
+
+	std::cout << "Finite well, " << n_states << " states at " << n_pts << " positions, max |table - scalar| = " << max_diff << "\n"; 
+
+	for (int m = 0; m < n_states; m++) {
+		for (int n = 0; n < n_states; n++) {
+			double overlap = 0.0; 
+			for (int i = 0; i < n_pts; i++) overlap += (i == 0 || i == n_pts - 1 ? 0.5 : 1.0) * table[m * n_pts + i] * table[n * n_pts + i]; 
+			std::cout << std::setw(14) << overlap * dx; 
+		}
+		std::cout << "\n"; 
+	}
+	std::cout << "\n"; 
+
+	// many states at many positions
+	fin_well deep_well(200.0, M_ELECTRON_KG, M_ELECTRON_KG, 10.0); 
+
+	int n_deep = deep_well.get_n_states(), n_x = 4096; 
+	std::vector<double> xd(n_x), deep_table(static_cast<size_t>(n_deep) * n_x); 
+	for (int i = 0; i < n_x; i++) xd[i] = -120.0 + 240.0 * i / (n_x - 1.0); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	deep_well.energy_eigenfunction_table(xd.data(), n_x, 0, n_deep, deep_table.data()); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	max_diff = 0.0; 
+	for (int n = 0; n < n_deep; n++) for (int i = 0; i < n_x; i++) max_diff = std::max(max_diff, fabs(deep_table[static_cast<size_t>(n) * n_x + i] - deep_well.energy_eigenfunction(n, xd[i]))); 
+
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	double n_total = static_cast<double>(n_deep) * n_x; 
+
+	std::cout << "Finite well, " << n_deep << " states at " << n_x << " positions, max |table - scalar| = " << max_diff << "\n"; 
+	std::cout << "table: " << 1.0e9 * std::chrono::duration<double>(t1 - t0).count() / n_total << " ns / point\n"; 
+	std::cout << "scalar + compare: " << 1.0e9 * std::chrono::duration<double>(t2 - t1).count() / n_total << " ns / point\n"; 
+}
+void testing::cylindrical_wire()
+{
+	// bound states of a cylindrical wire, each level is compared with the root of the matching condition evaluated with the full 
+	// precision special::bessjy and special::bessik, a deep barrier should approach the zeros of J_m and a radius sweep should agree 
+	// with solving each radius from scratch
+
+	double m_w = 0.067 * M_ELECTRON_KG, m_b = 0.092 * M_ELECTRON_KG, V = 0.3, r = m_b / m_w; 
+
+	cyl_wire wire(10.0, m_w, m_b, V); 
+
+	double u_max = wire.get_u_max(), max_rel = 0.0; 
+	int n_total = 0; 
+
+	std::cout << "Cylindrical wire a = 10 nm, V = " << V << " eV, u_max = " << u_max << ", " << wire.get_n_channels() << " channels\n"; 
+	for (int m = 0; m < wire.get_n_channels(); m++) {
+		std::cout << "m = " << m << ":"; 
+		for (int n = 0; n < wire.get_n_states(m); n++) {
+			double E = wire.energy_eigenvalue(m, n), u = u_max * sqrt(E / V); 
+
+			auto F = [m, r, u_max](double x) {
+				double rj, ry, rjp, ryp, ri, rk, rip, rkp; 
+				special::bessjy(x, m, &rj, &ry, &rjp, &ryp); 
+				special::bessik(sqrt(r * (u_max * u_max - x * x)), m, &ri, &rk, &rip, &rkp); 
+				return ( r * x * rjp / rj - sqrt(r * (u_max * u_max - x * x)) * rkp / rk ); 
+			}; 
+
+			int iter; 
+			double lo = u * (1.0 - 1.0e-4), hi = std::min(u * (1.0 + 1.0e-4), u_max * (1.0 - 1.0e-12)); 
+			double u_ref = root_funcs::brent(F, lo, hi, F(lo), F(hi), 1.0e-15 * hi, iter); 
+
+			max_rel = std::max(max_rel, fabs(E / (V * template_funcs::DSQR(u_ref / u_max)) - 1.0)); 
+			std::cout << " " << E; 
+			n_total++; 
+		}
+		std::cout << "\n"; 
+	}
+	std::cout << n_total << " levels, max relative difference from the full precision Bessel functions = " << max_rel << "\n\n"; 
+
+	// deep barrier, u -> j_{m,s}
+	double j_ms[3][2] = { { 2.404825557695773, 5.520078110286311 }, { 3.831705970207512, 7.015586669815619 }, { 5.135622301840683, 8.417244140399865 } }; 
+	for (double V_deep = 1.0; V_deep <= 100.0; V_deep *= 10.0) {
+		cyl_wire deep(10.0, m_w, m_w, V_deep); 
+		double max_rel = 0.0; 
+		for (int m = 0; m < 3; m++) for (int s = 0; s < 2; s++) max_rel = std::max(max_rel, 1.0 - deep.get_u_max() * sqrt(deep.energy_eigenvalue(m, s) / V_deep) / j_ms[m][s]); 
+		std::cout << "V = " << V_deep << " eV, max 1 - u / j_{m,s} over m < 3, s < 2 = " << max_rel << "\n"; 
+	}
+
+	// a thin wire still binds one m = 0 level
+	cyl_wire thin(0.5, m_w, m_b, V); 
+	std::cout << "a = 0.5 nm: " << thin.get_n_channels() << " channel, " << thin.get_n_states(0) << " level, V - E = " << V - thin.energy_eigenvalue(0, 0) << " eV, u_max = " << thin.get_u_max() << "\n\n"; 
+
+	// lowest levels over a radius scan
+	int n_radii = 4096, n_levels = 10; 
+	std::vector<double> radius(n_radii), E(static_cast<size_t>(n_radii) * n_levels); 
+	std::vector<int> chan(static_cast<size_t>(n_radii) * n_levels); 
+	for (int i = 0; i < n_radii; i++) radius[i] = 2.0 + 38.0 * i / (n_radii - 1.0); 
+
+	wire.radius_sweep(radius.data(), n_radii, n_levels, E.data(), chan.data()); // first call also extends the zero table
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+	wire.radius_sweep(radius.data(), n_radii, n_levels, E.data(), chan.data()); 
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	double max_diff = 0.0; 
+	for (int i = 0; i < n_radii; i += 97) {
+		cyl_wire single(radius[i], m_w, m_b, V); 
+		std::vector<double> all; 
+		for (int m = 0; m < single.get_n_channels(); m++) for (int n = 0; n < single.get_n_states(m); n++) all.push_back(single.energy_eigenvalue(m, n)); 
+		std::sort(all.begin(), all.end()); 
+		for (int j = 0; j < n_levels; j++) {
+			if (j < static_cast<int>(all.size())) max_diff = std::max(max_diff, fabs(E[i * n_levels + j] - all[j])); 
+			else if (E[i * n_levels + j] == E[i * n_levels + j]) max_diff = std::numeric_limits<double>::infinity(); // missing NaN
+		}
+	}
+
+	std::cout << "Radius sweep 2 - 40 nm, " << n_radii << " radii, " << n_levels << " lowest levels: " << 1.0e6 * std::chrono::duration<double>(t1 - t0).count() / n_radii << " us / radius, max |sweep - full solve| = " << max_diff << " eV\n"; 
+	std::cout << "a = 40 nm lowest levels (m):"; 
+	for (int j = 0; j < n_levels; j++) std::cout << " " << E[(n_radii - 1) * n_levels + j] << " (" << chan[(n_radii - 1) * n_levels + j] << ")"; 
+	std::cout << "\n"; 
+
+	// every channel of a wide wire, channels shared out between threads
+	t0 = std::chrono::high_resolution_clock::now(); 
+	cyl_wire wide(100.0, m_w, m_b, V); 
+	t1 = std::chrono::high_resolution_clock::now(); 
+
+	n_total = 0; 
+	for (int m = 0; m < wide.get_n_channels(); m++) n_total += wide.get_n_states(m); 
+
+	std::cout << "a = 100 nm: " << wide.get_n_channels() << " channels, " << n_total << " levels in " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms including the zero table\n"; 
+}
+
+void testing::spherical_dot()
+{
+	// bound states of a spherical dot, the l = 0 levels are compared with the closed form r (u cot(u) - 1) = -(w + 1), 
+	// a deep barrier should approach the zeros of j_l, an l = 0 level should appear once u_max passes pi / 2 for equal masses
+
+	double m_w = 0.067 * M_ELECTRON_KG, m_b = 0.092 * M_ELECTRON_KG, V = 0.3, r = m_b / m_w; 
+
+	sph_dot dot(8.0, m_w, m_b, V); 
+
+	double u_max = dot.get_u_max(); 
+
+	std::cout << "Spherical dot a = 8 nm, V = " << V << " eV, u_max = " << u_max << ", " << dot.get_n_levels() << " levels, " << dot.get_n_states() << " states\n"; 
+	for (int i = 0; i < dot.get_n_levels(); i++) {
+		const dot_level &lev = dot.get_spectrum()[i]; 
+		std::cout << "E = " << lev.E << " eV, l = " << lev.l << ", n = " << lev.n << ", degeneracy " << lev.degeneracy << "\n"; 
+	}
+
+	double max_diff = 0.0; 
+	auto F0 = [r, u_max](double x) { return ( r * (x * cos(x) - sin(x)) + (sqrt(r * (u_max * u_max - x * x)) + 1.0) * sin(x) ); }; // times sin(u)
+	for (int n = 0; n < dot.get_n_states(0); n++) {
+		int iter; 
+		double lo = n * PI + 1.0e-9, hi = std::min((n + 1) * PI, u_max); 
+		double u_ref = root_funcs::brent(F0, lo, hi, F0(lo), F0(hi), 1.0e-15 * hi, iter); 
+		max_diff = std::max(max_diff, fabs(dot.energy_eigenvalue(0, n) / (V * template_funcs::DSQR(u_ref / u_max)) - 1.0)); 
+	}
+	std::cout << "l = 0 levels, max relative difference from the closed form = " << max_diff << ", " << static_cast<double>(dot.get_root_calls()) / dot.get_n_levels() << " calls / level\n\n"; 
+
+	// deep barrier, u -> z_{l,s}
+	double z_ls[3][2] = { { PI, 2.0 * PI }, { 4.493409457909064, 7.725251836937707 }, { 5.763459196894550, 9.095011330476355 } }; 
+	for (double V_deep = 1.0; V_deep <= 100.0; V_deep *= 10.0) {
+		sph_dot deep(10.0, m_w, m_w, V_deep); 
+		double max_rel = 0.0; 
+		for (int l = 0; l < 3; l++) for (int s = 0; s < 2; s++) max_rel = std::max(max_rel, 1.0 - deep.get_u_max() * sqrt(deep.energy_eigenvalue(l, s) / V_deep) / z_ls[l][s]); 
+		std::cout << "V = " << V_deep << " eV, max 1 - u / z_{l,s} over l < 3, s < 2 = " << max_rel << "\n"; 
+	}
+
+	// threshold of the first level, u_max = pi / 2 for equal masses
+	double a_c = PI_2 * H_BAR_J / (sqrt(2.0 * m_w * template_funcs::convert_ev_J(V)) * 1.0e-9); 
+	sph_dot below(0.999 * a_c, m_w, m_w, V), above(1.001 * a_c, m_w, m_w, V); 
+	std::cout << "critical radius " << a_c << " nm: " << below.get_n_levels() << " levels at 0.999 a_c, " << above.get_n_levels() << " at 1.001 a_c with V - E = " << V - above.energy_eigenvalue(0, 0) << " eV\n\n"; 
+
+	// a large dot
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	sph_dot big(60.0, m_w, m_b, V); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+	big.set_dot_params(60.0, m_w, m_b, V); 
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << "a = 60 nm: " << big.get_n_channels() << " channels, " << big.get_n_levels() << " levels, " << big.get_n_states() << " states, " << static_cast<double>(big.get_root_calls()) / big.get_n_levels() << " calls / level\n"; 
+	std::cout << "first solve " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms including the zero table, repeat solve " << 1.0e3 * std::chrono::duration<double>(t2 - t1).count() << " ms\n"; 
+	std::cout << "lowest levels (l):"; 
+	for (int i = 0; i < 8; i++) std::cout << " " << big.get_spectrum()[i].E << " (" << big.get_spectrum()[i].l << ")"; 
+	std::cout << "\n"; 
+}
+
+namespace {
+
+	// the wells the numerical solvers are checked against, with their potential and mass profiles in the form set_profile takes
+	// a 10 nm well of mass 0.067 m_e, the same well between 0.3 eV barriers of mass 0.092 m_e, and a harmonic well with hbar omega = 0.05 eV
+	struct reference_wells {
+		int n_states; // number of levels compared
+		double length, m_w, m_b, V;
+
+		inf_well the_inf; // on [0, L]
+		fin_well the_fin; // on [-L / 2, L / 2]
+		harm_well the_harm; // centred on x = 0
+
+		std::function<double(double)> flat, fin_V, fin_m, harm_V, const_m;
+
+		reference_wells() : n_states(8), length(10.0), m_w(0.067 * M_ELECTRON_KG), m_b(0.092 * M_ELECTRON_KG), V(0.3),
+			the_inf(length, m_w, 0.5 * length), the_fin(length, m_w, m_b, V), the_harm(0.05, m_w)
+		{
+			flat = [](double) { return 0.0; };
+			fin_V = [this](double x) { return ( fabs(x) < 0.5 * length ? 0.0 : V ); };
+			fin_m = [this](double x) { return ( fabs(x) < 0.5 * length ? m_w : m_b ); };
+			harm_V = [this](double x) { return ( 0.5 * template_funcs::DSQR(x / the_harm.get_x0()) * the_harm.get_hbar_omega() ); };
+			const_m = [this](double) { return m_w; };
+		}
+
+		// the profiles refer to the members of this object
+		reference_wells(const reference_wells&) = delete;
+		reference_wells& operator=(const reference_wells&) = delete;
+	};
+}
+
+void testing::finite_difference_well()
+{
+	// finite difference solver against the analytic wells: an infinite well, a finite well with a mass step whose interfaces fall midway
+	// between grid points and a harmonic well, the errors should fall by 100 for each tenfold refinement
+	// the eigenfunctions of the finest infinite well are compared with inf_well and checked for orthonormality
+
+	reference_wells ref; 
+
+	int n_states = ref.n_states; 
+	double length = ref.length; 
+
+	const inf_well &the_inf = ref.the_inf; 
+	const fin_well &the_fin = ref.the_fin; 
+	const harm_well &the_harm = ref.the_harm; 
+
+	int n_fin = std::min(n_states, the_fin.get_n_states()); 
+
+	const std::function<double(double)> &flat = ref.flat, &fin_V = ref.fin_V, &fin_m = ref.fin_m, &harm_V = ref.harm_V, &const_m = ref.const_m; 
+
+	fd_well fd; 
+
+	std::cout << "Finite difference well, lowest " << n_states << " states, max relative error in E\n"; 
+	std::cout << "N\tinfinite\tfinite (" << n_fin << " states)\tharmonic\ttime infinite (ms)\n"; 
+
+	for (int N = 1000; N <= 1000000; N *= 10) {
+		// infinite well on [0, L]
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+		fd.set_profile(0.0, length, N, flat, const_m); 
+		fd.solve(n_states); 
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+		double err_inf = 0.0; 
+		for (int n = 0; n < n_states; n++) err_inf = std::max(err_inf, fabs(fd.energy_eigenvalue(n) / the_inf.energy_eigenvalue(n + 1) - 1.0)); 
+
+		if (N == 1000000) {
+			double err_psi = 0.0, err_orth = 0.0; 
+			for (int n = 0; n < n_states; n++) {
+				const double *a = fd.energy_eigenfunction(n); 
+				for (int i = 0; i < N; i += 97) err_psi = std::max(err_psi, fabs(a[i] - the_inf.energy_eigenfunction(n + 1, fd.position(i)))); 
+				for (int m = 0; m <= n; m++) {
+					const double *b = fd.energy_eigenfunction(m); 
+					double sum = 0.0; 
+					for (int i = 0; i < N; i++) sum += a[i] * b[i]; 
+					err_orth = std::max(err_orth, fabs(sum * fd.get_dx() - (m == n ? 1.0 : 0.0))); 
+				}
+			}
+			std::cout << "N = 10^6 infinite well eigenfunctions: max |psi - psi_exact| = " << err_psi << " nm^-1/2, max orthonormality error = " << err_orth << "\n"; 
+		}
+
+		// finite well, barriers of width 4 L either side so that the top level does not feel the walls, interfaces midway between grid points
+		int M = N / 9; 
+		double h = length / M, x_left = -0.5 * length - (4 * M + 0.5) * h; 
+
+		fd.set_profile(x_left, x_left + (9 * M + 1) * h, 9 * M, fin_V, fin_m); 
+		fd.solve(n_fin); 
+
+		double err_fin = 0.0; 
+		for (int n = 0; n < n_fin; n++) err_fin = std::max(err_fin, fabs(fd.energy_eigenvalue(n) / the_fin.energy_eigenvalue(n) - 1.0)); 
+
+		// harmonic well on +/- 12 x_0
+		double x_max = 12.0 * the_harm.get_x0(); 
+
+		fd.set_profile(-x_max, x_max, N, harm_V, const_m); 
+		fd.solve(n_states); 
+
+		double err_harm = 0.0; 
+		for (int n = 0; n < n_states; n++) err_harm = std::max(err_harm, fabs(fd.energy_eigenvalue(n) / the_harm.energy_eigenvalue(n) - 1.0)); 
+
+		std::cout << N << "\t" << err_inf << "\t" << err_fin << "\t" << err_harm << "\t" << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << "\n"; 
+	}
+	std::cout << "\n"; 
+}
+
+void testing::numerov_shooting()
+{
+	// Numerov shooting against the fin_well eigenequations for equal masses, barriers 6 L wide, the steps of V lie on grid points where V takes the mean value,
+	// against the harmonic well, where V is smooth and the error should fall as h^{4}, and a single high level found without those below it
+
+	double length = 10.0, m_w = 0.067 * M_ELECTRON_KG, V = 0.3, x_max = 6.5 * length; 
+
+	fin_well the_fin(length, m_w, m_w, V); 
+	harm_well the_harm(0.05, m_w); 
+
+	int n_fin = the_fin.get_n_states(); 
+
+	auto fin_V = [length, V](double x) { return ( fabs(fabs(x) - 0.5 * length) < 1.0e-9 ? 0.5 * V : (fabs(x) < 0.5 * length ? 0.0 : V) ); }; 
+	auto harm_V = [&the_harm](double x) { return ( 0.5 * template_funcs::DSQR(x / the_harm.get_x0()) * the_harm.get_hbar_omega() ); }; 
+
+	numerov_well nw; 
+	std::vector<double> E(n_fin); 
+
+	std::cout << "Numerov shooting, finite well L = 10 nm, V = 0.3 eV, " << n_fin << " levels, max relative error against fin_well\n"; 
+	for (int N = 1300; N <= 1300000; N *= 10) {
+		nw.set_profile(-x_max, x_max, N, fin_V, m_w); 
+
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+		nw.energy_eigenvalues(0, n_fin, E.data()); 
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+		double err = 0.0; 
+		for (int n = 0; n < n_fin; n++) err = std::max(err, fabs(E[n] / the_fin.energy_eigenvalue(n) - 1.0)); 
+
+		std::cout << "N = " << N << ", error = " << err << ", " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms\n"; 
+	}
+
+	// ground state wavefunction on the finest grid
+	std::vector<double> psi; 
+	nw.energy_eigenfunction(0, psi); 
+
+	double err_psi = 0.0; 
+	for (int i = 0; i <= nw.get_n_intervals(); i += 101) err_psi = std::max(err_psi, fabs(psi[i] - the_fin.energy_eigenfunction(0, nw.position(i)))); 
+	std::cout << "ground state, max |psi - psi_fin_well| = " << err_psi << " nm^-1/2\n\n"; 
+
+	// harmonic well, fourth order
+	x_max = 12.0 * the_harm.get_x0(); 
+	int n_harm = 8; 
+	E.resize(n_harm); 
+
+	std::cout << "harmonic well, hbar omega = 0.05 eV, lowest " << n_harm << " levels, max relative error\n"; 
+	for (int N = 500; N <= 8000; N *= 2) {
+		nw.set_profile(-x_max, x_max, N, harm_V, m_w); 
+		nw.energy_eigenvalues(0, n_harm, E.data()); 
+
+		double err = 0.0; 
+		for (int n = 0; n < n_harm; n++) err = std::max(err, fabs(E[n] / the_harm.energy_eigenvalue(n) - 1.0)); 
+
+		std::cout << "N = " << N << ", error = " << err << "\n"; 
+	}
+
+	// one high level alone
+	int n_high = 200; 
+	x_max = 1.5 * sqrt(2.0 * n_high + 1.0) * the_harm.get_x0(); 
+	nw.set_profile(-x_max, x_max, 100000, harm_V, m_w); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	double E_high = nw.energy_eigenvalue(n_high); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << "level " << n_high << " alone: E = " << E_high << " eV, relative error " << fabs(E_high / the_harm.energy_eigenvalue(n_high) - 1.0) << ", " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms\n\n"; 
+}
+
+void testing::chebyshev_collocation()
+{
+	// Chebyshev collocation against inf_well, error against the number of unknowns P, alongside the number of finite difference points that
+	// gives the same error, N + 1 = n pi / sqrt(12 err) from the fd error (n pi / (N + 1))^{2} / 12 of level n, and one fd_well solve for timing
+	// then a finite well with a mass step, one domain per material and two for each barrier, against fin_well, and the harmonic well on one domain
+
+	reference_wells ref; 
+
+	int n_states = ref.n_states; 
+	double length = ref.length, m_w = ref.m_w, m_b = ref.m_b; 
+
+	const inf_well &the_inf = ref.the_inf; 
+	const fin_well &the_fin = ref.the_fin; 
+	const harm_well &the_harm = ref.the_harm; 
+
+	const std::function<double(double)> &flat = ref.flat, &fin_V = ref.fin_V, &harm_V = ref.harm_V, &const_m = ref.const_m; 
+
+	cheb_well cw; 
+
+	int n_inf = 20; 
+
+	std::cout << "Chebyshev collocation, infinite well L = 10 nm, lowest " << n_inf << " states\n"; 
+	std::cout << "P\tmax relative error\tfd points for the same error\ttime (ms)\n"; 
+	for (int n = 30; n <= 70; n += 5) {
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+		cw.set_profile({ 0.0, length }, { n }, { m_w }, flat); 
+		cw.solve(n_inf); 
+
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+		double err = 0.0; 
+		for (int k = 0; k < n_inf; k++) err = std::max(err, fabs(cw.energy_eigenvalue(k) / the_inf.energy_eigenvalue(k + 1) - 1.0)); 
+
+		double N_fd = n_inf * PI / sqrt(12.0 * std::max(err, 1.0e-16)) - 1.0; 
+
+		std::cout << cw.get_n_unknowns() << "\t" << err << "\t" << N_fd << "\t" << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << "\n"; 
+	}
+
+	double err_psi = 0.0; 
+	for (int k = 0; k < n_inf; k++) {
+		for (int i = 1; i < 100; i++) {
+			double x = 0.01 * i * length; 
+			err_psi = std::max(err_psi, fabs(cw.energy_eigenfunction(k, x) - the_inf.energy_eigenfunction(k + 1, x))); 
+		}
+	}
+	std::cout << "max |psi - psi_inf_well| = " << err_psi << " nm^-1/2\n"; 
+
+	fd_well fd; 
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	fd.set_profile(0.0, length, 100000, flat, const_m); 
+	fd.solve(n_inf); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	double err_fd = 0.0; 
+	for (int k = 0; k < n_inf; k++) err_fd = std::max(err_fd, fabs(fd.energy_eigenvalue(k) / the_inf.energy_eigenvalue(k + 1) - 1.0)); 
+	std::cout << "fd_well N = " << fd.get_n_points() << ", error = " << err_fd << ", " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms\n\n"; 
+
+	// finite well with a mass step, the barrier domains are split where psi has decayed by about e^{-8} so each holds a single length scale
+	int n_fin = std::min(n_states, the_fin.get_n_states()); 
+	double x_mid = 1.5 * length, x_max = 6.5 * length; 
+
+	std::cout << "finite well L = 10 nm, V = 0.3 eV, mass step, " << n_fin << " levels, 5 domains\n"; 
+	std::cout << "P\tmax relative error\n"; 
+	for (int n = 30; n <= 60; n += 10) {
+		cw.set_profile({ -x_max, -x_mid, -0.5 * length, 0.5 * length, x_mid, x_max }, { n, n, n, n, n }, { m_b, m_b, m_w, m_b, m_b }, fin_V); 
+		cw.solve(n_fin); 
+
+		double err = 0.0; 
+		for (int k = 0; k < n_fin; k++) err = std::max(err, fabs(cw.energy_eigenvalue(k) / the_fin.energy_eigenvalue(k) - 1.0)); 
+
+		std::cout << cw.get_n_unknowns() << "\t" << err << "\n"; 
+	}
+
+	err_psi = 0.0; 
+	for (int i = -100; i <= 100; i++) {
+		double x = 0.02 * i * length; 
+		err_psi = std::max(err_psi, fabs(cw.energy_eigenfunction(0, x) - the_fin.energy_eigenfunction(0, x))); 
+	}
+	std::cout << "ground state, max |psi - psi_fin_well| = " << err_psi << " nm^-1/2\n\n"; 
+
+	// harmonic well on one domain
+	x_max = 12.0 * the_harm.get_x0(); 
+
+	std::cout << "harmonic well, hbar omega = 0.05 eV, lowest " << n_states << " levels\n"; 
+	std::cout << "P\tmax relative error\tV tail\n"; 
+	for (int n = 40; n <= 100; n += 20) {
+		cw.set_profile({ -x_max, x_max }, { n }, { m_w }, harm_V); 
+		cw.solve(n_states); 
+
+		double err = 0.0; 
+		for (int k = 0; k < n_states; k++) err = std::max(err, fabs(cw.energy_eigenvalue(k) / the_harm.energy_eigenvalue(k) - 1.0)); 
+
+		std::cout << cw.get_n_unknowns() << "\t" << err << "\t" << cw.get_potential_tail(0) << "\n"; 
+	}
+	std::cout << "\n"; 
+}
+
+void testing::triangular_well()
+{
+	// triangular well against Chebyshev collocation of the same linear potential, hard wall and finite barrier with a mass step,
+	// the zeros a_s and a'_s against reference values, and the cost of thousands of hard wall levels, first from an empty table then from a full one
+
+	int n_states = 8; 
+	double field = 0.01, m_w = 0.067 * M_ELECTRON_KG, m_b = 0.092 * M_ELECTRON_KG, V = 0.3; // 0.01 eV / nm is 100 kV / cm
+
+	// DLMF table 9.9.1
+	std::cout << "Airy zeros, error against DLMF\n"; 
+	std::cout << "a_1: " << special::airy_zero(1) + 2.338107410459767 << ", a_2: " << special::airy_zero(2) + 4.087949444130970 << ", a_10: " << special::airy_zero(10) + 12.828776752865757 << "\n"; 
+	std::cout << "a'_1: " << special::airy_derivative_zero(1) + 1.018792971647471 << ", a'_2: " << special::airy_derivative_zero(2) + 3.248197582179837 << "\n\n"; 
+
+	tri_well the_tri(field, m_w); 
+
+	auto lin_V = [field](double x) { return ( x < 0.0 ? 0.3 : field * x ); }; 
+
+	// cheb_well converts eV with convert_ev_J as tri_well does, so no units factor is needed
+	double x_max = 30.0 * the_tri.get_x0(); 
+	cheb_well cw({ 0.0, 0.5 * x_max, x_max }, { 60, 60 }, { m_w, m_w }, lin_V); 
+	cw.solve(n_states); 
+
+	double err = 0.0, err_psi = 0.0; 
+	for (int n = 0; n < n_states; n++) {
+		err = std::max(err, fabs(cw.energy_eigenvalue(n) / the_tri.energy_eigenvalue(n) - 1.0)); 
+		for (int i = 1; i < 100; i++) {
+			double x = 0.005 * i * x_max; 
+			err_psi = std::max(err_psi, fabs(cw.energy_eigenfunction(n, x) - the_tri.energy_eigenfunction(n, x))); 
+		}
+	}
+	std::cout << "hard wall, F = " << field << " eV/nm, x0 = " << the_tri.get_x0() << " nm, E0 = " << the_tri.get_E0() << " eV\n"; 
+	std::cout << "lowest " << n_states << " levels, max relative difference from cheb_well = " << err << ", max |psi - psi_cheb| = " << err_psi << " nm^-1/2\n"; 
+
+	// finite barrier
+	tri_well the_fin(field, m_w, m_b, V); 
+	int n_fin = std::min(n_states, the_fin.get_n_states()); 
+
+	// the top level decays over ~10 nm in the barrier, so the barrier is 80 nm wide and split where the lower levels have died out
+	double x_min = -80.0; 
+	cw.set_profile({ x_min, x_min / 3.0, 0.0, 0.5 * x_max, x_max }, { 40, 40, 60, 60 }, { m_b, m_b, m_w, m_w }, lin_V); 
+	cw.solve(n_fin); 
+
+	err = err_psi = 0.0; 
+	for (int n = 0; n < n_fin; n++) {
+		err = std::max(err, fabs(cw.energy_eigenvalue(n) / the_fin.energy_eigenvalue(n) - 1.0)); 
+		for (int i = 1; i < 100; i++) {
+			double x = -20.0 + 0.01 * i * (0.5 * x_max + 20.0); 
+			err_psi = std::max(err_psi, fabs(cw.energy_eigenfunction(n, x) - the_fin.energy_eigenfunction(n, x))); 
+		}
+	}
+	std::cout << "finite barrier V = " << V << " eV, mass step, " << the_fin.get_n_states() << " bound levels, ground state " << the_fin.energy_eigenvalue(0) << " eV against " << the_tri.energy_eigenvalue(0) << " eV for the hard wall\n"; 
+	std::cout << "lowest " << n_fin << " levels, max relative difference from cheb_well = " << err << ", max |psi - psi_cheb| = " << err_psi << " nm^-1/2\n\n"; 
+
+	// many levels, the first call fills the table
+	int n_many = 10000; 
+	std::vector<double> E(n_many); 
+
+	tri_well weak(1.0e-4, m_w); 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	weak.energy_eigenvalues(0, n_many, E.data()); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+	weak.energy_eigenvalues(0, n_many, E.data()); 
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now(); 
+
+	std::cout << n_many << " hard wall levels: " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms extending the table, " << 1.0e3 * std::chrono::duration<double>(t2 - t1).count() << " ms from the table\n"; 
+	std::cout << "E_" << n_many - 1 << " = " << E[n_many - 1] << " eV\n\n"; 
+}
+
+void testing::biased_barrier()
+{
+	// biased barrier: at F = 0 against barr_structure, then an oxide barrier under field against the multi_layer staircase,
+	// whose error falls as 1 / N^{2} in the number of slices while its cost grows as N, then the slope of ln T against 1 / F
+	// in the Fowler-Nordheim regime against the WKB value -(4/3) sqrt(2 m_b) (V_b - E)^{3/2} / hbar - 2 F, and the cost of a T(E, F) map
+
+	double m_e = M_ELECTRON_KG, m_ox = 0.5 * M_ELECTRON_KG, V = 3.1, W = 3.0; 
+
+	// flat barrier
+	biased_barr flat(m_e, m_e, m_e, 0.3, 1.0); 
+	barr_structure rect(m_e, 0.3, 1.0); 
+
+	double err = 0.0; 
+	for (int i = 1; i <= 10; i++) {
+		double E = 0.06 * i, T, R, T_ref, R_ref; 
+		flat.probabilities(E, 0.0, T, R); 
+		rect.probabilities(E, T_ref, R_ref); 
+		err = std::max(err, fabs(T - T_ref) + fabs(R - R_ref)); 
+	}
+	std::cout << "Biased barrier, F = 0 against barr_structure, V = 0.3 eV, W = 1 nm, max |dT| + |dR| = " << err << "\n\n"; 
+
+	// oxide under field
+	biased_barr oxide(m_e, m_ox, m_e, V, W); 
+
+	double E = 0.5; 
+	double fields[2] = { 0.5, 1.0 }; 
+
+	std::cout << "oxide barrier V = " << V << " eV, W = " << W << " nm, m_b = 0.5 m_e, E = " << E << " eV\n"; 
+
+	for (int f = 0; f < 2; f++) {
+		double F = fields[f]; 
+
+		std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+		double T_airy = 0.0; 
+		for (int it = 0; it < 1000; it++) T_airy += oxide.transmission(E + 1.0e-6 * it, F); 
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+		T_airy = oxide.transmission(E, F); 
+
+		double R, T_check; 
+		oxide.probabilities(E, F, T_check, R); 
+
+		std::cout << "F = " << F << " eV/nm, T = " << T_airy << ", |T + R - 1| = " << fabs(T_check + R - 1.0) << ", Airy " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " us per energy\n"; 
+		std::cout << "slices\trelative error\tus per energy\n"; 
+
+		for (int N = 10; N <= 10000; N *= 10) {
+			multi_layer stairs(m_e, 0.0, m_e, -F * W, oxide.staircase(F, N)); 
+
+			int n_rep = std::max(1, 10000 / N); 
+			double T_s, R_s; 
+
+			t0 = std::chrono::high_resolution_clock::now(); 
+			for (int it = 0; it < n_rep; it++) stairs.probabilities(E + 1.0e-6 * it, T_s, R_s); 
+			t1 = std::chrono::high_resolution_clock::now(); 
+
+			stairs.probabilities(E, T_s, R_s); 
+
+			std::cout << N << "\t" << fabs(T_s / T_airy - 1.0) << "\t" << 1.0e6 * std::chrono::duration<double>(t1 - t0).count() / n_rep << "\n"; 
+		}
+	}
+
+	// Fowler-Nordheim slope, V_b - F W < E for F > 0.87 eV/nm
+	double F1 = 1.5, F2 = 1.6; 
+	double slope = (log(oxide.transmission(E, F2)) - log(oxide.transmission(E, F1))) / (1.0 / F2 - 1.0 / F1); 
+	double slope_FN = -(4.0 / 3.0) * sqrt(2.0 * m_ox * template_funcs::convert_ev_J(1.0)) * 1.0e-9 / H_BAR_J * pow(V - E, 1.5); 
+	// the F^{2} prefactor of the Fowler-Nordheim current adds d ln F^{2} / d (1 / F) = -2 F to the slope
+	std::cout << "\nFowler-Nordheim regime, d ln T / d (1 / F) = " << slope << " eV/nm against the WKB value " << slope_FN - (F1 + F2) << " eV/nm, " << slope_FN << " eV/nm from the exponent alone\n"; 
+
+	// map
+	int n_E = 200, n_F = 100; 
+	std::vector<double> energies(n_E), fields_map(n_F), T_map(static_cast<size_t>(n_E) * n_F); 
+	for (int i = 0; i < n_E; i++) energies[i] = 0.01 + 0.02 * i; 
+	for (int i = 0; i < n_F; i++) fields_map[i] = 0.02 * i; 
+
+	std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+	oxide.transmission_map(energies.data(), n_E, fields_map.data(), n_F, T_map.data()); 
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+	double err_TR = 0.0; 
+	for (int f = 0; f < n_F; f += 9) {
+		for (int e = 0; e < n_E; e += 7) {
+			double T, R; 
+			oxide.probabilities(energies[e], fields_map[f], T, R); 
+			err_TR = std::max(err_TR, fabs(T + R - 1.0) + fabs(T - T_map[static_cast<size_t>(f) * n_E + e])); 
+		}
+	}
+	std::cout << n_E << " x " << n_F << " T(E, F) map in " << 1.0e3 * std::chrono::duration<double>(t1 - t0).count() << " ms, max |T + R - 1| = " << err_TR << "\n\n"; 
+}
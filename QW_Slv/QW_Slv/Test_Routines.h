@@ -14,8 +14,58 @@ namespace testing{
 
 	void potential_barrier(); 
 
+	void energy_sweep(); 
+
+	void wavefunction_batch(); 
+
+	void wavefunction_grid(); 
+
+	void multi_layer_stack(); 
+
+	void shared_solution(); 
+
+	void status_path(); 
+
+	void structure_split(); 
+
+	void adaptive_sampling(); 
+
+	void density_map(); 
+
+	void problem_batch(); 
+
 	void infinite_well(); 
 
+	void infinite_well_table(); 
+
+	void well_evolution(); 
+
+	void harmonic_well(); 
+
+	void separable_box(); 
+
+	void finite_well(); 
+
+	void finite_well_continuation(); 
+
+	void finite_well_nonparabolic(); 
+
+	void finite_well_eigenfunctions(); 
+
+	void cylindrical_wire(); 
+
+	void spherical_dot(); 
+
+	void finite_difference_well(); 
+
+	void numerov_shooting(); 
+
+	void chebyshev_collocation(); 
+
+	void triangular_well(); 
+
+	void biased_barrier(); 
+
 }
 
 #endif
\ No newline at end of file
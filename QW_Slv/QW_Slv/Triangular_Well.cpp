@@ -0,0 +1,249 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the methods declared in Triangular_Well.h
+
+tri_well::tri_well()
+{
+	// Default constructor
+	hard = true;
+	F = M_w = M_b = V_b = x_w = x0 = E0 = kappa_const = 0.0;
+}
+
+tri_well::tri_well(double field, double mass, double wall_position)
+{
+	// Constructor, hard wall
+
+	set_well_params(field, mass, wall_position);
+}
+
+tri_well::tri_well(double field, double mass_well, double mass_barrier, double barrier_height, double wall_position)
+{
+	// Constructor, finite barrier
+
+	set_barrier_params(field, mass_well, mass_barrier, barrier_height, wall_position);
+}
+
+void tri_well::set_scales(double field, double mass_well, double wall_position)
+{
+	// x_0 = (hbar^{2} / 2 m F)^{1/3} with F converted to J / m, then to nm, E_0 = F x_0
+
+	F = field;
+	M_w = mass_well;
+	x_w = wall_position;
+	x0 = 1.0e9 * cbrt(H_BAR_J * H_BAR_J / (2.0 * M_w * template_funcs::convert_ev_J(F) * 1.0e9));
+	E0 = F * x0;
+}
+
+void tri_well::set_well_params(double field, double mass, double wall_position)
+{
+	try{
+
+		bool c1 = field > 0.0 ? true : false;
+		bool c2 = mass > 0.0 ? true : false;
+
+		if(c1 && c2){
+			set_scales(field, mass, wall_position);
+
+			hard = true;
+			M_b = V_b = kappa_const = 0.0;
+		}
+		else{
+			std::string reason = "Error: void tri_well::set_well_params(double field, double mass, double wall_position)\n";
+			if(!c1) reason += "field is not positive\n";
+			if(!c2) reason += "mass is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+void tri_well::set_barrier_params(double field, double mass_well, double mass_barrier, double barrier_height, double wall_position)
+{
+	try{
+
+		bool c1 = field > 0.0 ? true : false;
+		bool c2 = mass_well > 0.0 && mass_barrier > 0.0 ? true : false;
+		bool c3 = barrier_height > 0.0 ? true : false;
+
+		if(c1 && c2 && c3){
+			set_scales(field, mass_well, wall_position);
+
+			hard = false;
+			M_b = mass_barrier;
+			V_b = barrier_height;
+			kappa_const = 1.0e-9 * sqrt(2.0 * M_b * template_funcs::convert_ev_J(1.0)) / H_BAR_J;
+		}
+		else{
+			std::string reason = "Error: void tri_well::set_barrier_params(double field, double mass_well, double mass_barrier, double barrier_height, double wall_position)\n";
+			if(!c1) reason += "field is not positive\n";
+			if(!c2) reason += "masses are not positive\n";
+			if(!c3) reason += "barrier_height is not positive\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what());
+		exit(EXIT_FAILURE);
+	}
+}
+
+double tri_well::matching_function(double eps) const
+{
+	// psi' / m continuous at the wall, (1 / m_w) Ai'(-eps) / x_0 = (kappa / m_b) Ai(-eps), multiplied through by m_b
+
+	double ai, bi, aip, bip;
+
+	special::airy(-eps, &ai, &bi, &aip, &bip);
+
+	double kappa = kappa_const * sqrt(std::max(V_b - eps * E0, 0.0));
+
+	return ( (M_b / M_w) * aip - x0 * kappa * ai );
+}
+
+double tri_well::barrier_level(int n) const
+{
+	// Ai' has the sign of Ai'(a_{n+1}) on (a_{n+1}, a'_{n+1}), so the matching function changes sign between eps = -a'_{n+1}, where only the
+	// kappa term is left, and the lesser of -a_{n+1} and V_b / E_0, where either Ai or kappa vanishes
+
+	double eps_lo = -special::airy_derivative_zero(n + 1), eps_hi = std::min(-special::airy_zero(n + 1), V_b / E0);
+
+	if (!(eps_lo < eps_hi)) {
+		std::string reason = "Error: double tri_well::barrier_level(int n) const\n";
+		reason += "Level " + template_funcs::toString(n) + " is not bound by the barrier\n";
+		throw std::invalid_argument(reason);
+	}
+
+	int iter;
+
+	auto func = [this](double eps) { return matching_function(eps); };
+
+	return root_funcs::brent(func, eps_lo, eps_hi, func(eps_lo), func(eps_hi), 1.0e-15 * eps_hi, iter);
+}
+
+double tri_well::energy_eigenvalue(int n) const
+{
+	// return the n^{th} energy eigenvalue in units of eV
+
+	try{
+
+		if(n > -1 && E0 > 0.0){
+			return ( hard ? -special::airy_zero(n + 1) * E0 : barrier_level(n) * E0 );
+		}
+		else{
+			std::string reason = "Error: double tri_well::energy_eigenvalue(int n) const\n";
+			if(n < 0) reason += "Value of n must not be negative\n";
+			else reason += "Well parameters have not been set\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+void tri_well::energy_eigenvalues(int n_first, int n_count, double *energies) const
+{
+	// the zero tables are extended once to cover the range before any level is taken from them
+
+	try{
+
+		if(n_first > -1 && n_count > 0 && energies != nullptr){
+			special::airy_zero(n_first + n_count);
+
+			auto solve_level = [this, n_first, energies](int j) { energies[j] = energy_eigenvalue(n_first + j); };
+
+			if (!hard && n_count >= PARALLEL_MIN_LEVELS) {
+				parallel_funcs::parallel_for(n_count, solve_level);
+			}
+			else {
+				for (int j = 0; j < n_count; j++) solve_level(j);
+			}
+		}
+		else{
+			std::string reason = "Error: void tri_well::energy_eigenvalues(int n_first, int n_count, double *energies) const\n";
+			if(n_first < 0) reason += "Value of n_first must not be negative\n";
+			if(n_count < 1 || energies == nullptr) reason += "No levels requested\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
+}
+
+double tri_well::energy_eigenfunction(int n, double position) const
+{
+	// Hard wall: psi = Ai(y + a_s) / (sqrt(x_0) |Ai'(a_s)|), y = (x - x_w) / x_0, s = n + 1, from the integral of Ai^{2}(y + a_s) over y > 0, Ai'(a_s)^{2}
+	// Finite barrier: the well side integral is x_0 (Ai'(-eps)^{2} + eps Ai(-eps)^{2}), the barrier side Ai(-eps)^{2} / 2 kappa
+	// the sign is chosen so that psi is positive next to the wall
+
+	try{
+
+		if(n > -1 && E0 > 0.0){
+			double y = (position - x_w) / x0, ai, bi, aip, bip;
+
+			if (hard) {
+				if (y <= 0.0) return 0.0;
+
+				double a = special::airy_zero(n + 1);
+
+				special::airy(a, &ai, &bi, &aip, &bip);
+
+				double A = 1.0 / (sqrt(x0) * aip);
+
+				special::airy(y + a, &ai, &bi, &aip, &bip);
+
+				return ( A * ai );
+			}
+			else {
+				double eps = barrier_level(n), kappa = kappa_const * sqrt(V_b - eps * E0);
+
+				special::airy(-eps, &ai, &bi, &aip, &bip);
+
+				double ai_w = ai, norm = x0 * (aip * aip + eps * ai * ai) + ai * ai / (2.0 * kappa);
+
+				double A = ( ai_w < 0.0 ? -1.0 : 1.0 ) / sqrt(norm);
+
+				if (y < 0.0) return ( A * ai_w * exp(kappa * (position - x_w)) );
+
+				special::airy(y - eps, &ai, &bi, &aip, &bip);
+
+				return ( A * ai );
+			}
+		}
+		else{
+			std::string reason = "Error: double tri_well::energy_eigenfunction(int n, double position) const\n";
+			if(n < 0) reason += "Value of n must not be negative\n";
+			else reason += "Well parameters have not been set\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+		return 0.0;
+	}
+}
+
+int tri_well::get_n_states() const
+{
+	// level n is bound while -a'_{n+1} E_0 < V_b
+
+	if (hard) return -1;
+
+	int n = 0;
+
+	while (-special::airy_derivative_zero(n + 1) * E0 < V_b) n++;
+
+	return n;
+}
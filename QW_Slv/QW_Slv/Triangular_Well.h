@@ -0,0 +1,72 @@
+#ifndef TRIANGULAR_WELL_H
+#define TRIANGULAR_WELL_H
+
+// Implementation of a class that computes the bound states of a triangular well, the linear potential of an inversion layer or of a
+// well under an applied field, V(x) = F (x - x_w) for x > x_w, bounded on the left at x_w by
+//   a hard wall, psi(x_w) = 0, or
+//   a finite barrier V = V_b for x < x_w with its own mass, psi and psi' / m continuous at x_w
+// With x_0 = (hbar^{2} / 2 m F)^{1/3} and E_0 = F x_0 the well side solution is Ai((x - x_w) / x_0 - E / E_0), the one that decays as x grows
+// Hard wall: E_n = -a_{n+1} E_0, a_s the zeros of Ai, so a level costs one lookup in the table of special::airy_zero
+// Finite barrier: psi = Ai(-E / E_0) exp(kappa (x - x_w)) in the barrier and the levels solve m_b Ai'(-eps) = x_0 kappa m_w Ai(-eps), eps = E / E_0,
+// level n lies between -a'_{n+1} E_0, the kappa -> 0 limit, and -a_{n+1} E_0, the hard wall limit, both taken from the tables,
+// and the single root in that bracket is found by Brent's method, levels exist while -a'_{n+1} E_0 < V_b
+
+// The natural scale for energy is eV, scale energies accordingly
+// The natural scale for length is nm, you can scale lengths accordingly
+// field is the slope of the potential energy in eV / nm, 1 eV / nm is a field of 10^{7} V / cm acting on an electron
+
+// All of the set up is done by set_well_params or set_barrier_params and every evaluation method is const,
+// the zero tables they read are shared and extended under a lock, so a tri_well can be shared read-only between threads
+
+class tri_well{
+
+public:
+	tri_well();
+
+	tri_well(double field, double mass, double wall_position = 0.0);
+
+	tri_well(double field, double mass_well, double mass_barrier, double barrier_height, double wall_position = 0.0);
+
+	void set_well_params(double field, double mass, double wall_position = 0.0); // hard wall at wall_position
+
+	void set_barrier_params(double field, double mass_well, double mass_barrier, double barrier_height, double wall_position = 0.0); // finite barrier
+
+	double energy_eigenvalue(int n) const; // return the energy associated with the n^{th} energy level, n counted from 0
+
+	// levels n_first..n_first+n_count-1 written to energies[0..n_count-1], for a finite barrier one level per thread
+	void energy_eigenvalues(int n_first, int n_count, double *energies) const;
+
+	double energy_eigenfunction(int n, double position) const; // value of the normalised n^{th} wavefunction at position
+
+	int get_n_states() const; // number of levels below the barrier, -1 for a hard wall, which binds every level
+
+	// getters
+	inline bool hard_wall() const { return hard; }
+	inline double get_field() const { return F; }
+	inline double get_x0() const { return x0; }
+	inline double get_E0() const { return E0; }
+	inline double get_wall() const { return x_w; }
+	inline double get_barrier_height() const { return V_b; }
+
+	static const int PARALLEL_MIN_LEVELS = 16; // finite barrier ranges with fewer levels than this are solved on the calling thread
+
+private:
+	void set_scales(double field, double mass_well, double wall_position); // x_0 and E_0 from the field and the well mass
+
+	double matching_function(double eps) const; // (m_b / m_w) Ai'(-eps) - x_0 kappa Ai(-eps), zero at a finite barrier level
+
+	double barrier_level(int n) const; // eps of level n for a finite barrier
+
+private:
+	bool hard; // hard wall if true, finite barrier otherwise
+	double F; // slope of the potential energy in the well expressed in eV / nm
+	double M_w; // mass in the well expressed in kg
+	double M_b; // mass in the barrier expressed in kg
+	double V_b; // barrier height expressed in eV
+	double x_w; // position of the wall expressed in nm
+	double x0; // length scale (hbar^{2} / 2 m F)^{1/3} expressed in nm
+	double E0; // energy scale F x_0 expressed in eV
+	double kappa_const; // kappa = kappa_const sqrt(V_b - E) in units of 1 / nm
+};
+
+#endif
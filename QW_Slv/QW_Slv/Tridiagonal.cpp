@@ -0,0 +1,489 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definition of the functions declared in Tridiagonal.h
+
+namespace {
+
+	const double MACHINE_EPS = std::numeric_limits<double>::epsilon();
+
+	const double GEOMETRIC_RATIO = 4.0; // intervals whose ends, measured from the Gershgorin bound, differ by more than this are split at the geometric mean
+
+	const int INVERSE_ITERATIONS = 3; // pivoted solves per eigenvector when the twisted solve is not independent of the rest of its cluster
+
+	double split_point(double lo, double hi, double base)
+	{
+		// point at which to split [lo, hi], lo - base and hi - base are the distances from the Gershgorin bound
+
+		double a = lo - base, b = hi - base;
+
+		if (a > 0.0 && b > GEOMETRIC_RATIO * a) return ( base + sqrt(a * b) );
+
+		return ( lo + 0.5 * (hi - lo) );
+	}
+
+	bool interval_converged(double lo, double hi, double mid, double abs_tol)
+	{
+		// the interval is a few ulps wide, or so narrow that its mid point is not inside it
+
+		return ( hi - lo <= 2.0 * MACHINE_EPS * std::max(fabs(lo), fabs(hi)) + abs_tol || !(mid > lo && mid < hi) );
+	}
+
+	void sturm_block(const double *a, const double *w, int n, const double *x, int *count, double pivmin)
+	{
+		// Sturm counts at SHIFT_BLOCK shifts, the recurrences are independent so their divisions overlap
+
+		const int S = tridiag_funcs::SHIFT_BLOCK;
+
+		double c[S];
+
+#ifdef __AVX2__
+		const int V = S / 4;
+
+		__m256d sign = _mm256_set1_pd(-0.0), piv = _mm256_set1_pd(pivmin), neg_piv = _mm256_set1_pd(-pivmin), unit = _mm256_set1_pd(1.0), zero_v = _mm256_setzero_pd();
+		__m256d xv[V], r[V], q[V], cv[V];
+
+		__m256d a0 = _mm256_set1_pd(a[0] + w[0]), w1 = _mm256_set1_pd(w[1]), floor_r = _mm256_set1_pd(-pivmin - w[1]);
+
+		for (int v = 0; v < V; v++) {
+			xv[v] = _mm256_loadu_pd(x + 4 * v);
+			r[v] = _mm256_sub_pd(a0, xv[v]);
+			q[v] = _mm256_add_pd(r[v], w1);
+
+			__m256d small = _mm256_cmp_pd(_mm256_andnot_pd(sign, q[v]), piv, _CMP_LT_OQ);
+			q[v] = _mm256_blendv_pd(q[v], neg_piv, small);
+			r[v] = _mm256_blendv_pd(r[v], floor_r, small);
+
+			cv[v] = _mm256_and_pd(_mm256_cmp_pd(q[v], zero_v, _CMP_LT_OQ), unit);
+		}
+
+		for (int i = 1; i < n; i++) {
+			__m256d ai = _mm256_set1_pd(a[i]), wi = _mm256_set1_pd(w[i]), wn = _mm256_set1_pd(w[i + 1]), floor_i = _mm256_set1_pd(-pivmin - w[i + 1]);
+
+			for (int v = 0; v < V; v++) {
+				r[v] = _mm256_add_pd(_mm256_sub_pd(ai, xv[v]), _mm256_div_pd(_mm256_mul_pd(wi, r[v]), q[v]));
+				q[v] = _mm256_add_pd(r[v], wn);
+
+				__m256d small = _mm256_cmp_pd(_mm256_andnot_pd(sign, q[v]), piv, _CMP_LT_OQ);
+				q[v] = _mm256_blendv_pd(q[v], neg_piv, small);
+				r[v] = _mm256_blendv_pd(r[v], floor_i, small);
+
+				cv[v] = _mm256_add_pd(cv[v], _mm256_and_pd(_mm256_cmp_pd(q[v], zero_v, _CMP_LT_OQ), unit));
+			}
+		}
+
+		for (int v = 0; v < V; v++) _mm256_storeu_pd(c + 4 * v, cv[v]);
+#else
+		double r[S], q[S];
+
+		for (int s = 0; s < S; s++) {
+			r[s] = a[0] + w[0] - x[s];
+			q[s] = r[s] + w[1];
+			if (fabs(q[s]) < pivmin) {
+				q[s] = -pivmin;
+				r[s] = -pivmin - w[1];
+			}
+			c[s] = q[s] < 0.0 ? 1.0 : 0.0;
+		}
+
+		for (int i = 1; i < n; i++) {
+			double ai = a[i], wi = w[i], wn = w[i + 1];
+
+			for (int s = 0; s < S; s++) {
+				r[s] = ai - x[s] + wi * r[s] / q[s];
+				q[s] = r[s] + wn;
+				if (fabs(q[s]) < pivmin) {
+					q[s] = -pivmin;
+					r[s] = -pivmin - wn;
+				}
+				c[s] += q[s] < 0.0 ? 1.0 : 0.0;
+			}
+		}
+#endif
+
+		for (int s = 0; s < S; s++) count[s] = static_cast<int>(c[s]);
+	}
+
+	void twisted_vector(const double *a, const double *w, int n, double lambda, double pivmin, std::vector<double> &r, std::vector<double> &s, double *v)
+	{
+		// one step of inverse iteration, (T - lambda I) v = gamma_k e_k, on the twisted factorisation of T - lambda I from Dhillon and Parlett
+		// the pivots from the top, q_i = r_i + w_{i+1}, and from the bottom, p_i = s_i + w_i, use the same cancellation free recurrences
+		// as the Sturm counts, gamma_k = r_k + s_k - (a_k - lambda), and the twist index k is the one with the smallest |gamma_k|,
+		// for which e_k is the best start vector, with v_k = 1 the solve is v_i = w_{i+1} v_{i+1} / q_i above k, v_i = w_i v_{i-1} / p_i below
+
+		r.resize(n);
+		s.resize(n);
+
+		auto guard = [pivmin](double q) { return ( fabs(q) < pivmin ? -pivmin : q ); };
+
+		r[0] = a[0] - lambda + w[0];
+		for (int i = 1; i < n; i++) r[i] = a[i] - lambda + w[i] * r[i - 1] / guard(r[i - 1] + w[i]);
+
+		s[n - 1] = a[n - 1] - lambda + w[n];
+		for (int i = n - 2; i >= 0; i--) s[i] = a[i] - lambda + w[i + 1] * s[i + 1] / guard(s[i + 1] + w[i + 1]);
+
+		int k = 0;
+		double gamma_min = fabs(r[0] + s[0] - (a[0] - lambda));
+		for (int i = 1; i < n; i++) {
+			double gamma = fabs(r[i] + s[i] - (a[i] - lambda));
+			if (gamma < gamma_min) {
+				gamma_min = gamma;
+				k = i;
+			}
+		}
+
+		v[k] = 1.0;
+		for (int i = k - 1; i >= 0; i--) v[i] = w[i + 1] * v[i + 1] / guard(r[i] + w[i + 1]);
+		for (int i = k + 1; i < n; i++) v[i] = w[i] * v[i - 1] / guard(s[i] + w[i]);
+	}
+
+	double scaled_norm(const double *v, int n)
+	{
+		// 2-norm of v formed without overflow
+
+		double scale = 0.0, sum = 0.0;
+		for (int i = 0; i < n; i++) scale = std::max(scale, fabs(v[i]));
+		if (scale == 0.0) return 0.0;
+		for (int i = 0; i < n; i++) sum += template_funcs::DSQR(v[i] / scale);
+
+		return ( scale * sqrt(sum) );
+	}
+
+	void orthogonalise(double *v, const double *vectors, int first, int last, int n)
+	{
+		// remove the components of v along the unit vectors first..last-1
+
+		for (int jj = first; jj < last; jj++) {
+			const double *u = vectors + static_cast<size_t>(jj) * n;
+			double dot = 0.0;
+			for (int i = 0; i < n; i++) dot += u[i] * v[i];
+			for (int i = 0; i < n; i++) v[i] -= dot * u[i];
+		}
+	}
+
+	struct tridiag_lu {
+		// LU factors of T - lambda I with partial pivoting, as in dgttrf from LAPACK
+		// U has two super-diagonals du and du2, swap[i] records an interchange of rows i and i + 1
+
+		std::vector<double> dl, dd, du, du2;
+		std::vector<char> swap;
+
+		void factor(const double *a, const double *w, int n, double lambda, double tiny)
+		{
+			dl.resize(n > 1 ? n - 1 : 0);
+			du2.assign(n > 1 ? n - 1 : 0, 0.0);
+			swap.assign(n > 1 ? n - 1 : 0, 0);
+			dd.resize(n);
+
+			for (int i = 0; i + 1 < n; i++) dl[i] = -w[i + 1];
+			du = dl;
+
+			for (int i = 0; i < n; i++) dd[i] = a[i] - lambda + w[i] + w[i + 1];
+
+			for (int i = 0; i + 1 < n; i++) {
+				if (fabs(dd[i]) >= fabs(dl[i])) {
+					if (dd[i] == 0.0) dd[i] = tiny; // dl[i] is zero too, T splits here
+					double fact = dl[i] / dd[i];
+					dl[i] = fact;
+					dd[i + 1] -= fact * du[i];
+				}
+				else {
+					double fact = dd[i] / dl[i], temp = du[i];
+					dd[i] = dl[i];
+					dl[i] = fact;
+					du[i] = dd[i + 1];
+					dd[i + 1] = temp - fact * dd[i + 1];
+					if (i + 2 < n) {
+						du2[i] = du[i + 1];
+						du[i + 1] = -fact * du[i + 1];
+					}
+					swap[i] = 1;
+				}
+			}
+
+			for (int i = 0; i < n; i++) if (fabs(dd[i]) < tiny) dd[i] = dd[i] < 0.0 ? -tiny : tiny; // lambda is an eigenvalue to working precision
+		}
+
+		void solve(double *b, int n) const
+		{
+			// overwrite b with (T - lambda I)^{-1} b
+
+			for (int i = 0; i + 1 < n; i++) {
+				if (swap[i]) {
+					double temp = b[i];
+					b[i] = b[i + 1];
+					b[i + 1] = temp - dl[i] * b[i];
+				}
+				else {
+					b[i + 1] -= dl[i] * b[i];
+				}
+			}
+
+			b[n - 1] /= dd[n - 1];
+			if (n > 1) b[n - 2] = (b[n - 2] - du[n - 2] * b[n - 1]) / dd[n - 2];
+			for (int i = n - 3; i >= 0; i--) b[i] = (b[i] - du[i] * b[i + 1] - du2[i] * b[i + 2]) / dd[i];
+		}
+	};
+}
+
+void tridiag_funcs::sturm_counts(const double *a, const double *w, int n, const double *x, int n_x, int *count, double pivmin)
+{
+	// shifts are taken SHIFT_BLOCK at a time, a partial last block is padded with copies of its first shift
+
+	for (int b = 0; b < n_x; b += SHIFT_BLOCK) {
+		int ns = std::min(SHIFT_BLOCK, n_x - b);
+
+		double xs[SHIFT_BLOCK];
+		int cs[SHIFT_BLOCK];
+
+		for (int s = 0; s < SHIFT_BLOCK; s++) xs[s] = x[b + (s < ns ? s : 0)];
+
+		sturm_block(a, w, n, xs, cs, pivmin);
+
+		for (int s = 0; s < ns; s++) count[b + s] = cs[s];
+	}
+}
+
+void tridiag_funcs::lowest_eigenvalues(const double *a, const double *w, int n, int k, double lower_bound, double *values)
+{
+	// eigenvalue j lies in [lo[j], hi[j]) with nlo[j], nhi[j] eigenvalues below lo[j], hi[j], it is isolated once nlo[j] = j, nhi[j] = j + 1
+	// stage 1: every interval that is not isolated is split, the distinct split points are counted together and each count narrows
+	// every interval, so the many intervals that start out equal are narrowed at the cost of one
+	// stage 2: isolated intervals need no further shared information, they are shared out in groups, at least one group per thread,
+	// and the SHIFT_BLOCK shifts of a pass are spread over the intervals of a group, p points per interval shrink it by p + 1 per pass
+
+	try{
+
+		bool c1 = n > 0 && a != nullptr && w != nullptr ? true : false;
+		bool c2 = k > 0 && k <= n && values != nullptr ? true : false;
+
+		if(c1 && c2){
+			double gl = a[0] + w[0] + w[1], gu = gl, w_max = 0.0;
+
+			for (int i = 0; i < n; i++) {
+				double d = a[i] + w[i] + w[i + 1], r = (i > 0 ? fabs(w[i]) : 0.0) + (i + 1 < n ? fabs(w[i + 1]) : 0.0);
+				gl = std::min(gl, d - r);
+				gu = std::max(gu, d + r);
+				w_max = std::max(w_max, fabs(w[i]));
+			}
+			w_max = std::max(w_max, fabs(w[n]));
+
+			double t_norm = std::max(fabs(gl), fabs(gu));
+			double pivmin = std::numeric_limits<double>::min() * std::max(1.0, w_max * w_max);
+			double abs_tol = pivmin;
+
+			gl -= 4.0 * MACHINE_EPS * t_norm + pivmin;
+			gu += 4.0 * MACHINE_EPS * t_norm + pivmin;
+
+			double start = std::max(gl, lower_bound);
+
+			std::vector<double> lo(k, start), hi(k, gu);
+			std::vector<int> nlo(k, 0), nhi(k, n);
+
+			auto done = [&](int j) { return ( interval_converged(lo[j], hi[j], split_point(lo[j], hi[j], gl), abs_tol) ); };
+			auto isolated = [&](int j) { return ( nlo[j] == j && nhi[j] == j + 1 ); };
+
+			bool threaded = n >= PARALLEL_MIN_SIZE;
+
+			// stage 1
+			std::vector<double> mids;
+			std::vector<int> counts;
+
+			while (true) {
+				mids.clear();
+				for (int j = 0; j < k; j++) if (!isolated(j) && !done(j)) mids.push_back(split_point(lo[j], hi[j], gl));
+
+				if (mids.empty()) break;
+
+				std::sort(mids.begin(), mids.end());
+				mids.erase(std::unique(mids.begin(), mids.end()), mids.end());
+
+				int n_mids = static_cast<int>(mids.size()), n_blocks = (n_mids + SHIFT_BLOCK - 1) / SHIFT_BLOCK;
+				counts.assign(n_mids, 0);
+
+				auto count_block = [&](int b) {
+					int first = b * SHIFT_BLOCK;
+					sturm_counts(a, w, n, mids.data() + first, std::min(SHIFT_BLOCK, n_mids - first), counts.data() + first, pivmin);
+				};
+
+				if (threaded && n_blocks > 1) {
+					parallel_funcs::parallel_for(n_blocks, count_block);
+				}
+				else {
+					for (int b = 0; b < n_blocks; b++) count_block(b);
+				}
+
+				for (int m = 0; m < n_mids; m++) {
+					for (int j = 0; j < k; j++) {
+						if (counts[m] > j) {
+							if (mids[m] < hi[j]) { hi[j] = mids[m]; nhi[j] = counts[m]; }
+						}
+						else {
+							if (mids[m] > lo[j]) { lo[j] = mids[m]; nlo[j] = counts[m]; }
+						}
+					}
+				}
+			}
+
+			// stage 2
+			std::vector<int> open;
+			for (int j = 0; j < k; j++) if (!done(j)) open.push_back(j);
+
+			int n_open = static_cast<int>(open.size());
+			int n_groups = (n_open + SHIFT_BLOCK - 1) / SHIFT_BLOCK;
+			if (threaded) n_groups = std::min(n_open, std::max(n_groups, parallel_funcs::num_threads()));
+			int group_size = n_groups > 0 ? (n_open + n_groups - 1) / n_groups : 0;
+
+			auto multisect_group = [&](int g) {
+				int first = g * group_size, last = std::min(first + group_size, n_open);
+
+				double x[SHIFT_BLOCK];
+				int c[SHIFT_BLOCK], idx[SHIFT_BLOCK];
+
+				while (true) {
+					int n_act = 0;
+					for (int m = first; m < last; m++) if (!done(open[m])) idx[n_act++] = open[m];
+
+					if (n_act == 0) break;
+
+					int pts = SHIFT_BLOCK / n_act, ns = 0;
+
+					for (int s = 0; s < n_act; s++) {
+						// pts points splitting the interval into pts + 1 equal parts, equal in log(x - gl) while the interval spans decades
+						int j = idx[s];
+						double ga = lo[j] - gl, gb = hi[j] - gl;
+						bool geometric = ga > 0.0 && gb > GEOMETRIC_RATIO * ga;
+
+						for (int m = 1; m <= pts; m++) {
+							double f = static_cast<double>(m) / (pts + 1);
+							x[ns++] = geometric ? gl + ga * pow(gb / ga, f) : lo[j] + f * (hi[j] - lo[j]);
+						}
+					}
+
+					sturm_counts(a, w, n, x, ns, c, pivmin);
+
+					for (int s = 0; s < n_act; s++) {
+						int j = idx[s];
+						for (int m = s * pts; m < (s + 1) * pts; m++) {
+							if (c[m] > j) {
+								if (x[m] < hi[j]) hi[j] = x[m];
+							}
+							else {
+								if (x[m] > lo[j]) lo[j] = x[m];
+							}
+						}
+					}
+				}
+			};
+
+			if (threaded && n_groups > 1) {
+				parallel_funcs::parallel_for(n_groups, multisect_group);
+			}
+			else {
+				for (int g = 0; g < n_groups; g++) multisect_group(g);
+			}
+
+			for (int j = 0; j < k; j++) values[j] = lo[j] + 0.5 * (hi[j] - lo[j]);
+		}
+		else{
+			std::string reason = "Error: void tridiag_funcs::lowest_eigenvalues(const double *a, const double *w, int n, int k, double lower_bound, double *values)\n";
+			if(!c1) reason += "Matrix is empty\n";
+			if(!c2) reason += "Number of eigenvalues must be in the range 1..n\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
+}
+
+void tridiag_funcs::inverse_iteration(const double *a, const double *w, int n, int k, const double *values, double *vectors)
+{
+	// each vector comes from a single twisted solve, which is accurate to O(eps) relative to the gap when the eigenvalue is
+	// separated from the rest of the spectrum
+	// eigenvalues separated by less than CLUSTER_GAP relative to their size form a cluster, the vectors of a cluster are found one
+	// after the other and orthogonalised against the earlier vectors of their cluster, clusters are independent
+	// a vector that the orthogonalisation all but removes is recomputed by pivoted inverse iteration from a pseudo-random start
+
+	try{
+
+		bool c1 = n > 0 && a != nullptr && w != nullptr ? true : false;
+		bool c2 = k > 0 && k <= n && values != nullptr && vectors != nullptr ? true : false;
+
+		if(c1 && c2){
+			double t_norm = 0.0;
+
+			for (int i = 0; i < n; i++) t_norm = std::max(t_norm, fabs(a[i] + w[i] + w[i + 1]) + (i > 0 ? fabs(w[i]) : 0.0) + (i + 1 < n ? fabs(w[i + 1]) : 0.0));
+
+			double tiny = MACHINE_EPS * std::max(t_norm, std::numeric_limits<double>::min());
+			double pivmin = std::numeric_limits<double>::min() * std::max(1.0, t_norm * t_norm);
+			std::vector<int> cluster_start(1, 0);
+			for (int j = 1; j < k; j++) {
+				if (values[j] - values[j - 1] > CLUSTER_GAP * std::max(fabs(values[j]), fabs(values[j - 1]))) cluster_start.push_back(j);
+			}
+			cluster_start.push_back(k);
+
+			int n_clusters = static_cast<int>(cluster_start.size()) - 1;
+
+			auto solve_cluster = [&](int cl) {
+				tridiag_lu lu;
+				std::vector<double> r, s;
+
+				int first = cluster_start[cl];
+
+				for (int j = first; j < cluster_start[cl + 1]; j++) {
+					double *v = vectors + static_cast<size_t>(j) * n;
+
+					twisted_vector(a, w, n, values[j], pivmin, r, s, v);
+
+					double norm = scaled_norm(v, n);
+					for (int i = 0; i < n; i++) v[i] /= norm;
+
+					orthogonalise(v, vectors, first, j, n);
+
+					if (scaled_norm(v, n) < 0.5) {
+						// the twisted solve found an earlier vector of the cluster again, pivoted inverse iteration from a random start
+						unsigned int seed = 2463534242u + 977u * j;
+						for (int i = 0; i < n; i++) {
+							seed = 1664525u * seed + 1013904223u;
+							v[i] = (seed >> 8) * (2.0 / 16777216.0) - 1.0;
+						}
+
+						lu.factor(a, w, n, values[j], tiny);
+
+						for (int it = 0; it < INVERSE_ITERATIONS; it++) {
+							norm = scaled_norm(v, n);
+							for (int i = 0; i < n; i++) v[i] /= norm;
+
+							lu.solve(v, n);
+
+							orthogonalise(v, vectors, first, j, n);
+						}
+					}
+
+					norm = scaled_norm(v, n);
+					for (int i = 0; i < n; i++) v[i] /= norm;
+				}
+			};
+
+			if (n >= PARALLEL_MIN_SIZE && n_clusters > 1) {
+				parallel_funcs::parallel_for(n_clusters, solve_cluster);
+			}
+			else {
+				for (int cl = 0; cl < n_clusters; cl++) solve_cluster(cl);
+			}
+		}
+		else{
+			std::string reason = "Error: void tridiag_funcs::inverse_iteration(const double *a, const double *w, int n, int k, const double *values, double *vectors)\n";
+			if(!c1) reason += "Matrix is empty\n";
+			if(!c2) reason += "Number of eigenvectors must be in the range 1..n\n";
+			throw std::invalid_argument(reason);
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what();
+	}
+}
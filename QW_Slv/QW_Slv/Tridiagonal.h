@@ -0,0 +1,45 @@
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H
+
+// Lowest eigenvalues and eigenvectors of a real symmetric tridiagonal matrix T written as a diagonal plus a weighted Laplacian
+// (T v)_i = a_i v_i + w_i (v_i - v_{i-1}) + w_{i+1} (v_i - v_{i+1}), i = 0..n-1, with v_{-1} = v_n = 0
+// that is d_i = a_i + w_i + w_{i+1} on the diagonal and -w_{i+1} off it, w has n + 1 entries and w_0, w_n couple to the walls
+// Any symmetric tridiagonal matrix with diagonal d and off-diagonal e has this form with w_{i+1} = |e_i|, w_0 = w_n = 0,
+// a_i = d_i - w_i - w_{i+1}, the signs of e do not change the eigenvalues, and a finite difference Hamiltonian has it naturally,
+// w are the kinetic couplings hbar^{2} / 2 m dx^{2} and a is the potential
+// Only the lowest k eigenpairs are computed, so the cost is O(n k) rather than the O(n^{2}) of a full diagonalisation
+
+// Eigenvalues: the pivots q_i of the LDL^{T} factors of T - x I, q_i = d_i - x - w_i^{2} / q_{i-1}, include as many negative terms as T has
+// eigenvalues below x, so every eigenvalue can be bracketed and bisected independently, based on dstebz from LAPACK
+// On a fine grid d_i ~ 2 w is many orders of magnitude above the low eigenvalues and the usual recurrence loses them to cancellation,
+// so the pivots are formed as q_i = r_i + w_{i+1} with r_i = a_i - x + w_i r_{i-1} / q_{i-1}, r_0 = a_0 - x + w_0, in which nothing cancels
+// Eigenvectors: one step of inverse iteration on the twisted factorisation of T - lambda I (Dhillon and Parlett), whose pivots use the
+// same recurrences as the Sturm counts, with pivoted LU factors of T - lambda I as the fall back for close eigenvalues,
+// vectors of eigenvalues closer than CLUSTER_GAP are orthogonalised against one another, based on dstein from LAPACK
+
+namespace tridiag_funcs{
+
+	static const int SHIFT_BLOCK = 16; // Sturm counts at this many shifts are formed in one pass over a and w, which hides the latency of the divisions
+
+	static const int PARALLEL_MIN_SIZE = 65536; // matrices smaller than this are solved on the calling thread
+
+	static const double CLUSTER_GAP = 1.0e-3; // relative gap below which neighbouring eigenvectors are explicitly orthogonalised
+
+	// number of eigenvalues of T below x[s] for s = 0..n_x-1, pivots smaller than pivmin in magnitude are replaced by -pivmin
+	void sturm_counts(const double *a, const double *w, int n, const double *x, int n_x, int *count, double pivmin);
+
+	// the k lowest eigenvalues of T in increasing order, each to within a few ulps of its value
+	// lower_bound must not exceed the lowest eigenvalue, the closer it is the fewer bisection steps are needed,
+	// pass -infinity to use the Gershgorin bound
+	// while an interval spans several orders of magnitude above the Gershgorin bound it is split at its geometric mean,
+	// which matters when the lowest eigenvalues are many orders of magnitude below the norm of T, as for a fine finite difference grid
+	// counts at each split point narrow every interval they bear on until the eigenvalues are isolated, then groups of eigenvalues are
+	// multisected to convergence in parallel, a group of fewer than SHIFT_BLOCK eigenvalues splits each interval at several points per pass
+	void lowest_eigenvalues(const double *a, const double *w, int n, int k, double lower_bound, double *values);
+
+	// unit eigenvectors of T for the eigenvalues values[0..k-1] in increasing order, vectors[j * n + i] is component i of vector j
+	// clusters of close eigenvalues are solved in parallel with one another
+	void inverse_iteration(const double *a, const double *w, int n, int k, const double *values, double *vectors);
+}
+
+#endif
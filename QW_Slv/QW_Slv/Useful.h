@@ -14,4 +14,19 @@ namespace useful_funcs{
 
 }
 
+// Status codes reported element by element by the non-throwing batch methods
+// Codes are bit flags so that every problem with an element is reported, in the same way that the 
+// error messages of the throwing methods list every failed check
+enum eval_status {
+	EVAL_OK = 0, // value computed
+	EVAL_BAD_MASS = 1, // particle mass is not positive
+	EVAL_BAD_ENERGY = 2, // particle energy is not positive
+	EVAL_BAD_HEIGHT = 4, // step or barrier height is not positive, or barrier height is not above the particle energy
+	EVAL_BAD_WIDTH = 8, // barrier width is not positive
+	EVAL_BAD_POSITION = 16, // position is not a finite number
+	EVAL_OUT_OF_RANGE = 32, // argument lies outside the domain of the function
+	EVAL_NO_PARAMS = 64, // no parameters defined for the solver, or invalid fixed parameters
+	EVAL_NO_MEMORY = 128 // workspace could not be allocated
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,245 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the kernels declared in Wave_Kernels.h
+// The AVX2 versions of sin, cos and exp are those of Simd_Math.h
+
+void wave_kernels::oscillatory(double k, std::complex<double> P, std::complex<double> Q, const double *x, int n, double *re, double *im)
+{
+	// psi(x) = P cos(k x) + Q sin(k x)
+
+	int i = 0;
+
+#ifdef __AVX2__
+	__m256d kk = _mm256_set1_pd(k);
+	__m256d Pr = _mm256_set1_pd(P.real()), Pi = _mm256_set1_pd(P.imag());
+	__m256d Qr = _mm256_set1_pd(Q.real()), Qi = _mm256_set1_pd(Q.imag());
+	__m256d s, c;
+
+	for (; i + 4 <= n; i += 4) {
+		simd_funcs::sincos_pd(_mm256_mul_pd(kk, _mm256_loadu_pd(x + i)), s, c);
+		_mm256_storeu_pd(re + i, _mm256_add_pd(_mm256_mul_pd(Pr, c), _mm256_mul_pd(Qr, s)));
+		_mm256_storeu_pd(im + i, _mm256_add_pd(_mm256_mul_pd(Pi, c), _mm256_mul_pd(Qi, s)));
+	}
+#endif
+
+	double Pr_s = P.real(), Pi_s = P.imag(), Qr_s = Q.real(), Qi_s = Q.imag();
+
+	for (; i < n; i++) {
+		double c_s = cos(k * x[i]), s_s = sin(k * x[i]);
+		re[i] = Pr_s * c_s + Qr_s * s_s;
+		im[i] = Pi_s * c_s + Qi_s * s_s;
+	}
+}
+
+void wave_kernels::evanescent(double kappa, std::complex<double> P, std::complex<double> Q, const double *x, int n, double *re, double *im)
+{
+	// psi(x) = P exp(kappa x) + Q exp(-kappa x)
+	// when P = 0, as in the transmitted region of a step, exp(kappa x) is not formed at all,
+	// otherwise it overflows once kappa x > ~709 and 0 * inf turns the decaying solution into NaN
+
+	int i = 0;
+	bool grows = P != zero;
+
+#ifdef __AVX2__
+	__m256d kk = _mm256_set1_pd(kappa);
+	__m256d Pr = _mm256_set1_pd(P.real()), Pi = _mm256_set1_pd(P.imag());
+	__m256d Qr = _mm256_set1_pd(Q.real()), Qi = _mm256_set1_pd(Q.imag());
+	__m256d ep, em;
+
+	if (grows) {
+		for (; i + 4 <= n; i += 4) {
+			__m256d arg = _mm256_mul_pd(kk, _mm256_loadu_pd(x + i));
+			ep = simd_funcs::exp_pd(arg);
+			em = simd_funcs::exp_pd(_mm256_sub_pd(_mm256_setzero_pd(), arg));
+			_mm256_storeu_pd(re + i, _mm256_add_pd(_mm256_mul_pd(Pr, ep), _mm256_mul_pd(Qr, em)));
+			_mm256_storeu_pd(im + i, _mm256_add_pd(_mm256_mul_pd(Pi, ep), _mm256_mul_pd(Qi, em)));
+		}
+	}
+	else {
+		for (; i + 4 <= n; i += 4) {
+			em = simd_funcs::exp_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_setzero_pd(), kk), _mm256_loadu_pd(x + i)));
+			_mm256_storeu_pd(re + i, _mm256_mul_pd(Qr, em));
+			_mm256_storeu_pd(im + i, _mm256_mul_pd(Qi, em));
+		}
+	}
+#endif
+
+	double Pr_s = P.real(), Pi_s = P.imag(), Qr_s = Q.real(), Qi_s = Q.imag();
+
+	for (; i < n; i++) {
+		double ep_s = grows ? exp(kappa * x[i]) : 0.0, em_s = exp(-kappa * x[i]);
+		re[i] = Pr_s * ep_s + Qr_s * em_s;
+		im[i] = Pi_s * ep_s + Qi_s * em_s;
+	}
+}
+
+void wave_kernels::standing(double k, double P, double Q, const double *x, int n, double *psi)
+{
+	// psi(x) = P cos(k x) + Q sin(k x), P and Q real
+
+	int i = 0;
+
+#ifdef __AVX2__
+	__m256d kk = _mm256_set1_pd(k), PP = _mm256_set1_pd(P), QQ = _mm256_set1_pd(Q);
+	__m256d s, c;
+
+	for (; i + 4 <= n; i += 4) {
+		simd_funcs::sincos_pd(_mm256_mul_pd(kk, _mm256_loadu_pd(x + i)), s, c);
+		_mm256_storeu_pd(psi + i, _mm256_add_pd(_mm256_mul_pd(PP, c), _mm256_mul_pd(QQ, s)));
+	}
+#endif
+
+	for (; i < n; i++) {
+		psi[i] = P * cos(k * x[i]) + Q * sin(k * x[i]);
+	}
+}
+
+void wave_kernels::decaying(double kappa, double A, const double *x, int n, double *psi)
+{
+	// psi(x) = A exp(-kappa x), A real
+
+	int i = 0;
+
+#ifdef __AVX2__
+	__m256d mk = _mm256_set1_pd(-kappa), AA = _mm256_set1_pd(A);
+
+	for (; i + 4 <= n; i += 4) {
+		_mm256_storeu_pd(psi + i, _mm256_mul_pd(AA, simd_funcs::exp_pd(_mm256_mul_pd(mk, _mm256_loadu_pd(x + i)))));
+	}
+#endif
+
+	for (; i < n; i++) {
+		psi[i] = A * exp(-kappa * x[i]);
+	}
+}
+
+void wave_kernels::partition(const double *x, int n, double x_lo, double x_hi, std::vector<int> &before, std::vector<int> &inside, std::vector<int> &after)
+{
+	// sort the indices of the positions into the three regions of the solution
+	// the order of the indices within each region is preserved
+
+	before.clear(); inside.clear(); after.clear();
+
+	for (int i = 0; i < n; i++) {
+		if (x[i] < x_lo) {
+			before.push_back(i);
+		}
+		else if (x[i] > x_hi) {
+			after.push_back(i);
+		}
+		else {
+			inside.push_back(i);
+		}
+	}
+}
+
+namespace {
+
+	const int BLOCK = 256; // number of positions gathered at a time, small enough that the block stays in L1 cache
+
+	// gather x[index[i]] into contiguous blocks, apply the kernel and scatter the results back
+	template <class Kernel> void indexed_eval(Kernel kernel, const double *x, const std::vector<int> &index, double *re, double *im)
+	{
+		double xb[BLOCK], reb[BLOCK], imb[BLOCK];
+
+		int n = static_cast<int>(index.size());
+
+		for (int start = 0; start < n; start += BLOCK) {
+			int nb = std::min(BLOCK, n - start);
+			const int *ib = &index[start];
+
+			for (int j = 0; j < nb; j++) xb[j] = x[ib[j]];
+
+			kernel(xb, nb, reb, imb);
+
+			for (int j = 0; j < nb; j++) {
+				re[ib[j]] = reb[j];
+				im[ib[j]] = imb[j];
+			}
+		}
+	}
+}
+
+void wave_kernels::oscillatory(double k, std::complex<double> P, std::complex<double> Q, const double *x, const std::vector<int> &index, double *re, double *im)
+{
+	// psi(x) = P cos(k x) + Q sin(k x) at the positions x[index[i]]
+
+	indexed_eval([&](const double *xb, int nb, double *reb, double *imb) { oscillatory(k, P, Q, xb, nb, reb, imb); }, x, index, re, im);
+}
+
+void wave_kernels::evanescent(double kappa, std::complex<double> P, std::complex<double> Q, const double *x, const std::vector<int> &index, double *re, double *im)
+{
+	// psi(x) = P exp(kappa x) + Q exp(-kappa x) at the positions x[index[i]]
+
+	indexed_eval([&](const double *xb, int nb, double *reb, double *imb) { evanescent(kappa, P, Q, xb, nb, reb, imb); }, x, index, re, im);
+}
+
+void wave_kernels::oscillatory_grid(double k, std::complex<double> P, std::complex<double> Q, double x0, double dx, int n, double *re, double *im)
+{
+	// psi(x) = P cos(k x) + Q sin(k x) on the grid x_{j} = x0 + j dx
+	// (c, s) = (cos(k x), sin(k x)) is advanced by multiplication with the phasor (cos(k dx), sin(k dx))
+
+	double Pr = P.real(), Pi = P.imag(), Qr = Q.real(), Qi = Q.imag();
+	double wr = cos(k * dx), wi = sin(k * dx);
+
+	for (int start = 0; start < n; start += GRID_RESTART) {
+		int end = std::min(n, start + GRID_RESTART);
+		double x = x0 + start * dx;
+		double c = cos(k * x), s = sin(k * x), cn;
+
+		for (int j = start; j < end; j++) {
+			re[j] = Pr * c + Qr * s;
+			im[j] = Pi * c + Qi * s;
+			cn = c * wr - s * wi;
+			s = s * wr + c * wi;
+			c = cn;
+		}
+	}
+}
+
+void wave_kernels::evanescent_grid(double kappa, std::complex<double> P, std::complex<double> Q, double x0, double dx, int n, double *re, double *im)
+{
+	// psi(x) = P exp(kappa x) + Q exp(-kappa x) on the grid x_{j} = x0 + j dx
+	// exp(kappa x) and exp(-kappa x) are advanced by multiplication with exp(kappa dx) and exp(-kappa dx)
+	// as in evanescent, exp(kappa x) is held at zero when P = 0 so that 0 * inf cannot occur
+
+	double Pr = P.real(), Pi = P.imag(), Qr = Q.real(), Qi = Q.imag();
+	bool grows = P != zero;
+	double wp = grows ? exp(kappa * dx) : 0.0, wm = exp(-kappa * dx);
+
+	for (int start = 0; start < n; start += GRID_RESTART) {
+		int end = std::min(n, start + GRID_RESTART);
+		double x = x0 + start * dx;
+		double ep = grows ? exp(kappa * x) : 0.0, em = exp(-kappa * x);
+
+		for (int j = start; j < end; j++) {
+			re[j] = Pr * ep + Qr * em;
+			im[j] = Pi * ep + Qi * em;
+			ep *= wp;
+			em *= wm;
+		}
+	}
+}
+
+int wave_kernels::grid_split(double x0, double dx, int n, double x_b, bool strict)
+{
+	// locate the first grid point on the far side of x_b
+	// the estimate from the grid spacing is corrected so that the result agrees with a direct comparison of x0 + j dx against x_b
+
+	double guess = ceil((x_b - x0) / dx);
+
+	int j = guess < 0.0 ? 0 : (guess > n ? n : static_cast<int>(guess));
+
+	if (strict) {
+		while (j > 0 && x0 + (j - 1) * dx > x_b) j--;
+		while (j < n && !(x0 + j * dx > x_b)) j++;
+	}
+	else {
+		while (j > 0 && x0 + (j - 1) * dx >= x_b) j--;
+		while (j < n && x0 + j * dx < x_b) j++;
+	}
+
+	return j;
+}
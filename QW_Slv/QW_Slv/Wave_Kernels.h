@@ -0,0 +1,53 @@
+#ifndef WAVE_KERNELS_H
+#define WAVE_KERNELS_H
+
+// Kernels for evaluating piecewise plane-wave / exponential solutions at many positions
+// Every region of the step and barrier solutions has one of the two forms
+// oscillatory: psi(x) = P cos(k x) + Q sin(k x)
+// evanescent:  psi(x) = P exp(kappa x) + Q exp(-kappa x)
+// with P, Q complex constants, so the solvers only need to supply k or kappa and P, Q for each region
+// Output is written as separate real and imaginary arrays
+// When compiled with AVX2 enabled (/arch:AVX2, -mavx2) the kernels process four positions per instruction, 
+// otherwise a plain loop is used that the compiler is free to vectorise
+
+namespace wave_kernels{
+
+	// evaluate the kernels at the n contiguous positions x[0..n-1]
+	void oscillatory(double k, std::complex<double> P, std::complex<double> Q, const double *x, int n, double *re, double *im); 
+
+	// P = 0 evaluates the decaying term alone, so Q exp(-kappa x) underflows to zero for large kappa x rather than giving 0 * inf
+	void evanescent(double kappa, std::complex<double> P, std::complex<double> Q, const double *x, int n, double *re, double *im); 
+
+	// real valued forms for solutions with real constants, such as the bound states of a well
+	// standing: psi(x) = P cos(k x) + Q sin(k x)
+	// decaying: psi(x) = A exp(-kappa x), only one exponential is formed so large kappa x underflows to zero rather than giving 0 * inf
+	void standing(double k, double P, double Q, const double *x, int n, double *psi); 
+
+	void decaying(double kappa, double A, const double *x, int n, double *psi); 
+
+	// sort the indices of the positions x[0..n-1] into the regions x < x_lo, x_lo <= x <= x_hi and x > x_hi
+	void partition(const double *x, int n, double x_lo, double x_hi, std::vector<int> &before, std::vector<int> &inside, std::vector<int> &after); 
+
+	// evaluate the kernels at the positions x[index[i]], results are written to re[index[i]], im[index[i]]
+	// positions are gathered into small contiguous blocks so that the contiguous kernels can be used
+	void oscillatory(double k, std::complex<double> P, std::complex<double> Q, const double *x, const std::vector<int> &index, double *re, double *im);
+
+	void evanescent(double kappa, std::complex<double> P, std::complex<double> Q, const double *x, const std::vector<int> &index, double *re, double *im);
+
+	// evaluate the kernels on the uniform grid x_{j} = x0 + j dx, j = 0..n-1
+	// exp(i k x_{j+1}) = exp(i k x_{j}) exp(i k dx) so each point costs one complex multiply instead of a sin, cos pair
+	// the recurrence is restarted from directly computed values every GRID_RESTART points to bound the rounding drift
+	// error relative to |P| + |Q| (oscillatory) or |P| e^{kappa x} + |Q| e^{-kappa x} (evanescent) is below 4 GRID_RESTART eps ~ 6e-14
+	// testing::wavefunction_grid checks this bound against the direct kernels
+	static const int GRID_RESTART = 64; 
+
+	void oscillatory_grid(double k, std::complex<double> P, std::complex<double> Q, double x0, double dx, int n, double *re, double *im); 
+
+	// P = 0 advances exp(-kappa x) alone, as in evanescent
+	void evanescent_grid(double kappa, std::complex<double> P, std::complex<double> Q, double x0, double dx, int n, double *re, double *im); 
+
+	// index of the first grid point x0 + j dx, dx > 0, with x >= x_b, or x > x_b when strict is true, n if there is none
+	int grid_split(double x0, double dx, int n, double x_b, bool strict = false); 
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef ATTACH_H
+#include "Attach.h"
+#endif
+
+// Definitions of the methods declared in Well_Evolution.h
+
+inf_well_evolution::inf_well_evolution()
+{
+	// Default constructor
+
+	params_defined = state_defined = false; 
+
+	M = 0; 
+	x_lo = dx = A = omega1 = 0.0; 
+}
+
+inf_well_evolution::inf_well_evolution(double length, double mass, int n_intervals, double centre_position)
+{
+	// Constructor
+
+	set_params(length, mass, n_intervals, centre_position); 
+}
+
+void inf_well_evolution::set_params(double length, double mass, int n_intervals, double centre_position)
+{
+	// length is the length of the well expressed in nm
+	// mass is the mass of the particle expressed in kg
+	// n_intervals is the number of grid intervals across the well, it must be a power of two
+	// any initial state that was set before is discarded
+
+	try{
+	
+		bool c1 = length > 0.0 ? true : false;
+		bool c2 = mass > 0.0 ? true : false;
+		bool c3 = n_intervals > 1 && (n_intervals & (n_intervals - 1)) == 0 ? true : false; 
+
+		if(c1 && c2 && c3){
+			well.set_well_params(length, mass, centre_position); 
+			plan.set_size(n_intervals); 
+
+			M = n_intervals - 1; 
+			x_lo = centre_position - 0.5 * length; 
+			dx = length / n_intervals; 
+			A = sqrt(2.0 / length); 
+			omega1 = well.energy_eigenvalue(1) / H_BAR_eV; 
+
+			coeff.assign(M, std::complex<double>(0.0, 0.0)); 
+
+			params_defined = true; 
+			state_defined = false; 
+		}
+		else{
+			std::string reason = "Error: void inf_well_evolution::set_params(double length, double mass, int n_intervals, double centre_position)\n"; 
+			if(!c1) reason += "length is not positive\n"; 
+			if(!c2) reason += "mass is not positive\n"; 
+			if(!c3) reason += "n_intervals must be a power of two no smaller than 2\n"; 
+			throw std::invalid_argument(reason); 
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void inf_well_evolution::set_initial_state(const std::vector<std::complex<double>> &psi0)
+{
+	// c_{n} = int psi_{n}(x) psi0(x) dx, evaluated on the grid as dx A sum_{j} psi0(x_{j}) sin(pi n j / P)
+	// the discrete sine vectors are orthogonal, so this reproduces psi0 exactly at the grid points
+
+	try{
+	
+		bool c1 = params_defined; 
+		bool c2 = static_cast<int>(psi0.size()) == M ? true : false; 
+
+		if(c1 && c2){
+			std::vector<std::complex<double>> work(2 * plan.get_P()); 
+
+			coeff = psi0; 
+
+			plan.transform(&coeff[0], &work[0]); 
+
+			for (int n = 0; n < M; n++) coeff[n] *= A * dx; 
+
+			state_defined = true; 
+		}
+		else{
+			std::string reason = "Error: void inf_well_evolution::set_initial_state(const std::vector<std::complex<double>> &psi0)\n"; 
+			if(!c1) reason += "No parameters defined for well\n"; 
+			if(!c2) reason += "Initial state must have one value for each grid point\n"; 
+			throw std::invalid_argument(reason); 
+		}
+
+	}
+	catch(std::invalid_argument &e){
+		useful_funcs::exit_failure_output(e.what()); 
+		exit(EXIT_FAILURE); 
+	}
+}
+
+void inf_well_evolution::frame(double time, std::complex<double> *psi, std::complex<double> *work) const
+{
+	// psi(x_{j}, t) = A sum_{n} c_{n} exp(-i n^{2} theta) sin(pi n j / P), theta = omega_{1} t reduced modulo 2 pi
+	// the phase factors are advanced with exp(-i (n+1)^{2} theta) = exp(-i n^{2} theta) exp(-i (2n+1) theta), 
+	// where exp(-i (2n+1) theta) is itself advanced by exp(-2 i theta), so each level costs two complex multiplies instead of a sin, cos pair
+	// both are restarted from directly computed values every wave_kernels::GRID_RESTART levels to bound the rounding drift
+
+	double theta = fmod(omega1 * time, Two_PI); 
+	double rr = cos(2.0 * theta), ri = -sin(2.0 * theta); 
+
+	for (int start = 1; start <= M; start += wave_kernels::GRID_RESTART) {
+		int end = std::min(M, start + wave_kernels::GRID_RESTART - 1); 
+		double n = static_cast<double>(start); 
+		double ph = fmod(n * n * theta, Two_PI), st = fmod((2.0 * n + 1.0) * theta, Two_PI); 
+		double zr = A * cos(ph), zi = -A * sin(ph), sr = cos(st), si = -sin(st), t; 
+
+		for (int m = start; m <= end; m++) {
+			const std::complex<double> &c = coeff[m - 1]; 
+			psi[m - 1] = std::complex<double>(c.real() * zr - c.imag() * zi, c.real() * zi + c.imag() * zr); 
+
+			t = zr * sr - zi * si; zi = zr * si + zi * sr; zr = t; 
+			t = sr * rr - si * ri; si = sr * ri + si * rr; sr = t; 
+		}
+	}
+
+	plan.transform(psi, work); 
+}
+
+void inf_well_evolution::density_frames(double t_start, double dt, int n_frames, double *density, int n_threads) const
+{
+	// |psi(x_{j}, t_{f})|^{2} for n_frames frames, the frames are shared out between threads
+
+	int P = plan.get_P(); 
+
+	parallel_funcs::parallel_for(n_frames, [&](int f) {
+		std::vector<std::complex<double>> psi(M), work(2 * P); 
+		double *row = density + static_cast<size_t>(f) * M; 
+
+		frame(t_start + f * dt, &psi[0], &work[0]); 
+
+		for (int j = 0; j < M; j++) row[j] = std::norm(psi[j]); 
+	}, n_threads); 
+}
+
+void inf_well_evolution::density_stream(double t_start, double dt, int n_frames, std::ofstream &write, int n_threads) const
+{
+	// compute the frames in bands and write each band to the open stream while the next band is computed
+
+	int n_band = FRAMES_PER_THREAD * (n_threads > 0 ? n_threads : parallel_funcs::num_threads()); 
+	n_band = std::min(n_band, n_frames); 
+
+	std::vector<double> band[2] = { std::vector<double>(static_cast<size_t>(n_band) * M), std::vector<double>(static_cast<size_t>(n_band) * M) }; 
+	std::thread writer; 
+
+	int n_x = M; 
+
+	for (int b = 0, f0 = 0; f0 < n_frames; b = 1 - b, f0 += n_band) {
+		int rows = std::min(n_band, n_frames - f0); 
+
+		density_frames(t_start + f0 * dt, dt, rows, &band[b][0], n_threads); 
+
+		if (writer.joinable()) writer.join(); // the previous band has been written, so its buffer can be reused after this one
+
+		writer = std::thread([&write, &band, b, f0, rows, t_start, dt, n_x]() {
+			for (int i = 0; i < rows; i++) {
+				write << std::setprecision(10) << t_start + (f0 + i) * dt; 
+				for (int j = 0; j < n_x; j++) write << " , " << band[b][static_cast<size_t>(i) * n_x + j]; 
+				write << "\n"; 
+			}
+		}); 
+	}
+
+	if (writer.joinable()) writer.join(); 
+}
+
+double inf_well_evolution::evolve(double t_start, double dt, int n_frames, std::string filename, int n_threads) const
+{
+	// stream n_frames frames of |psi(x, t)|^{2} to filename, times in units of s
+	// a file that cannot be opened is reported and 0 is returned, as in compute_wavefunction
+
+	try{
+		std::string reason; 
+		if (!state_defined) reason += "No initial state defined\n"; 
+		if (n_frames < 1) reason += "At least one frame must be requested\n"; 
+		if (filename == empty_str) reason += "Invalid filename\n"; 
+
+		if (reason == empty_str) {
+			std::ofstream write; 
+
+			write.open(filename.c_str(), std::ios_base::out | std::ios_base::trunc); 
+
+			if (write.is_open()) {
+				std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now(); 
+
+				density_stream(t_start, dt, n_frames, write, n_threads); 
+
+				write.close(); 
+
+				std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now(); 
+
+				return ( n_frames / std::chrono::duration<double>(t1 - t0).count() ); 
+			}
+
+			reason = "Could not open file: " + filename + "\n"; 
+		}
+
+		reason = "Error: double inf_well_evolution::evolve(double t_start, double dt, int n_frames, std::string filename, int n_threads) const\n" + reason; 
+		throw std::invalid_argument(reason); 
+	}
+	catch(std::invalid_argument &e){
+		std::cerr<<e.what(); 
+		return 0.0; 
+	}
+}
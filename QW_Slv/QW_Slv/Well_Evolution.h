@@ -0,0 +1,70 @@
+#ifndef WELL_EVOLUTION_H
+#define WELL_EVOLUTION_H
+
+// Time evolution of a superposition of infinite well eigenstates
+// psi(x, t) = sum_{n=1}^{M} c_{n} exp(-i E_{n} t / hbar) psi_{n}(x) on the grid x_{j} = x_c - L/2 + j L / P, j = 1..M, P = M + 1
+// On this grid psi_{n}(x_{j}) = A sin(pi n j / P), so projecting the initial state onto the eigenstates and summing the eigenstates
+// at a given time are both discrete sine transforms of type I
+// The coefficients c_{n} are found once, after which every frame costs one DST, O(M log M), instead of the O(N M) direct sum
+// The projection is exact on the grid, the frame at t = 0 and the frame at the revival time reproduce the sampled initial state
+// Frames are independent, bands of frames are computed in parallel and written out while the next band is computed,
+// so only two bands are held in memory however many frames are requested
+
+class inf_well_evolution{
+public:
+	inf_well_evolution(); 
+
+	inf_well_evolution(double length, double mass, int n_intervals, double centre_position = 0.0); 
+
+	// length in nm, mass in kg, n_intervals = P must be a power of two, the grid has M = P - 1 interior points
+	void set_params(double length, double mass, int n_intervals, double centre_position = 0.0); 
+
+	// sample psi0(x), x in units of nm, at the grid points and project it onto the eigenstates
+	template <class Func> void set_initial_state(Func psi0)
+	{
+		std::vector<std::complex<double>> f(M); 
+
+		for (int j = 0; j < M; j++) f[j] = psi0(position(j)); 
+
+		set_initial_state(f); 
+	}
+
+	void set_initial_state(const std::vector<std::complex<double>> &psi0); // psi0[j] is the initial state at position(j)
+
+	// psi(x_{j}, t) for j = 1..M written to psi[0..M-1], time in units of s, work must hold 2P values
+	void frame(double time, std::complex<double> *psi, std::complex<double> *work) const; 
+
+	// |psi(x_{j}, t_{f})|^{2} at t_{f} = t_start + f dt, written to density[f * M + j], no checks are made on the inputs
+	void density_frames(double t_start, double dt, int n_frames, double *density, int n_threads = 0) const; 
+
+	// frames computed in bands and written to the open stream, each line is t_{f} , |psi(x_{1}, t_{f})|^{2} , ... , |psi(x_{M}, t_{f})|^{2}
+	void density_stream(double t_start, double dt, int n_frames, std::ofstream &write, int n_threads = 0) const; 
+
+	// frames streamed to a text file, the return value is the number of frames per second including the file output
+	double evolve(double t_start, double dt, int n_frames, std::string filename, int n_threads = 0) const; 
+
+	// getters
+	inline int get_M() const { return M; }
+	inline double position(int j) const { return x_lo + (j + 1) * dx; } // position of the j^{th} grid point, j = 0..M-1, in units of nm
+	inline std::complex<double> coefficient(int n) const { return coeff[n - 1]; } // c_{n}, n = 1..M, once an initial state is set
+	inline double revival_time() const { return Two_PI / omega1; } // every phase exp(-i n^{2} omega_{1} t) returns to 1 at t = 2 pi / omega_{1}
+
+	static const int FRAMES_PER_THREAD = 4; // frames each thread computes per band of a streamed evolution
+
+private:
+	bool params_defined; // boolean to decide if parameters have been assigned to the class
+	bool state_defined; // boolean to decide if an initial state has been assigned to the class
+
+	int M; // number of interior grid points
+	double x_lo; // position of the left hand wall in units of nm
+	double dx; // grid spacing in units of nm
+	double A; // eigenfunction normalisation sqrt(2 / L)
+	double omega1; // E_{1} / hbar in units of s^{-1}
+
+	inf_well well; // the well whose eigenstates form the basis
+	dst_plan plan; // DST of size P shared by every frame
+
+	std::vector<std::complex<double>> coeff; // c_{n}, n = 1..M, stored in coeff[n-1]
+}; 
+
+#endif